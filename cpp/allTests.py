@@ -44,6 +44,8 @@ tests = [
     ("Ice/operations", ["core", "bt"]),
     ("Ice/exceptions", ["core", "bt"]),
     ("Ice/ami", ["core", "nocompress", "bt"]),
+    ("Ice/connectionMemory", ["core", "nocompress", "noc++11"]),
+    ("Ice/sendQueue", ["core", "nocompress", "noc++11"]),
     ("Ice/info", ["core", "noipv6", "nocompress", "nosocks"]),
     ("Ice/inheritance", ["core", "bt"]),
     ("Ice/facets", ["core", "bt"]),
@@ -59,10 +61,16 @@ tests = [
     ("Ice/dispatcher", ["once"]),
     ("Ice/checksum", ["core"]),
     ("Ice/stream", ["core"]),
+    ("Ice/streamTables", ["core"]),
     ("Ice/hold", ["core", "bt"]),
     ("Ice/custom", ["core", "nossl", "nows"]),
     ("Ice/retry", ["core"]),
     ("Ice/timeout", ["core", "nocompress", "nosocks"]),
+    ("Ice/compress", ["core", "nocompress"]),
+    ("Ice/threadPoolAdaptive", ["core"]),
+    ("Ice/latency", ["core"]),
+    ("Ice/fileBytes", ["core"]),
+    ("Ice/sharedRuntime", ["core"]),
     ("Ice/acm", ["core", "bt"]),
     ("Ice/background", ["core", "nomingw", "nosocks"]),
     ("Ice/servantLocator", ["core", "bt"]),
@@ -91,6 +99,7 @@ tests = [
     ("IceStorm/rep1", ["service", "novc100", "nomingw", "noc++11"]),
     ("IceStorm/repgrid", ["service", "novc100", "nomingw", "noc++11"]),
     ("IceStorm/repstress", ["service", "noipv6", "stress", "novc100", "nomingw", "noc++11"]),
+    ("IceDB/evictor", ["once", "novc100", "nomingw", "noc++11"]),
     ("IceDiscovery/simple", ["service"]),
     ("IceGrid/simple", ["service", "novc100", "nomingw", "noc++11"]),
     ("IceGrid/fileLock", ["service", "novc100", "nomingw", "noc++11"]),
@@ -107,6 +116,7 @@ tests = [
     ("Glacier2/router", ["service", "novc100", "nomingw", "noc++11"]),
     ("Glacier2/attack", ["service", "novc100", "nomingw", "nomx", "noc++11"]),
     ("Glacier2/override", ["service", "novc100", "nomingw", "noc++11"]),
+    ("Glacier2/rateLimit", ["service", "novc100", "nomingw", "noc++11"]),
     ("Glacier2/sessionControl", ["service", "novc100", "nomingw", "noc++11"]),
     ("Glacier2/ssl", ["service", "novalgrind", "novc100", "nomingw", "noc++11"]), # valgrind doesn't work well with openssl
     ("Glacier2/dynamicFiltering", ["service", "novc100", "nomingw", "noc++11"]),
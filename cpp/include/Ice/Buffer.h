@@ -79,6 +79,11 @@ public:
             return !_size;
         }
 
+        size_type capacity() const
+        {
+            return _capacity;
+        }
+
         void swap(Container&);
 
         void clear();
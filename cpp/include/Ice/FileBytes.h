@@ -0,0 +1,157 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef ICE_FILE_BYTES_H
+#define ICE_FILE_BYTES_H
+
+#include <Ice/StreamHelpers.h>
+
+#include <vector>
+
+namespace Ice
+{
+
+//
+// FileBytes is the mapping of byte sequences with the cpp:file
+// metadata. To send the content of a file, set it to a range of an
+// open file descriptor: the range isn't copied into the message
+// buffer, it's sent after the buffer directly from the file with
+// sendfile if the transport supports it (TCP on Linux), and read
+// into the buffer otherwise.
+//
+// The descriptor is duplicated when the FileBytes is marshaled and
+// must remain open until then. For the return value or the out
+// parameters of a synchronous dispatch, this is after the servant
+// returns: the servant should keep its files open, or use AMD and
+// close the file once the response is sent.
+//
+// An unmarshaled FileBytes holds the received bytes.
+//
+struct FileBytes
+{
+    typedef Byte value_type;
+
+    FileBytes() :
+        fd(-1), offset(0), length(0)
+    {
+    }
+
+    FileBytes(int f, Long o, Long l) :
+        fd(f), offset(o), length(l)
+    {
+    }
+
+    FileBytes(const std::vector<Byte>& v) :
+        fd(-1), offset(0), length(static_cast<Long>(v.size())), bytes(v)
+    {
+    }
+
+    size_t size() const
+    {
+        return fd < 0 ? bytes.size() : static_cast<size_t>(length);
+    }
+
+    //
+    // The file range, if fd isn't -1.
+    //
+    int fd;
+    Long offset;
+    Long length;
+
+    //
+    // The bytes, if fd is -1.
+    //
+    std::vector<Byte> bytes;
+};
+
+inline bool
+operator==(const FileBytes& lhs, const FileBytes& rhs)
+{
+    return lhs.fd == rhs.fd && lhs.offset == rhs.offset && lhs.length == rhs.length && lhs.bytes == rhs.bytes;
+}
+
+inline bool
+operator!=(const FileBytes& lhs, const FileBytes& rhs)
+{
+    return !(lhs == rhs);
+}
+
+inline bool
+operator<(const FileBytes& lhs, const FileBytes& rhs)
+{
+    if(lhs.fd != rhs.fd)
+    {
+        return lhs.fd < rhs.fd;
+    }
+    if(lhs.offset != rhs.offset)
+    {
+        return lhs.offset < rhs.offset;
+    }
+    if(lhs.length != rhs.length)
+    {
+        return lhs.length < rhs.length;
+    }
+    return lhs.bytes < rhs.bytes;
+}
+
+inline bool
+operator<=(const FileBytes& lhs, const FileBytes& rhs)
+{
+    return !(rhs < lhs);
+}
+
+inline bool
+operator>(const FileBytes& lhs, const FileBytes& rhs)
+{
+    return rhs < lhs;
+}
+
+inline bool
+operator>=(const FileBytes& lhs, const FileBytes& rhs)
+{
+    return !(lhs < rhs);
+}
+
+template<>
+struct StreamableTraits<FileBytes>
+{
+    static const StreamHelperCategory helper = StreamHelperCategorySequence;
+    static const int minWireSize = 1;
+    static const bool fixedLength = false;
+};
+
+template<>
+struct StreamHelper<FileBytes, StreamHelperCategorySequence>
+{
+    template<class S> static inline void
+    write(S* stream, const FileBytes& v)
+    {
+        if(v.fd < 0)
+        {
+            stream->write(v.bytes);
+        }
+        else
+        {
+            stream->writeFile(v.fd, v.offset, v.length);
+        }
+    }
+
+    template<class S> static inline void
+    read(S* stream, FileBytes& v)
+    {
+        v.fd = -1;
+        v.offset = 0;
+        stream->read(v.bytes);
+        v.length = static_cast<Long>(v.bytes.size());
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,290 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef ICE_FLAT_MAP_H
+#define ICE_FLAT_MAP_H
+
+#include <Ice/StreamHelpers.h>
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+namespace Ice
+{
+
+//
+// FlatMap is the mapping of Slice dictionaries with the cpp:flat
+// metadata. It provides the std::map operations used by the
+// generated code and by most applications, but stores its entries in
+// a vector sorted by key: lookups are binary searches and the entries
+// are stored in a single allocation.
+//
+// Insertions in the middle of the map are linear. A FlatMap is
+// therefore best built in bulk, with append followed by sort, which
+// is what the unmarshaling code does.
+//
+template<typename K, typename V, typename C = std::less<K> >
+class FlatMap
+{
+public:
+
+    typedef K key_type;
+    typedef V mapped_type;
+    typedef std::pair<K, V> value_type;
+    typedef C key_compare;
+    typedef typename std::vector<value_type>::iterator iterator;
+    typedef typename std::vector<value_type>::const_iterator const_iterator;
+    typedef typename std::vector<value_type>::reverse_iterator reverse_iterator;
+    typedef typename std::vector<value_type>::const_reverse_iterator const_reverse_iterator;
+    typedef typename std::vector<value_type>::size_type size_type;
+    typedef typename std::vector<value_type>::difference_type difference_type;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+
+    FlatMap()
+    {
+    }
+
+    template<typename I>
+    FlatMap(I first, I last) :
+        _v(first, last)
+    {
+        sort();
+    }
+
+    iterator begin() { return _v.begin(); }
+    const_iterator begin() const { return _v.begin(); }
+    iterator end() { return _v.end(); }
+    const_iterator end() const { return _v.end(); }
+    reverse_iterator rbegin() { return _v.rbegin(); }
+    const_reverse_iterator rbegin() const { return _v.rbegin(); }
+    reverse_iterator rend() { return _v.rend(); }
+    const_reverse_iterator rend() const { return _v.rend(); }
+
+    bool empty() const { return _v.empty(); }
+    size_type size() const { return _v.size(); }
+    size_type max_size() const { return _v.max_size(); }
+    size_type capacity() const { return _v.capacity(); }
+
+    void clear() { _v.clear(); }
+    void reserve(size_type sz) { _v.reserve(sz); }
+    void swap(FlatMap& other) { _v.swap(other._v); }
+
+    iterator lower_bound(const K& k)
+    {
+        return std::lower_bound(_v.begin(), _v.end(), k, KeyCompare());
+    }
+
+    const_iterator lower_bound(const K& k) const
+    {
+        return std::lower_bound(_v.begin(), _v.end(), k, KeyCompare());
+    }
+
+    iterator upper_bound(const K& k)
+    {
+        return std::upper_bound(_v.begin(), _v.end(), k, KeyCompare());
+    }
+
+    const_iterator upper_bound(const K& k) const
+    {
+        return std::upper_bound(_v.begin(), _v.end(), k, KeyCompare());
+    }
+
+    iterator find(const K& k)
+    {
+        iterator p = lower_bound(k);
+        return p != _v.end() && !C()(k, p->first) ? p : _v.end();
+    }
+
+    const_iterator find(const K& k) const
+    {
+        const_iterator p = lower_bound(k);
+        return p != _v.end() && !C()(k, p->first) ? p : _v.end();
+    }
+
+    size_type count(const K& k) const
+    {
+        return find(k) != _v.end() ? 1 : 0;
+    }
+
+    V& operator[](const K& k)
+    {
+        iterator p = lower_bound(k);
+        if(p == _v.end() || C()(k, p->first))
+        {
+            p = _v.insert(p, value_type(k, V()));
+        }
+        return p->second;
+    }
+
+    std::pair<iterator, bool> insert(const value_type& v)
+    {
+        iterator p = lower_bound(v.first);
+        if(p != _v.end() && !C()(v.first, p->first))
+        {
+            return std::make_pair(p, false);
+        }
+        return std::make_pair(_v.insert(p, v), true);
+    }
+
+    //
+    // Like std::map, the hint is only used to avoid the search: the
+    // insertion is constant time if the entry goes right before the
+    // hint, in particular when appending entries in key order.
+    //
+    iterator insert(iterator hint, const value_type& v)
+    {
+        if((hint == _v.end() || C()(v.first, hint->first)) &&
+           (hint == _v.begin() || C()((hint - 1)->first, v.first)))
+        {
+            return _v.insert(hint, v);
+        }
+        return insert(v).first;
+    }
+
+    template<typename I>
+    void insert(I first, I last)
+    {
+        for(; first != last; ++first)
+        {
+            insert(_v.end(), *first);
+        }
+    }
+
+    void erase(iterator p)
+    {
+        _v.erase(p);
+    }
+
+    void erase(iterator first, iterator last)
+    {
+        _v.erase(first, last);
+    }
+
+    size_type erase(const K& k)
+    {
+        iterator p = find(k);
+        if(p == _v.end())
+        {
+            return 0;
+        }
+        _v.erase(p);
+        return 1;
+    }
+
+    //
+    // Bulk construction: append adds an entry at the end without
+    // checking the order of the keys, sort then restores the order.
+    // If several entries have the same key, the last one appended
+    // is kept.
+    //
+    void append(const value_type& v)
+    {
+        _v.push_back(v);
+    }
+
+    void sort()
+    {
+        //
+        // Entries are usually appended in key order, check for it
+        // before sorting.
+        //
+        bool sorted = true;
+        for(iterator p = _v.begin(); sorted && p != _v.end() && p + 1 != _v.end(); ++p)
+        {
+            sorted = C()(p->first, (p + 1)->first);
+        }
+        if(sorted)
+        {
+            return;
+        }
+
+        std::stable_sort(_v.begin(), _v.end(), EntryCompare());
+
+        //
+        // Remove duplicates, keeping the last entry of each key.
+        //
+        iterator q = _v.begin();
+        for(iterator p = _v.begin(); p != _v.end(); ++p)
+        {
+            if(p + 1 != _v.end() && !C()(p->first, (p + 1)->first))
+            {
+                continue;
+            }
+            if(q != p)
+            {
+                *q = *p;
+            }
+            ++q;
+        }
+        _v.erase(q, _v.end());
+    }
+
+    bool operator==(const FlatMap& rhs) const { return _v == rhs._v; }
+    bool operator!=(const FlatMap& rhs) const { return _v != rhs._v; }
+    bool operator<(const FlatMap& rhs) const { return _v < rhs._v; }
+    bool operator<=(const FlatMap& rhs) const { return _v <= rhs._v; }
+    bool operator>(const FlatMap& rhs) const { return _v > rhs._v; }
+    bool operator>=(const FlatMap& rhs) const { return _v >= rhs._v; }
+
+private:
+
+    struct KeyCompare
+    {
+        bool operator()(const value_type& lhs, const K& rhs) const
+        {
+            return C()(lhs.first, rhs);
+        }
+
+        bool operator()(const K& lhs, const value_type& rhs) const
+        {
+            return C()(lhs, rhs.first);
+        }
+    };
+
+    struct EntryCompare
+    {
+        bool operator()(const value_type& lhs, const value_type& rhs) const
+        {
+            return C()(lhs.first, rhs.first);
+        }
+    };
+
+    std::vector<value_type> _v;
+};
+
+//
+// The entries of a FlatMap are appended as they are unmarshaled and
+// sorted once the whole dictionary is read.
+//
+template<typename K, typename V, typename C>
+struct DictionaryBuilder<FlatMap<K, V, C> >
+{
+    static void reserve(FlatMap<K, V, C>& v, Int sz)
+    {
+        v.reserve(static_cast<typename FlatMap<K, V, C>::size_type>(sz));
+    }
+
+    static typename FlatMap<K, V, C>::iterator
+    insert(FlatMap<K, V, C>& v, const typename FlatMap<K, V, C>::value_type& p)
+    {
+        v.append(p);
+        return v.end() - 1;
+    }
+
+    static void finish(FlatMap<K, V, C>& v)
+    {
+        v.sort();
+    }
+};
+
+}
+
+#endif
@@ -78,6 +78,35 @@ public:
     virtual void destroy();
 };
 
+//
+// A runtime holds the client and server thread pools, the timer and
+// the endpoint host resolver of the communicators initialized with
+// it (see InitializationData), instead of each communicator creating
+// its own threads. The runtime is configured by the properties and
+// initialization data given to createRuntime: the Ice.ThreadPool.Client,
+// Ice.ThreadPool.Server and Ice.ThreadPriority properties, the
+// dispatcher, the thread notification hooks and the observer of these
+// threads are the runtime's, and the Ice.ServerIdleTime property of
+// the communicators is ignored. Setting a dispatcher or thread hooks
+// on a communicator which uses a runtime raises InitializationException.
+// Object adapters with their own thread pool still create it. A
+// communicator waits for its callbacks running with the threads of
+// the runtime on destruction. A runtime must be destroyed after the
+// communicators which use it.
+//
+class ICE_API Runtime
+#ifndef ICE_CPP11_MAPPING
+    : public IceUtil::Shared
+#endif
+{
+public:
+
+    virtual ~Runtime();
+
+    virtual void destroy() = 0;
+};
+ICE_DEFINE_PTR(RuntimePtr, Runtime);
+
 //
 // Communicator initialization info
 //
@@ -99,6 +128,7 @@ struct InitializationData
     BatchRequestInterceptorPtr batchRequestInterceptor;
 #endif
     ValueFactoryManagerPtr valueFactoryManager;
+    RuntimePtr runtime;
 };
 
 ICE_API CommunicatorPtr initialize(int&, char*[], const InitializationData& = InitializationData(),
@@ -110,6 +140,8 @@ ICE_API CommunicatorPtr initialize(Ice::StringSeq&, const InitializationData& =
 ICE_API CommunicatorPtr initialize(const InitializationData& = InitializationData(),
                                            Int = ICE_INT_VERSION);
 
+ICE_API RuntimePtr createRuntime(const InitializationData& = InitializationData());
+
 ICE_API LoggerPtr getProcessLogger();
 ICE_API void setProcessLogger(const LoggerPtr&);
 
@@ -165,6 +197,7 @@ namespace IceInternal
 //
 ICE_API InstancePtr getInstance(const ::Ice::CommunicatorPtr&);
 ICE_API IceUtil::TimerPtr getInstanceTimer(const ::Ice::CommunicatorPtr&);
+ICE_API InstancePtr getInstance(const ::Ice::RuntimePtr&);
 
 }
 
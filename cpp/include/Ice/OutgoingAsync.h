@@ -76,7 +76,7 @@ public:
 
     void invokeSent();
     void invokeException();
-    void invokeResponse();
+    virtual void invokeResponse();
 
     virtual void cancelable(const IceInternal::CancellationHandlerPtr&);
     void cancel();
@@ -253,7 +253,9 @@ public:
     void prepare(const std::string&, Ice::OperationMode, const Ice::Context&);
 
     virtual bool sent();
+    virtual bool exception(const Ice::Exception&);
     virtual bool response();
+    virtual void invokeResponse();
 
     virtual AsyncStatus invokeRemote(const Ice::ConnectionIPtr&, bool, bool);
     virtual AsyncStatus invokeCollocated(CollocatedRequestHandler*);
@@ -294,12 +296,22 @@ public:
 protected:
 
     const Ice::EncodingVersion _encoding;
+    int _priority; // The priority of the request on the connection, from the "_priority" context entry.
 
 #ifdef ICE_CPP11_MAPPING
     std::function<void(const ::Ice::UserException&)> _userException;
 #endif
 
     bool _synchronous;
+
+private:
+
+    IceUtil::Time latencySample();
+    void updateLatencyAsync(const IceUtil::Time&, bool);
+
+    IceUtil::Time _sendTime; // Set if the proxy uses the Latency endpoint selection type.
+    IceUtil::Time _rtt; // Round-trip time of the reply, reported by invokeResponse.
+    bool _invokeResponse; // True if invokeResponse must invoke the response callback.
 };
 
 //
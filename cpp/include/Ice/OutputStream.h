@@ -59,7 +59,7 @@ public:
     {
         // Inlined for performance reasons.
 
-        if(_currentEncaps != &_preAllocatedEncaps)
+        if(_currentEncaps != &_preAllocatedEncaps || _fileFd >= 0)
         {
             clear(); // Not inlined.
         }
@@ -148,7 +148,11 @@ public:
         assert(_currentEncaps);
 
         // Size includes size and version.
-        const Int sz = static_cast<Int>(b.size() - _currentEncaps->start);
+        Int sz = static_cast<Int>(b.size() - _currentEncaps->start);
+        if(_fileFd >= 0)
+        {
+            sz = endFileEncapsulation(sz);
+        }
         write(sz, &(*(b.begin() + _currentEncaps->start)));
 
         Encaps* oldEncaps = _currentEncaps;
@@ -235,6 +239,10 @@ public:
 
     void endSize(size_type position)
     {
+        if(_fileFd >= 0)
+        {
+            copyFile(); // The size must include the file range.
+        }
         rewrite(static_cast<Int>(b.size() - position) - 4, position);
     }
 
@@ -522,6 +530,32 @@ public:
     void finished(std::vector<Byte>&);
     std::pair<const Byte*, const Byte*> finished();
 
+    //
+    // File ranges, see FileBytes. writeFile writes the size of the
+    // range and duplicates the descriptor. If the range turns out to
+    // be the last data of the request or reply, the buffer doesn't
+    // hold it: the connection sends it after the buffer, directly from
+    // the file if the transport supports it. Otherwise the range is
+    // copied into the buffer, which copyFile also does on demand.
+    //
+    void writeFile(int, Long, Long);
+    void copyFile();
+
+    int fileDescriptor() const
+    {
+        return _fileFd;
+    }
+
+    Long fileOffset() const
+    {
+        return _fileOffset;
+    }
+
+    Long fileLength() const // The number of bytes sent after the buffer, 0 if none.
+    {
+        return _fileFd >= 0 ? _fileLength : 0;
+    }
+
     // Optionals
     bool writeOptImpl(Int, OptionalFormat);
 
@@ -540,6 +574,9 @@ private:
     //
     void throwEncapsulationException(const char*, int);
 
+    Int endFileEncapsulation(Int);
+    void closeFile();
+
     //
     // Optimization. The instance may not be deleted while a
     // stack-allocated stream still holds it.
@@ -746,6 +783,17 @@ private:
     void initEncaps();
 
     Encaps _preAllocatedEncaps;
+
+    //
+    // The file range sent after the buffer, _fileFd is -1 if there's
+    // none. _filePos is the position of the range in the marshaled
+    // data, which is the end of the buffer unless data was written
+    // after the range.
+    //
+    int _fileFd;
+    Long _fileOffset;
+    Long _fileLength;
+    Container::size_type _filePos;
 };
 
 } // End namespace Ice
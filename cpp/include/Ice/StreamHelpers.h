@@ -15,6 +15,8 @@
 #ifndef ICE_CPP11_MAPPING
 #   include <IceUtil/ScopedArray.h>
 #   include <IceUtil/Iterator.h>
+#else
+#   include <unordered_map>
 #endif
 
 namespace Ice
@@ -539,6 +541,51 @@ struct StreamHelper<std::pair<IceUtil::ScopedArray<T>, std::pair<const T*, const
 
 
 // Helper for dictionaries
+//
+// DictionaryBuilder is used by the dictionary helper to fill the
+// dictionary being unmarshaled: reserve is called with the number of
+// entries, insert for each entry before its value is unmarshaled, and
+// finish once all the entries are unmarshaled. Dictionary types can
+// specialize it to build the dictionary in bulk.
+//
+template<typename T>
+struct DictionaryBuilder
+{
+    static void reserve(T&, Int)
+    {
+    }
+
+    static typename T::iterator insert(T& v, const typename T::value_type& p)
+    {
+        return v.insert(v.end(), p);
+    }
+
+    static void finish(T&)
+    {
+    }
+};
+
+#ifdef ICE_CPP11_MAPPING
+template<typename K, typename V, typename H, typename E, typename A>
+struct DictionaryBuilder<std::unordered_map<K, V, H, E, A>>
+{
+    static void reserve(std::unordered_map<K, V, H, E, A>& v, Int sz)
+    {
+        v.reserve(static_cast<size_t>(sz));
+    }
+
+    static typename std::unordered_map<K, V, H, E, A>::iterator
+    insert(std::unordered_map<K, V, H, E, A>& v, const typename std::unordered_map<K, V, H, E, A>::value_type& p)
+    {
+        return v.insert(p).first;
+    }
+
+    static void finish(std::unordered_map<K, V, H, E, A>&)
+    {
+    }
+};
+#endif
+
 template<typename T>
 struct StreamHelper<T, StreamHelperCategoryDictionary>
 {
@@ -556,15 +603,18 @@ struct StreamHelper<T, StreamHelperCategoryDictionary>
     template<class S> static inline void
     read(S* stream, T& v)
     {
-        Int sz = stream->readSize();
+        Int sz = stream->readAndCheckSeqSize(StreamableTraits<typename T::key_type>::minWireSize +
+                                             StreamableTraits<typename T::mapped_type>::minWireSize);
         v.clear();
+        DictionaryBuilder<T>::reserve(v, sz);
         while(sz--)
         {
             typename T::value_type p;
             stream->read(const_cast<typename T::key_type&>(p.first));
-            typename T::iterator i = v.insert(v.end(), p);
+            typename T::iterator i = DictionaryBuilder<T>::insert(v, p);
             stream->read(i->second);
         }
+        DictionaryBuilder<T>::finish(v);
     }
 };
 
@@ -0,0 +1,76 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef ICE_STREAM_TABLE_H
+#define ICE_STREAM_TABLE_H
+
+#include <Ice/OutputStream.h>
+#include <Ice/InputStream.h>
+
+namespace Ice
+{
+
+//
+// Stream tables are used by the code generated with slice2cpp
+// --stream-tables. Instead of a StreamWriter and StreamReader which
+// marshal each data member inline, the data members of a struct,
+// class or exception are described by a table of entries which is
+// interpreted by writeTable and readTable.
+//
+// Built-in types are marshaled by the interpreter. Other types are
+// marshaled with the functions of their StreamTableHelper, which
+// are instantiated once per type rather than once per data member.
+//
+enum StreamTableKind
+{
+    StreamTableBool,
+    StreamTableByte,
+    StreamTableShort,
+    StreamTableInt,
+    StreamTableLong,
+    StreamTableFloat,
+    StreamTableDouble,
+    StreamTableString,
+    StreamTableHelper
+};
+
+struct StreamTableEntry
+{
+    StreamTableKind kind;
+    void (*write)(OutputStream*, const void*);
+    void (*read)(InputStream*, void*);
+};
+
+template<typename T>
+struct StreamTableHelper
+{
+    static void write(OutputStream* os, const void* v)
+    {
+        os->write(*static_cast<const T*>(v));
+    }
+
+    static void read(InputStream* is, void* v)
+    {
+        is->read(*static_cast<T*>(v));
+    }
+};
+
+//
+// The table of a type is provided by a specialization of
+// StreamTable generated by slice2cpp.
+//
+template<typename T>
+struct StreamTable;
+
+ICE_API void writeTable(OutputStream*, const void* const*, const StreamTableEntry*, size_t);
+ICE_API void readTable(InputStream*, void* const*, const StreamTableEntry*, size_t);
+
+}
+
+#endif
@@ -141,6 +141,28 @@ public:
 #endif
     }
 
+    inline bool compare_exchange_strong(int& expected, int desired)
+    {
+#if defined(_WIN32)
+        int prev = static_cast<int>(InterlockedCompareExchange(&_ref, desired, expected));
+#elif defined(ICE_HAS_GCC_BUILTINS)
+        int prev = __sync_val_compare_and_swap(&_ref, expected, desired);
+#else
+        IceUtil::Mutex::Lock sync(_mutex);
+        int prev = _ref;
+        if(prev == expected)
+        {
+            _ref = desired;
+        }
+#endif
+        if(prev == expected)
+        {
+            return true;
+        }
+        expected = prev;
+        return false;
+    }
+
     inline int operator++()
     {
         return fetch_add(1) + 1;
@@ -28,10 +28,27 @@ const string clientTraceRequest = "Glacier2.Client.Trace.Request";
 const string serverTraceOverride = "Glacier2.Server.Trace.Override";
 const string clientTraceOverride = "Glacier2.Client.Trace.Override";
 
+//
+// The client request rate limit and weight of a session are set by
+// Glacier2.Client.<category>.<property>, where the category is the
+// permissions verifier which authorized the session (Password or
+// SSL), or by Glacier2.Client.<property>.
+//
+int
+getClientProperty(const Ice::PropertiesPtr& properties, const string& category, const string& name, int dflt)
+{
+    dflt = properties->getPropertyAsIntWithDefault("Glacier2.Client." + name, dflt);
+    if(category.empty())
+    {
+        return dflt;
+    }
+    return properties->getPropertyAsIntWithDefault("Glacier2.Client." + category + "." + name, dflt);
+}
+
 }
 
 Glacier2::Blobject::Blobject(const InstancePtr& instance, const ConnectionPtr& reverseConnection,
-                             const Context& context) :
+                             const Context& context, const string& category) :
     _instance(instance),
     _reverseConnection(reverseConnection),
     _forwardContext(_reverseConnection ?
@@ -52,7 +69,23 @@ Glacier2::Blobject::Blobject(const InstancePtr& instance, const ConnectionPtr& r
                                                    _instance->clientRequestQueueThread();
     if(t)
     {
-        const_cast<RequestQueuePtr&>(_requestQueue) = new RequestQueue(t, _instance, _reverseConnection);
+        //
+        // Only the requests from the client are throttled, the server
+        // requests are callbacks to the client.
+        //
+        int rateLimit = 0;
+        int burst = 0;
+        int weight = 0;
+        int maxQueued = 0;
+        if(!_reverseConnection)
+        {
+            rateLimit = getClientProperty(_instance->properties(), category, "RateLimit", 0);
+            burst = getClientProperty(_instance->properties(), category, "RateLimit.Burst", rateLimit);
+            weight = getClientProperty(_instance->properties(), category, "Weight", 0);
+            maxQueued = getClientProperty(_instance->properties(), category, "MaxQueued", 0);
+        }
+        const_cast<RequestQueuePtr&>(_requestQueue) = new RequestQueue(t, _instance, _reverseConnection, rateLimit,
+                                                                       burst, weight, maxQueued);
     }
 }
 
@@ -294,7 +327,7 @@ Glacier2::Blobject::invoke(ObjectPrx& proxy, const AMD_Object_ice_invokePtr& amd
             override = _requestQueue->addRequest(new Request(proxy, inParams, current, _forwardContext, _context,
                                                              amdCB));
         }
-        catch(const ObjectNotExistException& ex)
+        catch(const LocalException& ex)
         {
             amdCB->ice_exception(ex);
             return;
@@ -21,7 +21,7 @@ class Blobject : public Ice::BlobjectArrayAsync
 {
 public:
     
-    Blobject(const InstancePtr&, const Ice::ConnectionPtr&, const Ice::Context&);
+    Blobject(const InstancePtr&, const Ice::ConnectionPtr&, const Ice::Context&, const std::string&);
     virtual ~Blobject();
 
     void destroy();
@@ -19,9 +19,9 @@ using namespace Glacier2;
 Glacier2::ClientBlobject::ClientBlobject(const InstancePtr& instance,
                                          const FilterManagerPtr& filters,
                                          const Ice::Context& sslContext,
-                                         const RoutingTablePtr& routingTable):
-                                         
-    Glacier2::Blobject(instance, 0, sslContext),
+                                         const RoutingTablePtr& routingTable,
+                                         const string& category) :
+    Glacier2::Blobject(instance, 0, sslContext, category),
     _routingTable(routingTable),
     _filters(filters),
     _rejectTraceLevel(_instance->properties()->getPropertyAsInt("Glacier2.Client.Trace.Reject"))
@@ -41,10 +41,15 @@ Glacier2::ClientBlobject::ice_invoke_async(const Ice::AMD_Object_ice_invokePtr&
     bool hasFilters = false;
     string rejectedFilters;
  
-    if(!_filters->categories()->empty())
+    //
+    // The filters are immutable snapshots, they are matched without
+    // holding the lock of the session filters.
+    //
+    StringSetI::SnapshotPtr categories = _filters->categories()->snapshot();
+    if(!categories->items().empty())
     {
         hasFilters = true;
-        if(_filters->categories()->match(current.id.category))
+        if(categories->match(current.id.category))
         {
             matched = true;
         }
@@ -59,10 +64,11 @@ Glacier2::ClientBlobject::ice_invoke_async(const Ice::AMD_Object_ice_invokePtr&
         }
     }
 
-    if(!_filters->identities()->empty())
+    IdentitySetI::SnapshotPtr identities = _filters->identities()->snapshot();
+    if(!identities->items().empty())
     {
         hasFilters = true;
-        if(_filters->identities()->match(current.id))
+        if(identities->match(current.id))
         {
             matched = true;
         }
@@ -96,10 +102,15 @@ Glacier2::ClientBlobject::ice_invoke_async(const Ice::AMD_Object_ice_invokePtr&
 
     string adapterId = proxy->ice_getAdapterId();
 
-    if(!adapterId.empty() && !_filters->adapterIds()->empty())
+    StringSetI::SnapshotPtr adapterIds;
+    if(!adapterId.empty())
+    {
+        adapterIds = _filters->adapterIds()->snapshot();
+    }
+    if(adapterIds && !adapterIds->items().empty())
     {
         hasFilters = true;
-        if(_filters->adapterIds()->match(adapterId))
+        if(adapterIds->match(adapterId))
         {
             matched = true;
         }
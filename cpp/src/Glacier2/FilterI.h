@@ -12,13 +12,166 @@
 #include <Glacier2/Session.h>
 
 #include <Ice/Identity.h>
+#include <IceUtil/Atomic.h>
+#include <IceUtil/Thread.h>
 #include <string>
 #include <vector>
-#include <list>
+#include <algorithm>
+#include <iterator>
+
+#ifdef ICE_CPP11_COMPILER
+#   include <unordered_set>
+#endif
 
 namespace Glacier2
 {
 
+#ifdef ICE_CPP11_COMPILER
+template<typename T>
+struct FilterItemHash
+{
+    size_t
+    operator()(const T& item) const
+    {
+        return std::hash<T>()(item);
+    }
+};
+
+template<>
+struct FilterItemHash<Ice::Identity>
+{
+    size_t
+    operator()(const Ice::Identity& id) const
+    {
+        size_t h = std::hash<std::string>()(id.name);
+        return h ^ (std::hash<std::string>()(id.category) + 0x9e3779b9 + (h << 6) + (h >> 2));
+    }
+};
+#endif
+
+//
+// An immutable set of filter items, sorted and without duplicates.
+// The version is the version of the configured items the set is
+// built from.
+//
+template<typename T>
+class FilterSnapshotT : public IceUtil::Shared
+{
+public:
+
+    FilterSnapshotT(const std::vector<T>& items, int version) :
+        _items(items),
+#ifdef ICE_CPP11_COMPILER
+        _set(items.begin(), items.end()),
+#endif
+        _version(version)
+    {
+    }
+
+    const std::vector<T>&
+    items() const
+    {
+        return _items;
+    }
+
+    int
+    version() const
+    {
+        return _version;
+    }
+
+    bool
+    match(const T& candidate) const
+    {
+        //
+        // Empty vectors mean no filtering, so all matches will succeed.
+        //
+#ifdef ICE_CPP11_COMPILER
+        return _items.empty() || _set.find(candidate) != _set.end();
+#else
+        return _items.empty() || std::binary_search(_items.begin(), _items.end(), candidate);
+#endif
+    }
+
+private:
+
+    const std::vector<T> _items;
+#ifdef ICE_CPP11_COMPILER
+    const std::unordered_set<T, FilterItemHash<T> > _set;
+#endif
+    const int _version;
+};
+
+template<typename T>
+std::vector<T>
+sortFilterItems(const std::vector<T>& items)
+{
+    std::vector<T> sorted(items);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    return sorted;
+}
+
+//
+// The items configured with the Glacier2.Filter properties, shared by
+// the filters of all the sessions. Setting the items replaces the
+// snapshot and increments the version, the session filters pick up
+// the new snapshot when they find out that the version changed.
+//
+template<typename T>
+class FilterItemsT : public IceUtil::Shared, public IceUtil::Mutex
+{
+public:
+
+    typedef IceUtil::Handle<FilterSnapshotT<T> > SnapshotPtr;
+
+    FilterItemsT(const std::vector<T>& items) :
+        _version(0),
+        _snapshot(new FilterSnapshotT<T>(sortFilterItems(items), 0))
+    {
+    }
+
+    void
+    set(const std::vector<T>& items)
+    {
+        IceUtil::Mutex::Lock lock(*this);
+        _snapshot = new FilterSnapshotT<T>(sortFilterItems(items), _snapshot->version() + 1);
+        ++_version;
+    }
+
+    SnapshotPtr
+    get() const
+    {
+        IceUtil::Mutex::Lock lock(*this);
+        return _snapshot;
+    }
+
+    //
+    // The version is read without locking, it's checked by the
+    // session filters for each request.
+    //
+    int
+    version() const
+    {
+        return _version;
+    }
+
+private:
+
+    IceUtilInternal::Atomic _version;
+    SnapshotPtr _snapshot;
+};
+
+//
+// The filter of a session. The items accepted by the filter are the
+// configured items and the items added by the session control, minus
+// the items removed by the session control. The accepted items are an
+// immutable snapshot. The snapshot is read without locking: the filter
+// keeps two snapshot slots and a count of the readers of each slot, a
+// new snapshot is written to the slot which isn't current once its
+// readers are gone and the current slot is then switched. The lock is
+// only used to update the snapshot.
+//
 template <typename T, class P>
 class FilterT : public P, public IceUtil::Monitor<IceUtil::Mutex>
 {
@@ -30,9 +183,10 @@ public:
     //
     typedef typename std::vector<T>::const_iterator const_iterator;
     typedef typename std::vector<T>::iterator iterator;
-    typedef typename std::list<iterator>::iterator literator;
+    typedef IceUtil::Handle<FilterSnapshotT<T> > SnapshotPtr;
+    typedef IceUtil::Handle<FilterItemsT<T> > ItemsPtr;
 
-    FilterT(const std::vector<T>&);
+    FilterT(const ItemsPtr&, const std::vector<T>& = std::vector<T>());
 
     //
     // Slice to C++ mapping.
@@ -44,129 +198,141 @@ public:
     //
     // Internal functions.
     //
-    bool
-    match(const T& candidate) const
+    SnapshotPtr
+    snapshot() const
     {
-        IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
-        //
-        // Empty vectors mean no filtering, so all matches will succeed.
-        //
-        if(_items.size() == 0)
+        SnapshotPtr snapshot = current();
+        if(snapshot->version() != _configured->version())
         {
-            return true;
+            IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
+            snapshot = _snapshots[_current.load()];
+            if(snapshot->version() != _configured->version())
+            {
+                update();
+                snapshot = _snapshots[_current.load()];
+            }
         }
-
-        return binary_search(_items.begin(), _items.end(), candidate);
+        return snapshot;
     }
 
-    bool 
-    empty() const
-    {
-        IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
-        return _items.size() == 0;
-    }
-        
 private:
-    
-    std::vector<T> _items;
+
+    SnapshotPtr current() const;
+    void update() const;
+
+    const ItemsPtr _configured;
+    std::vector<T> _added;
+    std::vector<T> _removed;
+    mutable SnapshotPtr _snapshots[2];
+    mutable IceUtilInternal::Atomic _current;
+    mutable IceUtilInternal::Atomic _readers[2];
 };
 
 template<class T, class P>
-FilterT<T, P>::FilterT(const std::vector<T>& accept):
-    _items(accept)
+FilterT<T, P>::FilterT(const ItemsPtr& configured, const std::vector<T>& added):
+    _configured(configured),
+    _added(sortFilterItems(added)),
+    _current(0)
+{
+    _readers[0].exchange(0);
+    _readers[1].exchange(0);
+    update();
+}
+
+//
+// Returns the current snapshot without locking. The reader count of
+// the slot is incremented before checking that the slot is still the
+// current slot, so that the slot isn't written while it's read.
+//
+template<class T, class P> typename FilterT<T, P>::SnapshotPtr
+FilterT<T, P>::current() const
 {
-    sort(_items.begin(), _items.end());
-    _items.erase(unique(_items.begin(), _items.end()), _items.end());
+    while(true)
+    {
+        int slot = _current.load();
+        ++_readers[slot];
+        if(_current.load() == slot)
+        {
+            SnapshotPtr snapshot = _snapshots[slot];
+            --_readers[slot];
+            return snapshot;
+        }
+        --_readers[slot];
+    }
 }
 
+//
+// Rebuild the snapshot from the configured items and the items added
+// and removed by the session control. Must be called with the lock.
+//
 template<class T, class P> void
-FilterT<T, P>::add(const std::vector<T>& additions, const Ice::Current&)
+FilterT<T, P>::update() const
 {
+    SnapshotPtr configured = _configured->get();
+
+    std::vector<T> merged;
+    std::set_union(configured->items().begin(), configured->items().end(), _added.begin(), _added.end(),
+                   std::back_inserter(merged));
+
+    std::vector<T> items;
+    std::set_difference(merged.begin(), merged.end(), _removed.begin(), _removed.end(), std::back_inserter(items));
+
     //
-    // Sort the filter elements first, erasing duplicates. Then we can
-    // simply use the STL merge algorithm to add to our list of filters.
+    // Wait for the readers of the other slot, which only copy the
+    // snapshot handle, before replacing its snapshot.
     //
-    std::vector<T> newItems(additions);
-    sort(newItems.begin(), newItems.end());
-    newItems.erase(unique(newItems.begin(), newItems.end()), newItems.end());
+    int slot = 1 - _current.load();
+    while(_readers[slot].load() > 0)
+    {
+        IceUtil::ThreadControl::yield();
+    }
+    _snapshots[slot] = new FilterSnapshotT<T>(items, configured->version());
+    _current.exchange(slot);
+}
+
+template<class T, class P> void
+FilterT<T, P>::add(const std::vector<T>& additions, const Ice::Current&)
+{
+    std::vector<T> newItems = sortFilterItems(additions);
 
     IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
-    std::vector<T> merged(_items.size() + newItems.size());
-    merge(newItems.begin(), newItems.end(), _items.begin(), _items.end(), merged.begin());
-    merged.erase(unique(merged.begin(), merged.end()), merged.end());
-    swap(_items, merged);
+
+    std::vector<T> added;
+    std::set_union(_added.begin(), _added.end(), newItems.begin(), newItems.end(), std::back_inserter(added));
+    _added.swap(added);
+
+    std::vector<T> removed;
+    std::set_difference(_removed.begin(), _removed.end(), newItems.begin(), newItems.end(),
+                        std::back_inserter(removed));
+    _removed.swap(removed);
+
+    update();
 }
 
 template<class T, class P> void
 FilterT<T, P>::remove(const std::vector<T>& deletions, const Ice::Current&)
 {
-    //
-    // Our removal algorithm depends on the filter elements to be
-    // removed to be sorted in the same order as our current elements.
-    //
-    std::vector<T> toRemove(deletions);
-    sort(toRemove.begin(), toRemove.end());
-    toRemove.erase(unique(toRemove.begin(), toRemove.end()), toRemove.end());
+    std::vector<T> toRemove = sortFilterItems(deletions);
 
     IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
 
-    //
-    // Our vectors are both sorted, so if we keep track of our first
-    // match between the current set and the set of items to be removed,
-    // we do not need to traverse the whole of the current set each
-    // time. We also use a list of deletions instead of erasing things
-    // itemwise. 
-    //
-
-    //
-    // The presence of the 'typename' is a GCC specific workaround. The
-    // iterator types apparently resolve to a 'void' in GCC type
-    // causing compiler errors.
-    // 
-    const_iterator r = toRemove.begin();
-    iterator mark = _items.begin();
-    std::list<iterator> deleteList;
-
-    while(r != toRemove.end())
-    {
-        iterator i = mark;
-        while(i != _items.end() && r != toRemove.end())
-        {
-            if(*r == *i)
-            {
-                //
-                // We want this list to be in LIFO order because we are
-                // going to erase things from the tail forward.
-                //
-                deleteList.push_front(i);
-                ++i;
-                ++r;
-                mark = i;
-            }
-            else
-            {
-                ++i;
-            }
-        }
+    std::vector<T> removed;
+    std::set_union(_removed.begin(), _removed.end(), toRemove.begin(), toRemove.end(),
+                   std::back_inserter(removed));
+    _removed.swap(removed);
 
-        if(r == toRemove.end())
-        {
-            break;
-        }
-        ++r;
-    }
+    std::vector<T> added;
+    std::set_difference(_added.begin(), _added.end(), toRemove.begin(), toRemove.end(),
+                        std::back_inserter(added));
+    _added.swap(added);
 
-    for(literator i = deleteList.begin(); i != deleteList.end(); ++i)
-    {
-        _items.erase(*i);
-    }
+    update();
 }
 
-template<class T, class P> std::vector<T> 
+template<class T, class P> std::vector<T>
 FilterT<T, P>::get(const Ice::Current&)
 {
-    IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
-    return _items;
+    return snapshot()->items();
 }
 
 typedef FilterT<Ice::Identity, Glacier2::IdentitySet> IdentitySetI;
@@ -175,6 +341,12 @@ typedef IceUtil::Handle< FilterT<Ice::Identity, Glacier2::IdentitySet> > Identit
 typedef FilterT<std::string, Glacier2::StringSet> StringSetI;
 typedef IceUtil::Handle< FilterT<std::string, Glacier2::StringSet> > StringSetIPtr;
 
+typedef FilterItemsT<Ice::Identity> IdentityFilterItems;
+typedef IceUtil::Handle<IdentityFilterItems> IdentityFilterItemsPtr;
+
+typedef FilterItemsT<std::string> StringFilterItems;
+typedef IceUtil::Handle<StringFilterItems> StringFilterItemsPtr;
+
 };
 
 #endif
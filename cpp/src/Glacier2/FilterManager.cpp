@@ -9,6 +9,7 @@
 
 #include <Ice/Communicator.h>
 #include <Ice/Logger.h>
+#include <Ice/LoggerUtil.h>
 #include <Ice/Properties.h>
 #include <IceUtil/IceUtil.h>
 #include <IceUtil/StringUtil.h>
@@ -103,6 +104,68 @@ stringToSeq(const CommunicatorPtr& comm, const string& str, vector<Identity>& se
     }
 }
 
+static vector<string>
+getCategories(const PropertiesPtr& properties)
+{
+    vector<string> seq;
+    stringToSeq(properties->getProperty("Glacier2.Filter.Category.Accept"), seq);
+    return seq;
+}
+
+static vector<string>
+getAdapterIds(const PropertiesPtr& properties)
+{
+    vector<string> seq;
+    stringToSeq(properties->getProperty("Glacier2.Filter.AdapterId.Accept"), seq);
+    return seq;
+}
+
+static IdentitySeq
+getIdentities(const CommunicatorPtr& communicator)
+{
+    IdentitySeq seq;
+    stringToSeq(communicator, communicator->getProperties()->getProperty("Glacier2.Filter.Identity.Accept"), seq);
+    return seq;
+}
+
+Glacier2::FilterConfig::FilterConfig(const CommunicatorPtr& communicator) :
+    _communicator(communicator),
+    _categories(new StringFilterItems(getCategories(communicator->getProperties()))),
+    _adapterIds(new StringFilterItems(getAdapterIds(communicator->getProperties()))),
+    _identities(new IdentityFilterItems(getIdentities(communicator)))
+{
+}
+
+void
+Glacier2::FilterConfig::updated(const PropertyDict& changes)
+{
+    bool reload = false;
+    for(PropertyDict::const_iterator p = changes.begin(); p != changes.end(); ++p)
+    {
+        if(p->first.find("Glacier2.Filter.") == 0)
+        {
+            reload = true;
+            break;
+        }
+    }
+
+    if(!reload)
+    {
+        return;
+    }
+
+    PropertiesPtr properties = _communicator->getProperties();
+    _categories->set(getCategories(properties));
+    _adapterIds->set(getAdapterIds(properties));
+    _identities->set(getIdentities(_communicator));
+
+    if(properties->getPropertyAsInt("Glacier2.Trace.Session") >= 1)
+    {
+        Trace out(_communicator->getLogger(), "Glacier2");
+        out << "reloaded the filter configuration";
+    }
+}
+
 Glacier2::FilterManager::~FilterManager()
 {
     destroy();
@@ -176,10 +239,13 @@ Glacier2::FilterManagerPtr
 Glacier2::FilterManager::create(const InstancePtr& instance, const string& userId, const bool allowAddUser)
 {
     PropertiesPtr props = instance->properties();
-    string allow = props->getProperty("Glacier2.Filter.Category.Accept");
-    vector<string> allowSeq;
-    stringToSeq(allow, allowSeq);
+    const FilterConfigPtr& config = instance->filterConfig();
 
+    //
+    // The user category is accepted in addition to the configured
+    // categories, like the categories added with the session control.
+    //
+    vector<string> userCategories;
     if(allowAddUser)
     {
         int addUserMode = 0;
@@ -192,30 +258,17 @@ Glacier2::FilterManager::create(const InstancePtr& instance, const string& userI
         {
             if(addUserMode == 1)
             {
-                allowSeq.push_back(userId); // Add user id to allowed categories.
+                userCategories.push_back(userId); // Add user id to allowed categories.
             }
             else if(addUserMode == 2)
             {
-                allowSeq.push_back('_' + userId); // Add user id with prepended underscore to allowed categories.
+                userCategories.push_back('_' + userId); // Add user id with prepended underscore to allowed categories.
             }
         }       
     }
-    Glacier2::StringSetIPtr categoryFilter = new Glacier2::StringSetI(allowSeq);
-
-    //
-    // TODO: refactor initialization of filters.
-    //
-    allow = props->getProperty("Glacier2.Filter.AdapterId.Accept");
-    stringToSeq(allow, allowSeq);
-    Glacier2::StringSetIPtr adapterIdFilter = new Glacier2::StringSetI(allowSeq);
-
-    //
-    // TODO: Object id's from configurations?
-    // 
-    IdentitySeq allowIdSeq;
-    allow = props->getProperty("Glacier2.Filter.Identity.Accept");
-    stringToSeq(instance->communicator(), allow, allowIdSeq);
-    Glacier2::IdentitySetIPtr identityFilter = new Glacier2::IdentitySetI(allowIdSeq);
+    Glacier2::StringSetIPtr categoryFilter = new Glacier2::StringSetI(config->categories(), userCategories);
+    Glacier2::StringSetIPtr adapterIdFilter = new Glacier2::StringSetI(config->adapterIds());
+    Glacier2::IdentitySetIPtr identityFilter = new Glacier2::IdentitySetI(config->identities());
 
     return new Glacier2::FilterManager(instance, categoryFilter, adapterIdFilter, identityFilter);
 }
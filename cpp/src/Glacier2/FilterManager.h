@@ -17,10 +17,52 @@
 #include <Glacier2/Instance.h>
 #include <Glacier2/FilterI.h>
 #include <Ice/ObjectAdapter.h>
+#include <Ice/NativePropertiesAdmin.h>
 
 namespace Glacier2
 {
 
+//
+// The filter items configured with the Glacier2.Filter properties,
+// shared by the filters of all the sessions. The items are reloaded
+// when these properties are updated with the Properties admin facet,
+// and the filters of the existing sessions use the new items for
+// their next requests.
+//
+class FilterConfig : public Ice::PropertiesAdminUpdateCallback
+{
+public:
+
+    FilterConfig(const Ice::CommunicatorPtr&);
+
+    virtual void updated(const Ice::PropertyDict&);
+
+    const StringFilterItemsPtr&
+    categories() const
+    {
+        return _categories;
+    }
+
+    const StringFilterItemsPtr&
+    adapterIds() const
+    {
+        return _adapterIds;
+    }
+
+    const IdentityFilterItemsPtr&
+    identities() const
+    {
+        return _identities;
+    }
+
+private:
+
+    const Ice::CommunicatorPtr _communicator;
+    const StringFilterItemsPtr _categories;
+    const StringFilterItemsPtr _adapterIds;
+    const IdentityFilterItemsPtr _identities;
+};
+
 class FilterManager;
 typedef IceUtil::Handle<FilterManager> FilterManagerPtr;
 
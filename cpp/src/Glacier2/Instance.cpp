@@ -10,6 +10,7 @@
 #include <Glacier2/SessionRouterI.h>
 #include <Glacier2/Instance.h>
 #include <Glacier2/InstrumentationI.h>
+#include <Glacier2/FilterManager.h>
 #include <Ice/InstrumentationI.h>
 
 using namespace std;
@@ -65,6 +66,18 @@ Glacier2::Instance::Instance(const Ice::CommunicatorPtr& communicator, const Ice
 
     const_cast<ProxyVerifierPtr&>(_proxyVerifier) = new ProxyVerifier(communicator);
 
+    //
+    // Reload the filter configuration when the filter properties are
+    // updated with the Properties admin facet.
+    //
+    const_cast<FilterConfigPtr&>(_filterConfig) = new FilterConfig(communicator);
+    Ice::NativePropertiesAdminPtr admin =
+        Ice::NativePropertiesAdminPtr::dynamicCast(communicator->findAdminFacet("Properties"));
+    if(admin)
+    {
+        admin->addUpdateCallback(_filterConfig);
+    }
+
     //
     // If an Ice metrics observer is setup on the communicator, also
     // enable metrics for IceStorm.
@@ -96,6 +109,13 @@ Glacier2::Instance::destroy()
         _serverRequestQueueThread->destroy();
     }
 
+    Ice::NativePropertiesAdminPtr admin =
+        Ice::NativePropertiesAdminPtr::dynamicCast(_communicator->findAdminFacet("Properties"));
+    if(admin)
+    {
+        admin->removeUpdateCallback(_filterConfig);
+    }
+
     const_cast<SessionRouterIPtr&>(_sessionRouter) = 0;
 }
 
@@ -23,6 +23,9 @@
 namespace Glacier2
 {
 
+class FilterConfig;
+typedef IceUtil::Handle<FilterConfig> FilterConfigPtr;
+
 class Instance : public IceUtil::Shared
 {
 public:
@@ -40,6 +43,7 @@ public:
     RequestQueueThreadPtr serverRequestQueueThread() const { return _serverRequestQueueThread; }
     ProxyVerifierPtr proxyVerifier() const { return _proxyVerifier; }
     SessionRouterIPtr sessionRouter() const { return _sessionRouter; }
+    const FilterConfigPtr& filterConfig() const { return _filterConfig; }
 
     const Glacier2::Instrumentation::RouterObserverPtr& getObserver() const { return _observer; }
 
@@ -59,6 +63,7 @@ private:
     const RequestQueueThreadPtr _serverRequestQueueThread;
     const ProxyVerifierPtr _proxyVerifier;
     const SessionRouterIPtr _sessionRouter;
+    const FilterConfigPtr _filterConfig;
     const Glacier2::Instrumentation::RouterObserverPtr _observer;
 };
 typedef IceUtil::Handle<Instance> InstancePtr;
@@ -172,6 +172,12 @@ SessionObserverI::overridden(bool client)
     }
 }
 
+void
+SessionObserverI::throttled()
+{
+    forEach(inc(&SessionMetrics::throttledClient));
+}
+
 void
 SessionObserverI::routingTableSize(int delta)
 {
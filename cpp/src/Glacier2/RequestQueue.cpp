@@ -191,13 +191,24 @@ Glacier2::Request::queued()
 
 Glacier2::RequestQueue::RequestQueue(const RequestQueueThreadPtr& requestQueueThread,
                                      const InstancePtr& instance,
-                                     const Ice::ConnectionPtr& connection) :
+                                     const Ice::ConnectionPtr& connection,
+                                     int rateLimit,
+                                     int burst,
+                                     int weight,
+                                     int maxQueued) :
     _requestQueueThread(requestQueueThread),
     _instance(instance),
     _connection(connection),
     _callback(newCallback_Object_ice_invoke(this, &RequestQueue::response, &RequestQueue::exception,
                                             &RequestQueue::sent)),
     _flushCallback(newCallback_Connection_flushBatchRequests(this, &RequestQueue::exception, &RequestQueue::sent)),
+    _rateLimit(rateLimit),
+    _burst(burst > 0 ? burst : 1),
+    _weight(weight),
+    _maxQueued(maxQueued),
+    _tokens(_burst),
+    _refillTime(IceUtil::Time::now(IceUtil::Time::Monotonic)),
+    _throttled(0),
     _pendingSend(false),
     _destroyed(false)
 {
@@ -232,6 +243,15 @@ Glacier2::RequestQueue::addRequest(const RequestPtr& request)
         }
     }
 
+    if(_maxQueued > 0 && _requests.size() >= static_cast<deque<RequestPtr>::size_type>(_maxQueued))
+    {
+        //
+        // Don't let a client which sends requests faster than they
+        // are forwarded grow the queue without bounds.
+        //
+        throw Ice::UnknownLocalException(__FILE__, __LINE__, "Glacier2 request queue is full");
+    }
+
     if(!_connection)
     {
         //
@@ -258,21 +278,55 @@ Glacier2::RequestQueue::addRequest(const RequestPtr& request)
     return false;
 }
 
-void
-Glacier2::RequestQueue::flushRequests()
+bool
+Glacier2::RequestQueue::flushRequests(IceUtil::Time& delay)
 {
     IceUtil::Mutex::Lock lock(*this);
     if(_connection)
     {
         if(_pendingSend)
         {
-            return;
+            return false;
         }
         flush();
     }
     else
     {
-        for(deque<RequestPtr>::const_iterator p = _requests.begin(); p != _requests.end(); ++p)
+        deque<RequestPtr>::size_type count = _requests.size();
+        if(_weight > 0 && count > static_cast<deque<RequestPtr>::size_type>(_weight))
+        {
+            count = static_cast<deque<RequestPtr>::size_type>(_weight);
+        }
+
+        if(_rateLimit > 0)
+        {
+            IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+            _tokens = min(_tokens + (now - _refillTime).toSecondsDouble() * _rateLimit, static_cast<double>(_burst));
+            _refillTime = now;
+            if(count > _tokens)
+            {
+                count = static_cast<deque<RequestPtr>::size_type>(_tokens);
+
+                //
+                // The requests which can't be forwarded wait for the
+                // tokens, each of them is reported once to the observer.
+                //
+                if(_observer)
+                {
+                    for(deque<RequestPtr>::size_type i = max(count, _throttled); i < _requests.size(); ++i)
+                    {
+                        _observer->throttled();
+                    }
+                }
+                _throttled = _requests.size();
+                delay = IceUtil::Time::microSecondsDouble((1.0 - (_tokens - count)) * 1000000.0 / _rateLimit);
+            }
+            _tokens -= count;
+        }
+        _throttled = _throttled > count ? _throttled - count : 0;
+
+        deque<RequestPtr>::iterator end = _requests.begin() + count;
+        for(deque<RequestPtr>::const_iterator p = _requests.begin(); p != end; ++p)
         {
             try
             {
@@ -288,19 +342,28 @@ Glacier2::RequestQueue::flushRequests()
                 // Ignore, this can occur for batch requests.
             }
         }
-        _requests.clear();
+        _requests.erase(_requests.begin(), end);
 
         for(set<Ice::ObjectPrx>::const_iterator q = _batchProxies.begin(); q != _batchProxies.end(); ++q)
         {
             (*q)->begin_ice_flushBatchRequests();
         }
         _batchProxies.clear();
+
+        //
+        // The remaining requests are forwarded with the next flush.
+        //
+        for(deque<RequestPtr>::const_iterator p = _requests.begin(); p != _requests.end(); ++p)
+        {
+            (*p)->addBatchProxy(_batchProxies);
+        }
     }
 
     if(_destroyed && _requests.empty())
     {
         destroyInternal();
     }
+    return !_connection && !_requests.empty();
 }
 
 void
@@ -320,6 +383,26 @@ Glacier2::RequestQueue::destroy()
     }
 }
 
+void
+Glacier2::RequestQueue::abortRequests()
+{
+    IceUtil::Mutex::Lock lock(*this);
+
+    //
+    // The request queue thread is destroyed and won't flush this queue
+    // anymore, fail the queued requests and release the callbacks.
+    //
+    for(deque<RequestPtr>::const_iterator p = _requests.begin(); p != _requests.end(); ++p)
+    {
+        (*p)->exception(Ice::ObjectNotExistException(__FILE__, __LINE__));
+    }
+    _requests.clear();
+    _batchProxies.clear();
+    _throttled = 0;
+    _destroyed = true;
+    destroyInternal();
+}
+
 void
 Glacier2::RequestQueue::updateObserver(const Glacier2::Instrumentation::SessionObserverPtr& observer)
 {
@@ -506,6 +589,7 @@ Glacier2::RequestQueueThread::flushRequestQueue(const RequestQueuePtr& queue)
 void
 Glacier2::RequestQueueThread::run()
 {
+    vector<RequestQueuePtr> delayedQueues;
     while(true)
     {
         vector<RequestQueuePtr> queues;
@@ -521,7 +605,20 @@ Glacier2::RequestQueueThread::run()
             //
             while(!_destroy && (_queues.empty() || _sleep))
             {
-                if(_sleep)
+                if(!_sleep && !_delayedQueues.empty())
+                {
+                    //
+                    // Wait for the first queue delayed by its rate
+                    // limit, unless another queue is flushed first.
+                    //
+                    IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+                    if(_delayedQueues.begin()->first > now)
+                    {
+                        timedWait(_delayedQueues.begin()->first - now);
+                    }
+                    flushDelayedQueues();
+                }
+                else if(_sleep)
                 {
                     IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
                     if(!timedWait(_sleepDuration))
@@ -550,11 +647,23 @@ Glacier2::RequestQueueThread::run()
             //
             if(_destroy && _queues.empty())
             {
-                return;
+                //
+                // The queues delayed by their rate limit can't be flushed
+                // anymore, their requests are failed once the mutex is
+                // released.
+                //
+                for(multimap<IceUtil::Time, RequestQueuePtr>::const_iterator p = _delayedQueues.begin();
+                    p != _delayedQueues.end(); ++p)
+                {
+                    delayedQueues.push_back(p->second);
+                }
+                _delayedQueues.clear();
+                break;
             }
 
             assert(!_queues.empty() && !_sleep);
 
+            flushDelayedQueues();
             queues.swap(_queues);
 
             if(_sleepTime > IceUtil::Time())
@@ -566,8 +675,44 @@ Glacier2::RequestQueueThread::run()
 
         for(vector<RequestQueuePtr>::const_iterator p = queues.begin(); p != queues.end(); ++p)
         {
-            (*p)->flushRequests();
+            //
+            // A queue which still has requests to forward, because of
+            // its weight or rate limit, is flushed again after the
+            // other queues or once its rate limit allows it.
+            //
+            IceUtil::Time delay;
+            if((*p)->flushRequests(delay))
+            {
+                IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
+                if(delay > IceUtil::Time())
+                {
+                    _delayedQueues.insert(make_pair(IceUtil::Time::now(IceUtil::Time::Monotonic) + delay, *p));
+                }
+                else
+                {
+                    _queues.push_back(*p);
+                }
+            }
         }
     }
+
+    for(vector<RequestQueuePtr>::const_iterator p = delayedQueues.begin(); p != delayedQueues.end(); ++p)
+    {
+        (*p)->abortRequests();
+    }
+}
+
+void
+Glacier2::RequestQueueThread::flushDelayedQueues()
+{
+    //
+    // Must be called with the mutex locked.
+    //
+    IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    while(!_delayedQueues.empty() && _delayedQueues.begin()->first <= now)
+    {
+        _queues.push_back(_delayedQueues.begin()->second);
+        _delayedQueues.erase(_delayedQueues.begin());
+    }
 }
 
@@ -17,6 +17,7 @@
 #include <Glacier2/Instrumentation.h>
 
 #include <deque>
+#include <map>
 
 namespace Glacier2
 {
@@ -62,12 +63,13 @@ class RequestQueue : public IceUtil::Mutex, public IceUtil::Shared
 {
 public:
 
-    RequestQueue(const RequestQueueThreadPtr&, const InstancePtr&, const Ice::ConnectionPtr&);
+    RequestQueue(const RequestQueueThreadPtr&, const InstancePtr&, const Ice::ConnectionPtr&, int, int, int, int);
 
     bool addRequest(const RequestPtr&);
-    void flushRequests();
+    bool flushRequests(IceUtil::Time&);
 
     void destroy();
+    void abortRequests();
 
     void updateObserver(const Glacier2::Instrumentation::SessionObserverPtr&);
 
@@ -87,6 +89,21 @@ private:
     const Ice::Callback_Object_ice_invokePtr _callback;
     const Ice::Callback_Connection_flushBatchRequestsPtr _flushCallback;
 
+    //
+    // Client request queues forward at most _weight requests each
+    // time they are flushed (0 means no limit) and are limited to
+    // _rateLimit requests per second with bursts of up to _burst
+    // requests (0 means no limit). New requests are rejected while
+    // _maxQueued requests wait to be forwarded (0 means no limit).
+    //
+    const int _rateLimit;
+    const int _burst;
+    const int _weight;
+    const int _maxQueued;
+    double _tokens;
+    IceUtil::Time _refillTime;
+    std::deque<RequestPtr>::size_type _throttled;
+
     std::deque<RequestPtr> _requests;
     std::set<Ice::ObjectPrx> _batchProxies;
     bool _pendingSend;
@@ -111,11 +128,14 @@ public:
 
 private:
 
+    void flushDelayedQueues();
+
     const IceUtil::Time _sleepTime;
     bool _destroy;
     bool _sleep;
     IceUtil::Time _sleepDuration;
     std::vector<RequestQueuePtr> _queues;
+    std::multimap<IceUtil::Time, RequestQueuePtr> _delayedQueues;
 };
 
 }
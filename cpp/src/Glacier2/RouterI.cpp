@@ -18,12 +18,12 @@ using namespace std;
 using namespace Ice;
 using namespace Glacier2;
 
-Glacier2::RouterI::RouterI(const InstancePtr& instance, const ConnectionPtr& connection, const string& userId, 
-                           const SessionPrx& session, const Identity& controlId, const FilterManagerPtr& filters,
-                           const Ice::Context& context) :
+Glacier2::RouterI::RouterI(const InstancePtr& instance, const ConnectionPtr& connection, const string& userId,
+                           const string& category, const SessionPrx& session, const Identity& controlId,
+                           const FilterManagerPtr& filters, const Ice::Context& context) :
     _instance(instance),
     _routingTable(new RoutingTable(_instance->communicator(), _instance->proxyVerifier())),
-    _clientBlobject(new ClientBlobject(_instance, filters, context, _routingTable)),
+    _clientBlobject(new ClientBlobject(_instance, filters, context, _routingTable, category)),
     _clientBlobjectBuffered(_instance->clientRequestQueueThread()),
     _serverBlobjectBuffered(_instance->serverRequestQueueThread()),
     _connection(connection),
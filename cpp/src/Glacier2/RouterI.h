@@ -31,8 +31,8 @@ class RouterI : public Router
 {
 public:
 
-    RouterI(const InstancePtr&, const Ice::ConnectionPtr&, const std::string&, const SessionPrx&, const Ice::Identity&,
-            const FilterManagerPtr&, const Ice::Context&);
+    RouterI(const InstancePtr&, const Ice::ConnectionPtr&, const std::string&, const std::string&, const SessionPrx&,
+            const Ice::Identity&, const FilterManagerPtr&, const Ice::Context&);
 
     virtual ~RouterI();
 
@@ -14,7 +14,7 @@ using namespace Ice;
 using namespace Glacier2;
 
 Glacier2::ServerBlobject::ServerBlobject(const InstancePtr& instance, const ConnectionPtr& connection) :
-    Glacier2::Blobject(instance, connection, Ice::Context())
+    Glacier2::Blobject(instance, connection, Ice::Context(), "")
 {
 }
 
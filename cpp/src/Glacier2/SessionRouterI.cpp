@@ -226,7 +226,7 @@ public:
 
     UserPasswordCreateSession(const AMD_Router_createSessionPtr& amdCB, const string& user, const string& password,
                               const Ice::Current& current, const SessionRouterIPtr& sessionRouter) :
-        CreateSession(sessionRouter, user, current),
+        CreateSession(sessionRouter, user, "Password", current),
         _amdCB(amdCB),
         _password(password)
     {
@@ -315,7 +315,7 @@ public:
 
     SSLCreateSession(const AMD_Router_createSessionFromSecureConnectionPtr& amdCB, const string& user,
                      const SSLInfo& sslInfo, const Ice::Current& current, const SessionRouterIPtr& sessionRouter) :
-        CreateSession(sessionRouter, user, current),
+        CreateSession(sessionRouter, user, "SSL", current),
         _amdCB(amdCB),
         _sslInfo(sslInfo)
     {
@@ -448,10 +448,12 @@ private:
 
 }
 
-CreateSession::CreateSession(const SessionRouterIPtr& sessionRouter, const string& user, const Ice::Current& current) :
+CreateSession::CreateSession(const SessionRouterIPtr& sessionRouter, const string& user, const string& category,
+                             const Ice::Current& current) :
     _instance(sessionRouter->_instance),
     _sessionRouter(sessionRouter),
     _user(user),
+    _category(category),
     _current(current)
 {
     if(_instance->properties()->getPropertyAsInt("Glacier2.AddConnectionContext") > 0)
@@ -578,11 +580,12 @@ CreateSession::sessionCreated(const SessionPrx& session)
 
         if(_instance->properties()->getPropertyAsInt("Glacier2.AddConnectionContext") == 1)
         {
-            router = new RouterI(_instance, _current.con, _user, session, ident, _filterManager, _context);
+            router = new RouterI(_instance, _current.con, _user, _category, session, ident, _filterManager, _context);
         }
         else
         {
-            router = new RouterI(_instance, _current.con, _user, session, ident, _filterManager, Ice::Context());
+            router = new RouterI(_instance, _current.con, _user, _category, session, ident, _filterManager,
+                                 Ice::Context());
         }
     }
     catch(const Ice::Exception& ex)
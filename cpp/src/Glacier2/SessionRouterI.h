@@ -50,7 +50,7 @@ class CreateSession : public IceUtil::Shared
 {
 public:
 
-    CreateSession(const SessionRouterIPtr&, const std::string&, const Ice::Current&);
+    CreateSession(const SessionRouterIPtr&, const std::string&, const std::string&, const Ice::Current&);
 
     void create();
     void addPendingCallback(const CreateSessionPtr&);
@@ -76,6 +76,7 @@ protected:
     const InstancePtr _instance;
     const SessionRouterIPtr _sessionRouter;
     const std::string _user;
+    const std::string _category;
     const Ice::Current _current;
     Ice::Context _context;
     std::vector<CreateSessionPtr> _pendingCallbacks;
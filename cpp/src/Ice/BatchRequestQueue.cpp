@@ -112,6 +112,8 @@ BatchRequestQueue::finishBatchRequest(OutputStream* os, const Ice::ObjectPrxPtr&
 
     try
     {
+        _batchStream.copyFile(); // The next batch request is written after this one.
+
         _batchStreamCanFlush = true; // Allow flush to proceed even if the stream is marked in use.
 
         if(_maxSize > 0 && _batchStream.b.size() >= _maxSize)
@@ -163,6 +165,7 @@ BatchRequestQueue::abortBatchRequest(OutputStream* os)
     if(_batchStreamInUse)
     {
         _batchStream.swap(*os);
+        _batchStream.clear(); // Closes the file range of the aborted request, if any.
         _batchStream.resize(_batchMarker);
         _batchStreamInUse = false;
         notifyAll();
@@ -221,6 +224,13 @@ BatchRequestQueue::isEmpty()
     return _batchStream.b.size() == sizeof(requestBatchHdr);
 }
 
+size_t
+BatchRequestQueue::memoryUsage()
+{
+    Lock sync(*this);
+    return sizeof(*this) + _batchStream.b.capacity();
+}
+
 void
 BatchRequestQueue::waitStreamInUse(bool flush)
 {
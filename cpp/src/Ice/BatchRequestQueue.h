@@ -37,6 +37,7 @@ public:
 
     void destroy(const Ice::LocalException&);
     bool isEmpty();
+    size_t memoryUsage();
 
     void enqueueBatchRequest();
 
@@ -172,7 +172,8 @@ CollocatedRequestHandler::invokeAsyncRequest(OutgoingAsyncBase* outAsync, int ba
     if(!synchronous || !_response || _reference->getInvocationTimeout() > 0)
     {
         // Don't invoke from the user thread if async or invocation timeout is set
-        _adapter->getThreadPool()->dispatch(new InvokeAllAsync(ICE_GET_SHARED_FROM_THIS(outAsync),
+        _reference->getInstance()->dispatch(_adapter->getThreadPool(),
+                                            new InvokeAllAsync(ICE_GET_SHARED_FROM_THIS(outAsync),
                                                                outAsync->getOs(),
                                                                ICE_SHARED_FROM_THIS,
                                                                requestId,
@@ -211,6 +212,8 @@ CollocatedRequestHandler::sendResponse(Int requestId, OutputStream* os, Byte, bo
         Lock sync(*this);
         assert(_response);
 
+        os->copyFile(); // The reply is read from the buffer.
+
         if(_traceLevels->protocol >= 1)
         {
             fillInValue(os, 10, static_cast<Int>(os->b.size()));
@@ -311,6 +314,17 @@ CollocatedRequestHandler::sentAsync(OutgoingAsyncBase* outAsync)
 void
 CollocatedRequestHandler::invokeAll(OutputStream* os, Int requestId, Int batchRequestNum)
 {
+    try
+    {
+        os->copyFile(); // The request is read from the buffer.
+    }
+    catch(const LocalException& ex)
+    {
+        handleException(requestId, ex, false);
+        _adapter->decDirectCount();
+        return;
+    }
+
     if(_traceLevels->protocol >= 1)
     {
         fillInValue(os, 10, static_cast<Int>(os->b.size()));
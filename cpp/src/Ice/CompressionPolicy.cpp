@@ -0,0 +1,203 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/CompressionPolicy.h>
+#include <Ice/TraceLevels.h>
+#include <Ice/LoggerUtil.h>
+#include <Ice/Properties.h>
+#include <Ice/Protocol.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+IceUtil::Shared* IceInternal::upCast(CompressionPolicy* p) { return p; }
+
+namespace
+{
+
+//
+// The number of messages after which a message of an operation and
+// size class which is no longer compressed is compressed again to
+// sample its compression ratio.
+//
+const unsigned int probeInterval = 64;
+
+//
+// The maximum number of operations and size classes for which the
+// compression ratio is sampled. Messages of other operations share
+// the statistics of the unnamed operation.
+//
+const size_t maxStats = 1024;
+
+bool
+readSize(const Byte*& p, const Byte* end, Int& sz)
+{
+    if(p == end)
+    {
+        return false;
+    }
+    Byte b = *p++;
+    if(b != 255)
+    {
+        sz = static_cast<Int>(b);
+        return true;
+    }
+    if(end - p < static_cast<ptrdiff_t>(sizeof(Int)))
+    {
+        return false;
+    }
+#ifdef ICE_BIG_ENDIAN
+    reverse_copy(p, p + sizeof(Int), reinterpret_cast<Byte*>(&sz));
+#else
+    copy(p, p + sizeof(Int), reinterpret_cast<Byte*>(&sz));
+#endif
+    p += sizeof(Int);
+    return sz >= 0;
+}
+
+bool
+skipString(const Byte*& p, const Byte* end)
+{
+    Int sz;
+    if(!readSize(p, end, sz) || end - p < sz)
+    {
+        return false;
+    }
+    p += sz;
+    return true;
+}
+
+//
+// Returns the operation name of a request message, or an empty string
+// for other messages.
+//
+string
+getOperation(const OutputStream& stream)
+{
+    if(stream.b.size() <= static_cast<size_t>(headerSize + sizeof(Int)) || stream.b[8] != requestMsg)
+    {
+        return string();
+    }
+
+    const Byte* p = stream.b.begin() + headerSize + sizeof(Int); // Skip the header and the request ID.
+    const Byte* end = stream.b.end();
+    if(!skipString(p, end) || !skipString(p, end)) // Identity name and category.
+    {
+        return string();
+    }
+
+    Int facets;
+    if(!readSize(p, end, facets) || facets > 1 || (facets == 1 && !skipString(p, end)))
+    {
+        return string();
+    }
+
+    Int sz;
+    if(!readSize(p, end, sz) || end - p < sz)
+    {
+        return string();
+    }
+    return string(reinterpret_cast<const char*>(p), sz);
+}
+
+int
+getSizeClass(size_t size)
+{
+    int sizeClass = 0;
+    for(size_t sz = size >> 10; sz > 0 && sizeClass < 8; sz >>= 2)
+    {
+        ++sizeClass;
+    }
+    return sizeClass;
+}
+
+}
+
+IceInternal::CompressionPolicy::CompressionPolicy(const PropertiesPtr& properties,
+                                                  const TraceLevelsPtr& traceLevels,
+                                                  const LoggerPtr& logger) :
+    _adaptive(properties->getPropertyAsInt("Ice.Compression.Adaptive") > 0 ||
+              properties->getPropertyAsInt("Ice.Compression.Auto") > 0),
+    _auto(properties->getPropertyAsInt("Ice.Compression.Auto") > 0),
+    _maxRatio(properties->getPropertyAsIntWithDefault("Ice.Compression.MaxRatio", 90)),
+    _traceLevels(traceLevels),
+    _logger(logger)
+{
+}
+
+bool
+IceInternal::CompressionPolicy::select(const OutputStream& stream, bool requested, bool queued, Stats*& stats)
+{
+    if(!requested && !(_auto && queued))
+    {
+        return false;
+    }
+
+    pair<string, int> key(getOperation(stream), getSizeClass(stream.b.size()));
+
+    IceUtil::Mutex::Lock sync(_mutex);
+    map<pair<string, int>, Stats>::iterator p = _stats.find(key);
+    if(p == _stats.end())
+    {
+        if(_stats.size() >= maxStats)
+        {
+            key.first = string();
+        }
+        p = _stats.insert(make_pair(key, Stats())).first;
+        p->second.operation = key.first;
+        p->second.sizeClass = key.second;
+    }
+
+    Stats& s = p->second;
+    ++s.count;
+    if(s.compress || s.count % probeInterval == 0)
+    {
+        stats = &s;
+        return true;
+    }
+    return false;
+}
+
+void
+IceInternal::CompressionPolicy::sample(Stats* stats, size_t uncompressedSize, size_t compressedSize)
+{
+    if(!stats || uncompressedSize == 0)
+    {
+        return;
+    }
+
+    int ratio = static_cast<int>(compressedSize * 100 / uncompressedSize);
+
+    IceUtil::Mutex::Lock sync(_mutex);
+    stats->ratio = stats->ratio < 0 ? ratio : (stats->ratio * 7 + ratio) / 8;
+
+    bool compress = stats->ratio <= _maxRatio;
+    if(compress != stats->compress)
+    {
+        stats->compress = compress;
+        if(_traceLevels->protocol >= 1)
+        {
+            Trace out(_logger, _traceLevels->protocolCat);
+            out << (compress ? "enabling" : "disabling") << " compression for ";
+            if(stats->operation.empty())
+            {
+                out << "messages";
+            }
+            else
+            {
+                out << "operation `" << stats->operation << "'";
+            }
+            out << " of size class " << stats->sizeClass;
+            out << "\ncompression ratio = " << stats->ratio << "%";
+        }
+    }
+}
@@ -0,0 +1,92 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef ICE_COMPRESSION_POLICY_H
+#define ICE_COMPRESSION_POLICY_H
+
+#include <IceUtil/Shared.h>
+#include <IceUtil/Mutex.h>
+#include <Ice/CompressionPolicyF.h>
+#include <Ice/TraceLevelsF.h>
+#include <Ice/PropertiesF.h>
+#include <Ice/LoggerF.h>
+#include <Ice/OutputStream.h>
+
+#include <map>
+
+namespace IceInternal
+{
+
+//
+// The compression policy decides which messages are compressed by the
+// connections of a communicator. With Ice.Compression.Adaptive, the
+// compression ratio of the messages is sampled by operation and size
+// class, and messages whose recent ratio exceeds Ice.Compression.MaxRatio
+// are no longer compressed, except for a periodic probe which samples
+// the ratio again. With Ice.Compression.Auto, messages sent on a
+// connection which is waiting for the socket to be writable are also
+// compressed if the ratio of their operation and size class is good,
+// even if compression wasn't requested by the proxy. This only applies
+// to connections whose peer sent a message with a compression status,
+// other peers might not support compression.
+//
+class CompressionPolicy : public IceUtil::Shared
+{
+public:
+
+    struct Stats
+    {
+        Stats() : sizeClass(0), ratio(-1), count(0), compress(true)
+        {
+        }
+
+        std::string operation;
+        int sizeClass;
+        int ratio; // Moving average of the compressed size in percent, -1 if not sampled yet.
+        unsigned int count;
+        bool compress;
+    };
+
+    CompressionPolicy(const Ice::PropertiesPtr&, const TraceLevelsPtr&, const Ice::LoggerPtr&);
+
+    //
+    // Returns whether or not the given message should be compressed.
+    // If it returns true, stats is set to the statistics to pass to
+    // sample once the message is compressed, or to 0 if the policy
+    // isn't adaptive.
+    //
+    bool compress(const Ice::OutputStream& stream, bool requested, bool queued, Stats*& stats)
+    {
+        stats = 0;
+        if(!_adaptive)
+        {
+            return requested;
+        }
+        return select(stream, requested, queued, stats);
+    }
+
+    void sample(Stats*, size_t, size_t);
+
+private:
+
+    bool select(const Ice::OutputStream&, bool, bool, Stats*&);
+
+    const bool _adaptive;
+    const bool _auto;
+    const int _maxRatio;
+    const TraceLevelsPtr _traceLevels;
+    const Ice::LoggerPtr _logger;
+
+    IceUtil::Mutex _mutex;
+    std::map<std::pair<std::string, int>, Stats> _stats;
+};
+
+}
+
+#endif
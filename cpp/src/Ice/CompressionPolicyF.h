@@ -0,0 +1,24 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef ICE_COMPRESSION_POLICY_F_H
+#define ICE_COMPRESSION_POLICY_F_H
+
+#include <Ice/Handle.h>
+
+namespace IceInternal
+{
+
+class CompressionPolicy;
+IceUtil::Shared* upCast(CompressionPolicy*);
+typedef Handle<CompressionPolicy> CompressionPolicyPtr;
+
+}
+
+#endif
@@ -60,6 +60,18 @@ struct RandomNumberGenerator : public std::unary_function<ptrdiff_t, ptrdiff_t>
     }
 };
 
+//
+// The latency statistics of an endpoint which wasn't used for this
+// long are ignored, the endpoint is then measured again.
+//
+const IceUtil::Time latencyStatisticsTimeout = IceUtil::Time::seconds(10);
+
+//
+// The circuit breaker of an endpoint which didn't fail and wasn't
+// probed for this long is removed.
+//
+const IceUtil::Time circuitBreakerIdleTimeout = IceUtil::Time::seconds(60);
+
 #ifdef ICE_CPP11_MAPPING
 template <typename Map> void
 remove(Map& m, const typename Map::key_type& k, const typename Map::mapped_type& v)
@@ -206,6 +218,7 @@ IceInternal::OutgoingConnectionFactory::waitUntilFinished()
 void
 IceInternal::OutgoingConnectionFactory::create(const vector<EndpointIPtr>& endpts, bool hasMore,
                                                Ice::EndpointSelectionType selType,
+                                               bool latencySelection,
                                                const CreateConnectionCallbackPtr& callback)
 {
     assert(!endpts.empty());
@@ -220,8 +233,21 @@ IceInternal::OutgoingConnectionFactory::create(const vector<EndpointIPtr>& endpt
     //
     try
     {
+        //
+        // With the Latency endpoint selection type, only a connection
+        // to the selected endpoint is used, the other endpoints are
+        // only used if it can't be established.
+        //
         bool compress;
-        Ice::ConnectionIPtr connection = findConnection(endpoints, compress);
+        Ice::ConnectionIPtr connection;
+        if(latencySelection)
+        {
+            connection = findConnection(vector<EndpointIPtr>(endpoints.begin(), endpoints.begin() + 1), compress);
+        }
+        else
+        {
+            connection = findConnection(endpoints, compress);
+        }
         if(connection)
         {
             callback->setConnection(connection, compress);
@@ -351,7 +377,11 @@ IceInternal::OutgoingConnectionFactory::OutgoingConnectionFactory(const Communic
     _instance(instance),
     _monitor(new FactoryACMMonitor(instance, instance->clientACM())),
     _destroyed(false),
-    _pendingConnectCount(0)
+    _pendingConnectCount(0),
+    _circuitBreakerThreshold(
+        instance->initializationData().properties->getPropertyAsInt("Ice.CircuitBreaker.Threshold")),
+    _circuitBreakerTimeout(IceUtil::Time::seconds(
+        instance->initializationData().properties->getPropertyAsIntWithDefault("Ice.CircuitBreaker.Timeout", 5)))
 {
 }
 
@@ -364,6 +394,177 @@ IceInternal::OutgoingConnectionFactory::~OutgoingConnectionFactory()
     assert(_pendingConnectCount == 0);
 }
 
+vector<EndpointIPtr>
+IceInternal::OutgoingConnectionFactory::filterBrokenEndpoints(const vector<EndpointIPtr>& endpts)
+{
+    if(_circuitBreakerThreshold <= 0)
+    {
+        return endpts;
+    }
+
+    IceUtil::Mutex::Lock sync(_circuitBreakersMutex);
+    if(_circuitBreakers.empty())
+    {
+        return endpts;
+    }
+
+    //
+    // The circuit breakers are keyed by the endpoints used to
+    // establish the connections, which have the overrides applied.
+    //
+    vector<EndpointIPtr> endpoints = applyOverrides(endpts);
+    vector<EndpointIPtr> available;
+    IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    for(vector<EndpointIPtr>::size_type i = 0; i < endpoints.size(); ++i)
+    {
+#ifdef ICE_CPP11_MAPPING
+        map<EndpointIPtr, CircuitBreaker, Ice::TargetCompare<EndpointIPtr, std::less>>::iterator p =
+            _circuitBreakers.find(endpoints[i]);
+#else
+        map<EndpointIPtr, CircuitBreaker>::iterator p = _circuitBreakers.find(endpoints[i]);
+#endif
+        if(p == _circuitBreakers.end() || p->second.failures < _circuitBreakerThreshold)
+        {
+            available.push_back(endpts[i]);
+        }
+        else if(p->second.retryTime <= now)
+        {
+            //
+            // The circuit is half-open, the endpoint is returned once
+            // to probe it.
+            //
+            p->second.retryTime = now + _circuitBreakerTimeout;
+            p->second.lastUpdate = now;
+            available.push_back(endpts[i]);
+        }
+    }
+    return available.empty() ? endpts : available;
+}
+
+vector<EndpointIPtr>
+IceInternal::OutgoingConnectionFactory::sortByLatency(const vector<EndpointIPtr>& endpts)
+{
+    if(endpts.size() < 2)
+    {
+        return endpts;
+    }
+
+    //
+    // Like the circuit breakers, the statistics are keyed by the
+    // endpoints used to establish the connections.
+    //
+    vector<EndpointIPtr> endpoints = applyOverrides(endpts);
+    vector<pair<double, size_t> > scores;
+    IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    for(vector<EndpointIPtr>::size_type i = 0; i < endpoints.size(); ++i)
+    {
+        double score = 0;
+        {
+            LatencyShard& shard = latencyShard(endpoints[i]);
+            IceUtil::Mutex::Lock sync(shard.mutex);
+#ifdef ICE_CPP11_MAPPING
+            map<EndpointIPtr, EndpointLatency, Ice::TargetCompare<EndpointIPtr, std::less>>::const_iterator p =
+                shard.latencies.find(endpoints[i]);
+#else
+            map<EndpointIPtr, EndpointLatency>::const_iterator p = shard.latencies.find(endpoints[i]);
+#endif
+            if(p != shard.latencies.end() && now - p->second.lastSample < latencyStatisticsTimeout)
+            {
+                //
+                // A failure rate of 100% weighs like one second of
+                // round-trip time.
+                //
+                score = p->second.rtt * (1 + 4 * p->second.errors) + p->second.errors * 1000000;
+            }
+        }
+
+        //
+        // Endpoints without recent statistics have the best score,
+        // so that they're measured.
+        //
+        scores.push_back(make_pair(score, i));
+    }
+
+    //
+    // Power of two choices: the best of two endpoints picked at random
+    // is used. The other endpoints follow by increasing score, they're
+    // only used if the connection establishment fails.
+    //
+    const int sz = static_cast<int>(scores.size());
+    int first = IceUtilInternal::random(sz);
+    int second = IceUtilInternal::random(sz - 1);
+    if(second >= first)
+    {
+        ++second;
+    }
+    swap(scores[0], scores[scores[second].first < scores[first].first ? second : first]);
+    stable_sort(scores.begin() + 1, scores.end());
+
+    vector<EndpointIPtr> sorted;
+    sorted.reserve(endpts.size());
+    for(vector<pair<double, size_t> >::const_iterator p = scores.begin(); p != scores.end(); ++p)
+    {
+        sorted.push_back(endpts[p->second]);
+    }
+    return sorted;
+}
+
+bool
+IceInternal::OutgoingConnectionFactory::invocationCompleted(const EndpointIPtr& endpoint, const IceUtil::Time& rtt,
+                                                            bool failed)
+{
+    LatencyShard& shard = latencyShard(endpoint);
+    IceUtil::Mutex::Lock sync(shard.mutex);
+    IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+
+    //
+    // Remove the statistics of the endpoints which weren't used
+    // recently, they're ignored and measured again anyway.
+    //
+    if(now - shard.pruneTime >= latencyStatisticsTimeout)
+    {
+#ifdef ICE_CPP11_MAPPING
+        map<EndpointIPtr, EndpointLatency, Ice::TargetCompare<EndpointIPtr, std::less>>::iterator p =
+            shard.latencies.begin();
+#else
+        map<EndpointIPtr, EndpointLatency>::iterator p = shard.latencies.begin();
+#endif
+        while(p != shard.latencies.end())
+        {
+            if(now - p->second.lastSample >= latencyStatisticsTimeout)
+            {
+                shard.latencies.erase(p++);
+            }
+            else
+            {
+                ++p;
+            }
+        }
+        shard.pruneTime = now;
+    }
+
+    EndpointLatency& latency = shard.latencies[endpoint];
+    if(!failed)
+    {
+        double sample = static_cast<double>(rtt.toMicroSeconds());
+        latency.rtt = latency.rtt == 0 ? sample : latency.rtt + (sample - latency.rtt) / 8;
+    }
+    latency.errors += ((failed ? 1.0 : 0.0) - latency.errors) / 8;
+    latency.lastSample = now;
+
+    //
+    // The invocations periodically select their connection again, so
+    // that a proxy with several endpoints moves to a faster endpoint.
+    //
+    return ++latency.samples % 32 == 0;
+}
+
+IceInternal::OutgoingConnectionFactory::LatencyShard&
+IceInternal::OutgoingConnectionFactory::latencyShard(const EndpointIPtr& endpoint)
+{
+    return _latencyShards[static_cast<unsigned int>(endpoint->hash()) % latencyShardCount];
+}
+
 vector<EndpointIPtr>
 IceInternal::OutgoingConnectionFactory::applyOverrides(const vector<EndpointIPtr>& endpts)
 {
@@ -839,6 +1040,85 @@ IceInternal::OutgoingConnectionFactory::handleConnectionException(const LocalExc
     }
 }
 
+void
+IceInternal::OutgoingConnectionFactory::endpointSucceeded(const EndpointIPtr& endpoint)
+{
+    if(_circuitBreakerThreshold <= 0)
+    {
+        return;
+    }
+
+    IceUtil::Mutex::Lock sync(_circuitBreakersMutex);
+#ifdef ICE_CPP11_MAPPING
+    map<EndpointIPtr, CircuitBreaker, Ice::TargetCompare<EndpointIPtr, std::less>>::iterator p =
+        _circuitBreakers.find(endpoint);
+#else
+    map<EndpointIPtr, CircuitBreaker>::iterator p = _circuitBreakers.find(endpoint);
+#endif
+    if(p == _circuitBreakers.end())
+    {
+        return;
+    }
+
+    if(p->second.failures >= _circuitBreakerThreshold && _instance->traceLevels()->network >= 1)
+    {
+        Trace out(_instance->initializationData().logger, _instance->traceLevels()->networkCat);
+        out << "closed circuit breaker of endpoint `" << endpoint->toString() << "'";
+    }
+    _circuitBreakers.erase(p);
+}
+
+void
+IceInternal::OutgoingConnectionFactory::endpointFailed(const EndpointIPtr& endpoint, const LocalException& ex)
+{
+    if(_circuitBreakerThreshold <= 0 || dynamic_cast<const CommunicatorDestroyedException*>(&ex))
+    {
+        return;
+    }
+
+    IceUtil::Mutex::Lock sync(_circuitBreakersMutex);
+    IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+
+    //
+    // Remove the circuit breakers of the endpoints which are no longer
+    // used, this is done at most once per idle timeout period.
+    //
+    if(now - _circuitBreakersPruneTime >= circuitBreakerIdleTimeout)
+    {
+#ifdef ICE_CPP11_MAPPING
+        map<EndpointIPtr, CircuitBreaker, Ice::TargetCompare<EndpointIPtr, std::less>>::iterator p =
+            _circuitBreakers.begin();
+#else
+        map<EndpointIPtr, CircuitBreaker>::iterator p = _circuitBreakers.begin();
+#endif
+        while(p != _circuitBreakers.end())
+        {
+            if(now - p->second.lastUpdate >= circuitBreakerIdleTimeout)
+            {
+                _circuitBreakers.erase(p++);
+            }
+            else
+            {
+                ++p;
+            }
+        }
+        _circuitBreakersPruneTime = now;
+    }
+
+    CircuitBreaker& breaker = _circuitBreakers[endpoint];
+    breaker.lastUpdate = now;
+    if(++breaker.failures >= _circuitBreakerThreshold)
+    {
+        breaker.retryTime = now + _circuitBreakerTimeout;
+        if(breaker.failures == _circuitBreakerThreshold && _instance->traceLevels()->network >= 1)
+        {
+            Trace out(_instance->initializationData().logger, _instance->traceLevels()->networkCat);
+            out << "opened circuit breaker of endpoint `" << endpoint->toString() << "' after "
+                << breaker.failures << " connection failures\n" << ex;
+        }
+    }
+}
+
 IceInternal::OutgoingConnectionFactory::ConnectCallback::ConnectCallback(const InstancePtr& instance,
                                                                          const OutgoingConnectionFactoryPtr& factory,
                                                                          const vector<EndpointIPtr>& endpoints,
@@ -867,6 +1147,7 @@ IceInternal::OutgoingConnectionFactory::ConnectCallback::connectionStartComplete
     }
 
     connection->activate();
+    _factory->endpointSucceeded(_iter->endpoint);
     _factory->finishGetConnection(_connectors, *_iter, connection, ICE_SHARED_FROM_THIS);
 }
 
@@ -913,6 +1194,7 @@ void
 IceInternal::OutgoingConnectionFactory::ConnectCallback::exception(const Ice::LocalException& ex)
 {
     _factory->handleException(ex, _hasMore || _endpointsIter != _endpoints.end() - 1);
+    _factory->endpointFailed(*_endpointsIter, ex);
     if(++_endpointsIter != _endpoints.end())
     {
         nextEndpoint();
@@ -1112,6 +1394,7 @@ IceInternal::OutgoingConnectionFactory::ConnectCallback::connectionStartFailedIm
     }
 
     _factory->handleConnectionException(ex, _hasMore || _iter != _connectors.end() - 1);
+    _factory->endpointFailed(_iter->endpoint, ex);
     if(dynamic_cast<const Ice::CommunicatorDestroyedException*>(&ex)) // No need to continue.
     {
         _factory->finishGetConnection(_connectors, ex, ICE_SHARED_FROM_THIS);
@@ -63,11 +63,31 @@ public:
 
     void waitUntilFinished();
 
-    void create(const std::vector<EndpointIPtr>&, bool, Ice::EndpointSelectionType, const CreateConnectionCallbackPtr&);
+    void create(const std::vector<EndpointIPtr>&, bool, Ice::EndpointSelectionType, bool,
+                const CreateConnectionCallbackPtr&);
     void setRouterInfo(const RouterInfoPtr&);
     void removeAdapter(const Ice::ObjectAdapterPtr&);
     void flushAsyncBatchRequests(const CommunicatorFlushBatchAsyncPtr&);
 
+    //
+    // Returns the given endpoints without the endpoints whose circuit
+    // breaker is open, or all the endpoints if they are all broken.
+    //
+    std::vector<EndpointIPtr> filterBrokenEndpoints(const std::vector<EndpointIPtr>&);
+
+    //
+    // Returns the given endpoints in the order used by the Latency
+    // endpoint selection type.
+    //
+    std::vector<EndpointIPtr> sortByLatency(const std::vector<EndpointIPtr>&);
+
+    //
+    // Updates the latency statistics of an endpoint with the round-trip
+    // time of a twoway invocation, or with its failure. Returns true if
+    // the invocation should select the connection of its proxy again.
+    //
+    bool invocationCompleted(const EndpointIPtr&, const IceUtil::Time&, bool);
+
     OutgoingConnectionFactory(const Ice::CommunicatorPtr&, const InstancePtr&);
     virtual ~OutgoingConnectionFactory();
     friend class Instance;
@@ -155,6 +175,9 @@ private:
     void handleException(const Ice::LocalException&, bool);
     void handleConnectionException(const Ice::LocalException&, bool);
 
+    void endpointSucceeded(const EndpointIPtr&);
+    void endpointFailed(const EndpointIPtr&, const Ice::LocalException&);
+
     Ice::CommunicatorPtr _communicator;
     const InstancePtr _instance;
     const FactoryACMMonitorPtr _monitor;
@@ -169,6 +192,73 @@ private:
     std::multimap<EndpointIPtr, Ice::ConnectionIPtr> _connectionsByEndpoint;
 #endif
     int _pendingConnectCount;
+
+    //
+    // The circuit breaker of an endpoint opens once the number of
+    // consecutive connection failures reaches the threshold. The
+    // endpoint is then skipped until the retry time, where a single
+    // connection attempt probes it and either closes the circuit or
+    // opens it again. The circuit breakers of the endpoints which
+    // aren't used anymore are removed after a period of inactivity.
+    //
+    struct CircuitBreaker
+    {
+        CircuitBreaker() : failures(0)
+        {
+        }
+
+        int failures;
+        IceUtil::Time retryTime;
+        IceUtil::Time lastUpdate;
+    };
+
+    const int _circuitBreakerThreshold;
+    const IceUtil::Time _circuitBreakerTimeout;
+    IceUtil::Mutex _circuitBreakersMutex;
+#ifdef ICE_CPP11_MAPPING
+    std::map<EndpointIPtr, CircuitBreaker, Ice::TargetCompare<EndpointIPtr, std::less>> _circuitBreakers;
+#else
+    std::map<EndpointIPtr, CircuitBreaker> _circuitBreakers;
+#endif
+    IceUtil::Time _circuitBreakersPruneTime;
+
+    //
+    // The latency statistics of an endpoint are moving averages of the
+    // round-trip time and of the failure rate of the invocations which
+    // use the Latency endpoint selection type.
+    //
+    struct EndpointLatency
+    {
+        EndpointLatency() : rtt(0), errors(0), samples(0)
+        {
+        }
+
+        double rtt; // In microseconds, 0 if no invocation succeeded.
+        double errors; // Between 0 and 1.
+        int samples;
+        IceUtil::Time lastSample;
+    };
+
+    //
+    // The statistics are sharded by endpoint hash, so that concurrent
+    // invocations on different endpoints don't contend on the same
+    // lock. The statistics which weren't updated recently are removed.
+    //
+    struct LatencyShard
+    {
+        IceUtil::Mutex mutex;
+#ifdef ICE_CPP11_MAPPING
+        std::map<EndpointIPtr, EndpointLatency, Ice::TargetCompare<EndpointIPtr, std::less>> latencies;
+#else
+        std::map<EndpointIPtr, EndpointLatency> latencies;
+#endif
+        IceUtil::Time pruneTime;
+    };
+
+    LatencyShard& latencyShard(const EndpointIPtr&);
+
+    static const size_t latencyShardCount = 16;
+    LatencyShard _latencyShards[latencyShardCount];
 };
 
 class IncomingConnectionFactory : public EventHandler,
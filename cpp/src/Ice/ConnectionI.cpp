@@ -27,6 +27,7 @@
 #include <Ice/ReferenceFactory.h> // For createProxy().
 #include <Ice/ProxyFactory.h> // For createProxy().
 #include <Ice/BatchRequestQueue.h>
+#include <Ice/CompressionPolicy.h>
 
 #ifdef ICE_HAS_BZIP2
 #  include <bzlib.h>
@@ -46,6 +47,12 @@ namespace
 
 const ::std::string __flushBatchRequests_name = "flushBatchRequests";
 
+//
+// The maximum size of the write buffer in which queued replies are
+// gathered, see ConnectionI::coalesceMessages().
+//
+const size_t coalesceSizeMax = 64 * 1024;
+
 class TimeoutCallback : public IceUtil::TimerTask
 {
 public:
@@ -589,8 +596,8 @@ Ice::ConnectionI::monitor(const IceUtil::Time& now, const ACMConfig& acm)
             //
             setState(StateClosed, ConnectionTimeoutException(__FILE__, __LINE__));
         }
-        else if(acm.close != CloseOnInvocation && _dispatchCount == 0 && _batchRequestQueue->isEmpty() &&
-                _asyncRequests.empty())
+        else if(acm.close != CloseOnInvocation && _dispatchCount == 0 &&
+                (!_batchRequestQueue || _batchRequestQueue->isEmpty()) && _asyncRequests.empty())
         {
             //
             // The connection is idle, close it.
@@ -601,7 +608,8 @@ Ice::ConnectionI::monitor(const IceUtil::Time& now, const ACMConfig& acm)
 }
 
 AsyncStatus
-Ice::ConnectionI::sendAsyncRequest(const OutgoingAsyncBasePtr& out, bool compress, bool response, int batchRequestNum)
+Ice::ConnectionI::sendAsyncRequest(const OutgoingAsyncBasePtr& out, bool compress, bool response, int batchRequestNum,
+                                   int priority)
 {
     OutputStream* os = out->getOs();
 
@@ -667,7 +675,7 @@ Ice::ConnectionI::sendAsyncRequest(const OutgoingAsyncBasePtr& out, bool compres
     AsyncStatus status = AsyncStatusQueued;
     try
     {
-        OutgoingMessage message(out, os, compress, requestId);
+        OutgoingMessage message(out, os, compress, requestId, priority);
         status = sendMessage(message);
     }
     catch(const LocalException& ex)
@@ -688,9 +696,190 @@ Ice::ConnectionI::sendAsyncRequest(const OutgoingAsyncBasePtr& out, bool compres
     return status;
 }
 
+void
+Ice::ConnectionI::readReply(OutgoingAsyncBase* outAsync)
+{
+#if defined(ICE_USE_EPOLL) || defined(ICE_USE_KQUEUE) || defined(ICE_USE_POLL)
+    if(!_callerRuns)
+    {
+        return;
+    }
+
+    bool done = false;
+    vector<OutgoingAsyncBasePtr> replies;
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+
+        //
+        // The calling thread only reads from the connection if its
+        // request is the only one waiting for a reply and if the
+        // thread pool isn't reading a message.
+        //
+        if(_state != StateActive || _callerReading || _asyncRequests.size() != 1 ||
+           _asyncRequests.begin()->second.get() != outAsync || !_readHeader ||
+           _readStream.i != _readStream.b.begin())
+        {
+            return;
+        }
+        const Int requestId = _asyncRequests.begin()->first;
+
+        //
+        // Stop the thread pool from reading the connection while this
+        // thread reads it, message() ignores the read readiness until
+        // _callerReading is reset.
+        //
+        _callerReading = true;
+        _threadPool->unregister(ICE_SHARED_FROM_THIS, SocketOperationRead);
+
+        InputStream stream(_instance.get(), Ice::currentProtocolEncoding);
+        const SOCKET fd = _transceiver->getNativeInfo()->fd();
+        while(true)
+        {
+            //
+            // Wait for the socket to be readable. The wait is bounded
+            // to notice the cancelation of the request or the closure
+            // of the connection by another thread.
+            //
+            sync.release();
+            struct pollfd pollFd;
+            pollFd.fd = fd;
+            pollFd.events = POLLIN;
+            pollFd.revents = 0;
+            int ret = ::poll(&pollFd, 1, 10);
+            sync.acquire();
+
+            if(_state != StateActive)
+            {
+                break;
+            }
+            map<Int, OutgoingAsyncBasePtr>::const_iterator p = _asyncRequests.find(requestId);
+            if(p == _asyncRequests.end() || p->second.get() != outAsync)
+            {
+                break; // Canceled.
+            }
+            if(ret <= 0)
+            {
+                continue; // Timeout or interrupted, errors are reported by the read.
+            }
+
+            try
+            {
+                if(readMessage(stream) & SocketOperationRead)
+                {
+                    if(!_readHeader || _readStream.i != _readStream.b.begin())
+                    {
+                        break; // The rest of the message is read by the thread pool.
+                    }
+                    continue;
+                }
+
+                //
+                // Only replies and heartbeats are parsed by this thread,
+                // other messages are handed to the thread pool.
+                //
+                const Byte messageType = _readStream.b[8];
+                if(messageType != replyMsg && (messageType != validateConnectionMsg || _heartbeatCallback))
+                {
+                    _callerHandoff = true;
+                    break;
+                }
+
+                Int invokeNum = 0;
+                Int replyId = 0;
+                Byte compress = 0;
+                ServantManagerPtr servantManager;
+                ObjectAdapterPtr adapter;
+                OutgoingAsyncBasePtr reply;
+                ICE_HEARTBEAT_CALLBACK heartbeatCallback;
+                int dispatchCount = 0;
+                parseMessage(stream, invokeNum, replyId, compress, servantManager, adapter, reply, heartbeatCallback,
+                             dispatchCount);
+
+                if(_acmLastActivity != IceUtil::Time())
+                {
+                    _acmLastActivity = IceUtil::Time::now(IceUtil::Time::Monotonic);
+                }
+
+                if(reply && reply.get() != outAsync)
+                {
+                    replies.push_back(reply);
+                }
+                else if(reply)
+                {
+                    done = true;
+                }
+
+                if(_asyncRequests.find(requestId) == _asyncRequests.end())
+                {
+                    break; // The reply was received.
+                }
+            }
+            catch(const LocalException& ex)
+            {
+                setState(StateClosed, ex);
+                break;
+            }
+        }
+
+        _callerReading = false;
+        if(_state < StateClosed)
+        {
+            if(_state != StateHolding)
+            {
+                _threadPool->_register(ICE_SHARED_FROM_THIS, SocketOperationRead);
+            }
+            if(_callerHandoff)
+            {
+                _threadPool->ready(ICE_SHARED_FROM_THIS, SocketOperationRead, true);
+            }
+            else if(!_readHeader)
+            {
+                scheduleTimeout(SocketOperationRead);
+            }
+        }
+        notifyAll(); // Notify the thread waiting to close the transceiver in finish().
+    }
+
+    //
+    // The replies of other requests are dispatched to the thread pool
+    // like the replies read by the thread pool.
+    //
+    for(vector<OutgoingAsyncBasePtr>::const_iterator p = replies.begin(); p != replies.end(); ++p)
+    {
+        try
+        {
+            (*p)->invokeResponseAsync();
+        }
+        catch(const CommunicatorDestroyedException&)
+        {
+        }
+    }
+
+    if(done)
+    {
+        outAsync->invokeResponse();
+    }
+#else
+    (void)outAsync;
+#endif
+}
+
 BatchRequestQueuePtr
-Ice::ConnectionI::getBatchRequestQueue() const
+Ice::ConnectionI::getBatchRequestQueue(bool create) const
 {
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+    if(!_batchRequestQueue && create)
+    {
+        //
+        // Most connections are never used for batch requests, the
+        // queue and its stream are only allocated when needed.
+        //
+        _batchRequestQueue = new BatchRequestQueue(_instance, _endpoint->datagram());
+        if(_state >= StateClosed)
+        {
+            _batchRequestQueue->destroy(*_exception);
+        }
+    }
     return _batchRequestQueue;
 }
 
@@ -842,9 +1031,9 @@ Ice::ConnectionI::setCloseCallback(ICE_IN(ICE_CLOSE_CALLBACK) callback)
                 const ICE_CLOSE_CALLBACK _callback;
             };
 #ifdef ICE_CPP11_MAPPING
-            _threadPool->dispatch(new CallbackWorkItem(ICE_SHARED_FROM_THIS, move(callback)));
+            _instance->dispatch(_threadPool, new CallbackWorkItem(ICE_SHARED_FROM_THIS, move(callback)));
 #else
-            _threadPool->dispatch(new CallbackWorkItem(ICE_SHARED_FROM_THIS, callback));
+            _instance->dispatch(_threadPool, new CallbackWorkItem(ICE_SHARED_FROM_THIS, callback));
 #endif
         }
     }
@@ -933,7 +1122,7 @@ Ice::ConnectionI::asyncRequestCanceled(const OutgoingAsyncBasePtr& outAsync, con
         return; // The request has already been or will be shortly notified of the failure.
     }
 
-    for(deque<OutgoingMessage>::iterator o = _sendStreams.begin(); o != _sendStreams.end(); ++o)
+    for(list<OutgoingMessage>::iterator o = _sendStreams.begin(); o != _sendStreams.end(); ++o)
     {
         if(o->outAsync.get() == outAsync.get())
         {
@@ -1327,6 +1516,21 @@ Ice::ConnectionI::message(ThreadPoolCurrent& current)
         }
 
         SocketOperation readyOp = current.operation;
+#if defined(ICE_USE_EPOLL) || defined(ICE_USE_KQUEUE) || defined(ICE_USE_POLL)
+        if(_callerReading)
+        {
+            //
+            // The connection is read by a thread waiting for the reply
+            // of a synchronous invocation, see readReply.
+            //
+            _threadPool->unregister(ICE_SHARED_FROM_THIS, SocketOperationRead);
+            readyOp = static_cast<SocketOperation>(readyOp & ~SocketOperationRead);
+            if(!readyOp)
+            {
+                return;
+            }
+        }
+#endif
         try
         {
             unscheduleTimeout(current.operation);
@@ -1346,88 +1550,19 @@ Ice::ConnectionI::message(ThreadPoolCurrent& current)
                 }
             }
 
-            while(readyOp & SocketOperationRead)
+            if(readyOp & SocketOperationRead)
             {
-                if(_observer && !_readHeader)
-                {
-                    _observer.startRead(_readStream);
-                }
-
-                readOp = read(_readStream);
-                if(readOp & SocketOperationRead)
-                {
-                    break;
-                }
-                if(_observer && !_readHeader)
+#if defined(ICE_USE_EPOLL) || defined(ICE_USE_KQUEUE) || defined(ICE_USE_POLL)
+                if(_callerHandoff)
                 {
-                    assert(_readStream.i == _readStream.b.end());
-                    _observer.finishRead(_readStream);
-                }
-
-                if(_readHeader) // Read header if necessary.
-                {
-                    _readHeader = false;
-
-                    if(_observer)
-                    {
-                        _observer->receivedBytes(static_cast<int>(headerSize));
-                    }
-
-                    ptrdiff_t pos = _readStream.i - _readStream.b.begin();
-                    if(pos < headerSize)
-                    {
-                        //
-                        // This situation is possible for small UDP packets.
-                        //
-                        throw IllegalMessageSizeException(__FILE__, __LINE__);
-                    }
-
-                    _readStream.i = _readStream.b.begin();
-                    const Byte* m;
-                    _readStream.readBlob(m, static_cast<Int>(sizeof(magic)));
-                    if(m[0] != magic[0] || m[1] != magic[1] || m[2] != magic[2] || m[3] != magic[3])
-                    {
-                        BadMagicException ex(__FILE__, __LINE__);
-                        ex.badMagic = Ice::ByteSeq(&m[0], &m[0] + sizeof(magic));
-                        throw ex;
-                    }
-                    ProtocolVersion pv;
-                    _readStream.read(pv);
-                    checkSupportedProtocol(pv);
-                    EncodingVersion ev;
-                    _readStream.read(ev);
-                    checkSupportedProtocolEncoding(ev);
-
-                    Byte messageType;
-                    _readStream.read(messageType);
-                    Byte compress;
-                    _readStream.read(compress);
-                    Int size;
-                    _readStream.read(size);
-                    if(size < headerSize)
-                    {
-                        throw IllegalMessageSizeException(__FILE__, __LINE__);
-                    }
-                    if(size > static_cast<Int>(_messageSizeMax))
-                    {
-                        Ex::throwMemoryLimitException(__FILE__, __LINE__, size, _messageSizeMax);
-                    }
-                    if(size > static_cast<Int>(_readStream.b.size()))
-                    {
-                        _readStream.b.resize(size);
-                    }
-                    _readStream.i = _readStream.b.begin() + pos;
-                }
-
-                if(_readStream.i != _readStream.b.end())
-                {
-                    if(_endpoint->datagram())
-                    {
-                        throw DatagramLimitException(__FILE__, __LINE__); // The message was truncated.
-                    }
-                    continue;
+                    //
+                    // The message was read by readReply.
+                    //
+                    _callerHandoff = false;
+                    _threadPool->ready(ICE_SHARED_FROM_THIS, SocketOperationRead, false);
                 }
-                break;
+#endif
+                readOp = readMessage(current.stream);
             }
 
             SocketOperation newOp = static_cast<SocketOperation>(readOp | writeOp);
@@ -1767,6 +1902,19 @@ Ice::ConnectionI::finish(bool close)
 
     if(close)
     {
+#if defined(ICE_USE_EPOLL) || defined(ICE_USE_KQUEUE) || defined(ICE_USE_POLL)
+        {
+            //
+            // Wait for the thread reading a reply to stop using the
+            // socket, see readReply.
+            //
+            IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+            while(_callerReading)
+            {
+                wait();
+            }
+        }
+#endif
         try
         {
             _transceiver->close();
@@ -1823,7 +1971,7 @@ Ice::ConnectionI::finish(bool close)
         }
 
 
-        for(deque<OutgoingMessage>::iterator o = _sendStreams.begin(); o != _sendStreams.end(); ++o)
+        for(list<OutgoingMessage>::iterator o = _sendStreams.begin(); o != _sendStreams.end(); ++o)
         {
             o->completed(*_exception);
             if(o->requestId) // Make sure finished isn't called twice.
@@ -1978,15 +2126,19 @@ Ice::ConnectionI::ConnectionI(const CommunicatorPtr& communicator,
     _nextRequestId(1),
     _asyncRequestsHint(_asyncRequests.end()),
     _messageSizeMax(adapter ? adapter->messageSizeMax() : _instance->messageSizeMax()),
-    _batchRequestQueue(new BatchRequestQueue(instance, endpoint->datagram())),
     _readStream(_instance.get(), Ice::currentProtocolEncoding),
     _readHeader(false),
+    _callerRuns(false),
+    _callerReading(false),
+    _callerHandoff(false),
     _writeStream(_instance.get(), Ice::currentProtocolEncoding),
+    _writeFileSent(0),
     _dispatchCount(0),
     _state(StateNotInitialized),
     _shutdownInitiated(false),
     _initialized(false),
-    _validated(false)
+    _validated(false),
+    _peerCompress(false)
 {
     const Ice::PropertiesPtr& properties = _instance->initializationData().properties;
 
@@ -2032,6 +2184,12 @@ Ice::ConnectionI::create(const CommunicatorPtr& communicator,
         const_cast<ThreadPoolPtr&>(conn->_threadPool) = conn->_instance->clientThreadPool();
     }
     conn->_threadPool->initialize(conn);
+
+    //
+    // The replies of synchronous invocations are only read by the
+    // calling thread on TCP connections.
+    //
+    const_cast<bool&>(conn->_callerRuns) = conn->_threadPool->callerRuns() && conn->_type == "tcp";
     return conn;
 }
 
@@ -2192,7 +2350,10 @@ Ice::ConnectionI::setState(State state)
                     return;
                 }
 
-                _batchRequestQueue->destroy(*_exception);
+                if(_batchRequestQueue)
+                {
+                    _batchRequestQueue->destroy(*_exception);
+                }
 
                 //
                 // Don't need to close now for connections so only close the transceiver
@@ -2493,7 +2654,11 @@ Ice::ConnectionI::validate(SocketOperation operation)
     _writeStream.resize(0);
     _writeStream.i = _writeStream.b.begin();
 
+#if defined(ICE_USE_IOCP) || defined(ICE_OS_WINRT)
     _readStream.resize(headerSize);
+#else
+    _readStream.resize(0); // The buffer is allocated when a message is received, see message().
+#endif
     _readStream.i = _readStream.b.begin();
     _readHeader = true;
 
@@ -2574,8 +2739,21 @@ Ice::ConnectionI::sendNextMessage(vector<OutgoingMessage>& callbacks)
             //
             message = &_sendStreams.front();
             assert(!message->stream->i);
+            if(message->stream->fileLength() > 0)
+            {
+                prepareFile(*message->stream, message->compress);
+            }
 #ifdef ICE_HAS_BZIP2
-            if(message->compress && message->stream->b.size() >= 100) // Only compress messages > 100 bytes.
+            //
+            // Only compress messages > 100 bytes. The message was
+            // queued, the connection is waiting for the socket to be
+            // writable. Messages which weren't requested to be
+            // compressed are only compressed if the peer supports
+            // compression.
+            //
+            CompressionPolicy::Stats* stats;
+            if(message->stream->b.size() >= 100 && message->stream->fileLength() == 0 &&
+               _instance->compressionPolicy()->compress(*message->stream, message->compress, _peerCompress, stats))
             {
                 //
                 // Message compressed. Request compressed response, if any.
@@ -2587,6 +2765,7 @@ Ice::ConnectionI::sendNextMessage(vector<OutgoingMessage>& callbacks)
                 //
                 OutputStream stream(_instance.get(), Ice::currentProtocolEncoding);
                 doCompress(*message->stream, stream);
+                _instance->compressionPolicy()->sample(stats, message->stream->b.size(), stream.b.size());
 
                 traceSend(*message->stream, _logger, _traceLevels);
 
@@ -2607,7 +2786,7 @@ Ice::ConnectionI::sendNextMessage(vector<OutgoingMessage>& callbacks)
                 //
                 // No compression, just fill in the message size.
                 //
-                Int sz = static_cast<Int>(message->stream->b.size());
+                Int sz = static_cast<Int>(message->stream->b.size() + message->stream->fileLength());
                 const Byte* p = reinterpret_cast<const Byte*>(&sz);
 #ifdef ICE_BIG_ENDIAN
                 reverse_copy(p, p + sizeof(Int), message->stream->b.begin() + 10);
@@ -2620,6 +2799,10 @@ Ice::ConnectionI::sendNextMessage(vector<OutgoingMessage>& callbacks)
 #ifdef ICE_HAS_BZIP2
             }
 #endif
+            if(!message->outAsync && !_endpoint->datagram() && message->stream->fileLength() == 0)
+            {
+                coalesceMessages(*message->stream);
+            }
             _writeStream.swap(*message->stream);
 
             //
@@ -2674,8 +2857,20 @@ Ice::ConnectionI::sendMessage(OutgoingMessage& message)
 
     if(!_sendStreams.empty())
     {
-        _sendStreams.push_back(message);
-        _sendStreams.back().adopt(0);
+        //
+        // The message is queued after the message being sent and the
+        // queued messages with the same or a higher priority. A message
+        // being sent can't be interrupted since the protocol doesn't
+        // support interleaving messages.
+        //
+        list<OutgoingMessage>::iterator p = _sendStreams.begin();
+        ++p;
+        while(p != _sendStreams.end() && p->priority >= message.priority)
+        {
+            ++p;
+        }
+        p = _sendStreams.insert(p, message);
+        p->adopt(0);
         return AsyncStatusQueued;
     }
 
@@ -2684,10 +2879,17 @@ Ice::ConnectionI::sendMessage(OutgoingMessage& message)
     // the connection with the selector thread.
     //
 
+    if(message.stream->fileLength() > 0)
+    {
+        prepareFile(*message.stream, message.compress);
+    }
     message.stream->i = message.stream->b.begin();
     SocketOperation op;
 #ifdef ICE_HAS_BZIP2
-    if(message.compress && message.stream->b.size() >= 100) // Only compress messages larger than 100 bytes.
+    CompressionPolicy::Stats* stats;
+    if(message.stream->b.size() >= 100 && // Only compress messages larger than 100 bytes.
+       message.stream->fileLength() == 0 && // Messages with a file range sent after the buffer aren't compressed.
+       _instance->compressionPolicy()->compress(*message.stream, message.compress, false, stats))
     {
         //
         // Message compressed. Request compressed response, if any.
@@ -2699,6 +2901,7 @@ Ice::ConnectionI::sendMessage(OutgoingMessage& message)
         //
         OutputStream stream(_instance.get(), Ice::currentProtocolEncoding);
         doCompress(*message.stream, stream);
+        _instance->compressionPolicy()->sample(stats, message.stream->b.size(), stream.b.size());
         stream.i = stream.b.begin();
 
         traceSend(*message.stream, _logger, _traceLevels);
@@ -2747,7 +2950,7 @@ Ice::ConnectionI::sendMessage(OutgoingMessage& message)
         //
         // No compression, just fill in the message size.
         //
-        Int sz = static_cast<Int>(message.stream->b.size());
+        Int sz = static_cast<Int>(message.stream->b.size() + message.stream->fileLength());
         const Byte* p = reinterpret_cast<const Byte*>(&sz);
 #ifdef ICE_BIG_ENDIAN
         reverse_copy(p, p + sizeof(Int), message.stream->b.begin() + 10);
@@ -2796,6 +2999,74 @@ Ice::ConnectionI::sendMessage(OutgoingMessage& message)
     return AsyncStatusQueued;
 }
 
+//
+// Gathers the replies and other connection messages queued after the
+// given message into its stream. Replies produced while the connection
+// is waiting for the socket to be writable are then sent with a single
+// write instead of one write (and one TCP segment) per reply. Requests
+// are never gathered since their stream is returned to the invocation
+// once sent, and neither are messages which need to be compressed.
+//
+void
+Ice::ConnectionI::coalesceMessages(OutputStream& stream)
+{
+    assert(!_sendStreams.empty() && _sendStreams.front().stream == &stream && _sendStreams.front().adopted);
+
+    list<OutgoingMessage>::iterator p = _sendStreams.begin();
+    ++p;
+    while(p != _sendStreams.end() && !p->outAsync && stream.b.size() + p->stream->b.size() <= coalesceSizeMax)
+    {
+        if(p->stream->fileLength() > 0)
+        {
+            break;
+        }
+#ifdef ICE_HAS_BZIP2
+        if(p->compress && p->stream->b.size() >= 100)
+        {
+            break;
+        }
+#endif
+        if(p->compress)
+        {
+            p->stream->b[9] = 1; // Not compressed, request compressed response, if any.
+        }
+
+        Int sz = static_cast<Int>(p->stream->b.size());
+        const Byte* q = reinterpret_cast<const Byte*>(&sz);
+#ifdef ICE_BIG_ENDIAN
+        reverse_copy(q, q + sizeof(Int), p->stream->b.begin() + 10);
+#else
+        copy(q, q + sizeof(Int), p->stream->b.begin() + 10);
+#endif
+        traceSend(*p->stream, _logger, _traceLevels);
+
+        stream.writeBlob(p->stream->b.begin(), p->stream->b.size());
+
+        p->sent(); // Releases the adopted stream.
+        p = _sendStreams.erase(p);
+    }
+    stream.i = stream.b.begin();
+}
+
+//
+// The file range of a message (see FileBytes) is sent after its
+// buffer, directly from the file, if the transceiver supports it.
+// Otherwise, or if the message might be compressed or is traced, the
+// file is read into the buffer.
+//
+void
+Ice::ConnectionI::prepareFile(OutputStream& stream, bool compress)
+{
+    if(compress || _traceLevels->protocol >= 1 || !_transceiver->canWriteFile())
+    {
+        stream.copyFile();
+    }
+    else if(static_cast<Long>(stream.b.size()) + stream.fileLength() > static_cast<Long>(0x7fffffff))
+    {
+        throw MemoryLimitException(__FILE__, __LINE__);
+    }
+}
+
 #ifdef ICE_HAS_BZIP2
 static string
 getBZ2Error(int bzError)
@@ -2957,7 +3228,24 @@ Ice::ConnectionI::parseMessage(InputStream& stream, Int& invokeNum, Int& request
     assert(_state > StateNotValidated && _state < StateClosed);
 
     _readStream.swap(stream);
+    if(_readStream.instance() != _instance.get())
+    {
+        //
+        // The thread's stream belongs to a thread pool shared with
+        // other communicators, keep the instance of this connection
+        // for the next messages.
+        //
+        _readStream.initialize(_instance.get(), Ice::currentProtocolEncoding);
+    }
+#if defined(ICE_USE_IOCP) || defined(ICE_OS_WINRT)
     _readStream.resize(headerSize);
+#else
+    //
+    // Release the read buffer, the next message is read with the
+    // buffer of the thread's stream (see message()).
+    //
+    _readStream.resize(0);
+#endif
     _readStream.i = _readStream.b.begin();
     _readHeader = true;
 
@@ -2983,6 +3271,10 @@ Ice::ConnectionI::parseMessage(InputStream& stream, Int& invokeNum, Int& request
         Byte messageType;
         stream.read(messageType);
         stream.read(compress);
+        if(compress > 0)
+        {
+            _peerCompress = true;
+        }
 
         if(compress == 2)
         {
@@ -3330,12 +3622,145 @@ Ice::ConnectionI::initConnectionInfo() const
     return _info;
 }
 
+//
+// Returns the memory held by the connection: the connection object,
+// its read and write buffers, the batch request queue and the queued
+// messages. This doesn't account for the memory of the transceiver
+// and of the observer. Must be called with the connection locked.
+//
+size_t
+Ice::ConnectionI::memoryUsage() const
+{
+    size_t size = sizeof(*this) + _readStream.b.capacity() + _writeStream.b.capacity();
+    if(_batchRequestQueue)
+    {
+        size += _batchRequestQueue->memoryUsage();
+    }
+    for(list<OutgoingMessage>::const_iterator p = _sendStreams.begin(); p != _sendStreams.end(); ++p)
+    {
+        //
+        // The stream of a queued request is owned by the invocation
+        // but it's kept alive until the request is sent.
+        //
+        size += sizeof(OutgoingMessage) + p->stream->b.capacity();
+        if(p->adopted)
+        {
+            size += sizeof(OutputStream);
+        }
+    }
+    size += _asyncRequests.size() * sizeof(map<Int, OutgoingAsyncBasePtr>::value_type);
+    return size;
+}
+
 ConnectionState
 ConnectionI::toConnectionState(State state) const
 {
     return connectionStateMap[static_cast<int>(state)];
 }
 
+SocketOperation
+ConnectionI::readMessage(InputStream& stream)
+{
+    while(true)
+    {
+#if !defined(ICE_USE_IOCP) && !defined(ICE_OS_WINRT)
+        if(_readHeader && _readStream.b.empty())
+        {
+            //
+            // Idle connections don't hold a read buffer. The
+            // buffer of the thread's stream is borrowed to read
+            // the next message, it's given back to the thread
+            // with the message once the message is parsed.
+            //
+            _readStream.swapBuffer(stream);
+            _readStream.b.resize(headerSize);
+            _readStream.i = _readStream.b.begin();
+        }
+#endif
+
+        if(_observer && !_readHeader)
+        {
+            _observer.startRead(_readStream);
+        }
+
+        SocketOperation readOp = read(_readStream);
+        if(readOp & SocketOperationRead)
+        {
+            return readOp;
+        }
+        if(_observer && !_readHeader)
+        {
+            assert(_readStream.i == _readStream.b.end());
+            _observer.finishRead(_readStream);
+        }
+
+        if(_readHeader) // Read header if necessary.
+        {
+            _readHeader = false;
+
+            if(_observer)
+            {
+                _observer->receivedBytes(static_cast<int>(headerSize));
+            }
+
+            ptrdiff_t pos = _readStream.i - _readStream.b.begin();
+            if(pos < headerSize)
+            {
+                //
+                // This situation is possible for small UDP packets.
+                //
+                throw IllegalMessageSizeException(__FILE__, __LINE__);
+            }
+
+            _readStream.i = _readStream.b.begin();
+            const Byte* m;
+            _readStream.readBlob(m, static_cast<Int>(sizeof(magic)));
+            if(m[0] != magic[0] || m[1] != magic[1] || m[2] != magic[2] || m[3] != magic[3])
+            {
+                BadMagicException ex(__FILE__, __LINE__);
+                ex.badMagic = Ice::ByteSeq(&m[0], &m[0] + sizeof(magic));
+                throw ex;
+            }
+            ProtocolVersion pv;
+            _readStream.read(pv);
+            checkSupportedProtocol(pv);
+            EncodingVersion ev;
+            _readStream.read(ev);
+            checkSupportedProtocolEncoding(ev);
+
+            Byte messageType;
+            _readStream.read(messageType);
+            Byte compress;
+            _readStream.read(compress);
+            Int size;
+            _readStream.read(size);
+            if(size < headerSize)
+            {
+                throw IllegalMessageSizeException(__FILE__, __LINE__);
+            }
+            if(size > static_cast<Int>(_messageSizeMax))
+            {
+                Ex::throwMemoryLimitException(__FILE__, __LINE__, size, _messageSizeMax);
+            }
+            if(size > static_cast<Int>(_readStream.b.size()))
+            {
+                _readStream.b.resize(size);
+            }
+            _readStream.i = _readStream.b.begin() + pos;
+        }
+
+        if(_readStream.i != _readStream.b.end())
+        {
+            if(_endpoint->datagram())
+            {
+                throw DatagramLimitException(__FILE__, __LINE__); // The message was truncated.
+            }
+            continue;
+        }
+        return SocketOperationNone;
+    }
+}
+
 SocketOperation
 ConnectionI::read(Buffer& buf)
 {
@@ -3354,13 +3779,19 @@ ConnectionI::read(Buffer& buf)
             out << (buf.i - start) << " of " << (buf.b.end() - start);
         }
         out << " bytes via " << _endpoint->protocol() << "\n" << toString();
+        out << "\nmemory usage = " << memoryUsage() << " bytes";
     }
     return op;
 }
 
 SocketOperation
-ConnectionI::write(Buffer& buf)
+ConnectionI::write(OutputStream& buf)
 {
+    if(buf.i == buf.b.begin())
+    {
+        _writeFileSent = 0; // Start of a new message.
+    }
+
     Buffer::Container::iterator start = buf.i;
     SocketOperation op = _transceiver->write(buf);
     if(_instance->traceLevels()->network >= 3 && buf.i != start)
@@ -3372,6 +3803,34 @@ ConnectionI::write(Buffer& buf)
             out << " of " << (buf.b.end() - start);
         }
         out << " bytes via " << _endpoint->protocol() << "\n" << toString();
+        out << "\nmemory usage = " << memoryUsage() << " bytes";
+    }
+
+    //
+    // Once the buffer is sent, send the file range of the message.
+    //
+    if(!op && _writeFileSent < buf.fileLength())
+    {
+        size_t length = static_cast<size_t>(buf.fileLength() - _writeFileSent);
+        size_t sent = _transceiver->writeFile(buf.fileDescriptor(), buf.fileOffset() + _writeFileSent, length);
+        _writeFileSent += static_cast<Long>(sent);
+        if(sent > 0)
+        {
+            if(_observer)
+            {
+                _observer->sentBytes(static_cast<int>(sent));
+            }
+            if(_instance->traceLevels()->network >= 3)
+            {
+                Trace out(_instance->initializationData().logger, _instance->traceLevels()->networkCat);
+                out << "sent " << sent << " of " << length << " file bytes via " << _endpoint->protocol() << "\n"
+                    << toString();
+            }
+        }
+        if(sent < length)
+        {
+            op = SocketOperationWrite;
+        }
     }
     return op;
 }
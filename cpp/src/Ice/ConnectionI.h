@@ -42,6 +42,7 @@
 #include <Ice/InputStream.h>
 
 #include <deque>
+#include <list>
 
 #if !defined(ICE_OS_WINRT)
 #    ifndef ICE_HAS_BZIP2
@@ -93,7 +94,7 @@ public:
     struct OutgoingMessage
     {
         OutgoingMessage(Ice::OutputStream* str, bool comp) :
-            stream(str), compress(comp), requestId(0), adopted(false)
+            stream(str), compress(comp), requestId(0), priority(0), adopted(false)
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_WINRT)
             , isSent(false), invokeSent(false), receivedReply(false)
 #endif
@@ -101,8 +102,8 @@ public:
         }
 
         OutgoingMessage(const IceInternal::OutgoingAsyncBasePtr& o, Ice::OutputStream* str,
-                        bool comp, int rid) :
-            stream(str), outAsync(o), compress(comp), requestId(rid), adopted(false)
+                        bool comp, int rid, int prio) :
+            stream(str), outAsync(o), compress(comp), requestId(rid), priority(prio), adopted(false)
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_WINRT)
             , isSent(false), invokeSent(false), receivedReply(false)
 #endif
@@ -118,6 +119,7 @@ public:
         IceInternal::OutgoingAsyncBasePtr outAsync;
         bool compress;
         int requestId;
+        int priority;
         bool adopted;
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_WINRT)
         bool isSent;
@@ -171,9 +173,17 @@ public:
 
     void monitor(const IceUtil::Time&, const IceInternal::ACMConfig&);
 
-    IceInternal::AsyncStatus sendAsyncRequest(const IceInternal::OutgoingAsyncBasePtr&, bool, bool, int);
+    IceInternal::AsyncStatus sendAsyncRequest(const IceInternal::OutgoingAsyncBasePtr&, bool, bool, int, int = 0);
 
-    IceInternal::BatchRequestQueuePtr getBatchRequestQueue() const;
+    //
+    // Reads the reply of a synchronous invocation from the calling
+    // thread, if <threadpool>.CallerRuns is set and the connection
+    // isn't waiting for other replies. The reply is otherwise read by
+    // the thread pool.
+    //
+    void readReply(IceInternal::OutgoingAsyncBase*);
+
+    IceInternal::BatchRequestQueuePtr getBatchRequestQueue(bool = true) const;
 
     virtual void flushBatchRequests();
 
@@ -282,6 +292,8 @@ private:
     bool validate(IceInternal::SocketOperation = IceInternal::SocketOperationNone);
     IceInternal::SocketOperation sendNextMessage(std::vector<OutgoingMessage>&);
     IceInternal::AsyncStatus sendMessage(OutgoingMessage&);
+    void coalesceMessages(Ice::OutputStream&);
+    void prepareFile(Ice::OutputStream&, bool);
 
 #ifdef ICE_HAS_BZIP2
     void doCompress(Ice::OutputStream&, Ice::OutputStream&);
@@ -299,10 +311,12 @@ private:
     void unscheduleTimeout(IceInternal::SocketOperation status);
 
     Ice::ConnectionInfoPtr initConnectionInfo() const;
+    size_t memoryUsage() const;
     Ice::Instrumentation::ConnectionState toConnectionState(State) const;
 
+    IceInternal::SocketOperation readMessage(Ice::InputStream&);
     IceInternal::SocketOperation read(IceInternal::Buffer&);
-    IceInternal::SocketOperation write(IceInternal::Buffer&);
+    IceInternal::SocketOperation write(Ice::OutputStream&);
 
     void reap();
 
@@ -352,13 +366,17 @@ private:
     IceUtil::UniquePtr<LocalException> _exception;
 
     const size_t _messageSizeMax;
-    IceInternal::BatchRequestQueuePtr _batchRequestQueue;
+    mutable IceInternal::BatchRequestQueuePtr _batchRequestQueue; // Created on first use.
 
-    std::deque<OutgoingMessage> _sendStreams;
+    std::list<OutgoingMessage> _sendStreams;
 
     Ice::InputStream _readStream;
     bool _readHeader;
+    const bool _callerRuns; // True if the replies of synchronous invocations can be read by the calling thread.
+    bool _callerReading; // True while the calling thread of a synchronous invocation reads the connection.
+    bool _callerHandoff; // True if a message read by the calling thread is left to the thread pool.
     Ice::OutputStream _writeStream;
+    Ice::Long _writeFileSent; // The number of bytes of the file range of _writeStream already sent.
 
     Observer _observer;
 
@@ -368,6 +386,7 @@ private:
     bool _shutdownInitiated;
     bool _initialized;
     bool _validated;
+    bool _peerCompress; // True once the peer sent a message with a compression status, it supports compression.
 
     ICE_CLOSE_CALLBACK _closeCallback;
     ICE_HEARTBEAT_CALLBACK _heartbeatCallback;
@@ -110,6 +110,7 @@ IceInternal::DefaultsAndOverrides::DefaultsAndOverrides(const PropertiesPtr& pro
         properties->getPropertyAsIntWithDefault("Ice.Default.CollocationOptimized", 1) > 0;
 
     value = properties->getPropertyWithDefault("Ice.Default.EndpointSelection", "Random");
+    defaultLatencySelection = false;
     if(value == "Random")
     {
         defaultEndpointSelection = Random;
@@ -118,10 +119,15 @@ IceInternal::DefaultsAndOverrides::DefaultsAndOverrides(const PropertiesPtr& pro
     {
         defaultEndpointSelection = Ordered;
     }
+    else if(value == "Latency")
+    {
+        defaultEndpointSelection = Random;
+        defaultLatencySelection = true;
+    }
     else
     {
         EndpointSelectionTypeParseException ex(__FILE__, __LINE__);
-        ex.str = "illegal value `" + value + "'; expected `Random' or `Ordered'";
+        ex.str = "illegal value `" + value + "'; expected `Random', `Ordered' or `Latency'";
         throw ex;
     }
 
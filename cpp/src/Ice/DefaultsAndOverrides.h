@@ -33,6 +33,7 @@ public:
     std::string defaultProtocol;
     bool defaultCollocationOptimization;
     Ice::EndpointSelectionType defaultEndpointSelection;
+    bool defaultLatencySelection; // The C++ only Latency endpoint selection type, see RoutableReference.
     int defaultTimeout;
     int defaultInvocationTimeout;
     int defaultLocatorCacheTimeout;
@@ -15,38 +15,12 @@
 #include <Ice/LoggerUtil.h>
 #include <Ice/HashUtil.h>
 #include <Ice/NetworkProxy.h>
-#include <IceUtil/MutexPtrLock.h>
 
 using namespace std;
 using namespace Ice;
 using namespace Ice::Instrumentation;
 using namespace IceInternal;
 
-namespace
-{
-
-IceUtil::Mutex* hashMutex = 0;
-
-class Init
-{
-public:
-
-    Init()
-    {
-        hashMutex = new IceUtil::Mutex;
-    }
-
-    ~Init()
-    {
-        delete hashMutex;
-        hashMutex = 0;
-    }
-};
-
-Init init;
-
-}
-
 #ifndef ICE_CPP11_MAPPING
 IceUtil::Shared* IceInternal::upCast(IPEndpointI* p) { return p; }
 #endif
@@ -170,15 +144,18 @@ IceInternal::IPEndpointI::equivalent(const EndpointIPtr& endpoint) const
 Ice::Int
 IceInternal::IPEndpointI::hash() const
 {
-    IceUtilInternal::MutexPtrLock<IceUtil::Mutex> lock(hashMutex);
-    if(!_hashInitialized)
+    //
+    // See Reference::hash(), the hash is published with atomics.
+    //
+    if(!_hashInitialized.load())
     {
-        _hashValue = 5381;
-        hashAdd(_hashValue, type());
-        hashInit(_hashValue);
-        _hashInitialized = true;
+        Ice::Int h = 5381;
+        hashAdd(h, type());
+        hashInit(h);
+        _hashValue.exchange(h);
+        _hashInitialized.exchange(1);
     }
-    return _hashValue;
+    return _hashValue.load();
 }
 
 string
@@ -466,21 +443,24 @@ IceInternal::IPEndpointI::IPEndpointI(const ProtocolInstancePtr& instance, const
     _port(port),
     _sourceAddr(sourceAddr),
     _connectionId(connectionId),
-    _hashInitialized(false)
+    _hashInitialized(0),
+    _hashValue(0)
 {
 }
 
 IceInternal::IPEndpointI::IPEndpointI(const ProtocolInstancePtr& instance) :
     _instance(instance),
     _port(0),
-    _hashInitialized(false)
+    _hashInitialized(0),
+    _hashValue(0)
 {
 }
 
 IceInternal::IPEndpointI::IPEndpointI(const ProtocolInstancePtr& instance, InputStream* s) :
     _instance(instance),
     _port(0),
-    _hashInitialized(false)
+    _hashInitialized(0),
+    _hashValue(0)
 {
     s->read(const_cast<string&>(_host), false);
     s->read(const_cast<Ice::Int&>(_port));
@@ -491,8 +471,6 @@ IceInternal::IPEndpointI::IPEndpointI(const ProtocolInstancePtr& instance, Input
 IceInternal::EndpointHostResolver::EndpointHostResolver(const InstancePtr& instance) :
     IceUtil::Thread("Ice.HostResolver"),
     _instance(instance),
-    _protocol(instance->protocolSupport()),
-    _preferIPv6(instance->preferIPv6()),
     _destroyed(false)
 {
     __setNoDelete(true);
@@ -522,19 +500,23 @@ IceInternal::EndpointHostResolver::EndpointHostResolver(const InstancePtr& insta
 }
 
 void
-IceInternal::EndpointHostResolver::resolve(const string& host, int port, Ice::EndpointSelectionType selType,
-                                           const IPEndpointIPtr& endpoint, const EndpointI_connectorsPtr& callback)
+IceInternal::EndpointHostResolver::resolve(const InstancePtr& instance, const string& host, int port,
+                                           Ice::EndpointSelectionType selType, const IPEndpointIPtr& endpoint,
+                                           const EndpointI_connectorsPtr& callback)
 {
     //
     // Try to get the addresses without DNS lookup. If this doesn't work, we queue a resolve
-    // entry and the thread will take care of getting the endpoint addresses.
+    // entry and the thread will take care of getting the endpoint addresses. The given
+    // instance is the endpoint's instance, which isn't the resolver's instance if the
+    // resolver is shared by the communicators of a runtime.
     //
-    NetworkProxyPtr networkProxy = _instance->networkProxy();
+    NetworkProxyPtr networkProxy = instance->networkProxy();
     if(!networkProxy)
     {
         try
         {
-            vector<Address> addrs = getAddresses(host, port, _protocol, selType, _preferIPv6, false);
+            vector<Address> addrs = getAddresses(host, port, instance->protocolSupport(), selType,
+                                                 instance->preferIPv6(), false);
             if(!addrs.empty())
             {
                 callback->connectors(endpoint->connectors(addrs, 0));
@@ -552,13 +534,14 @@ IceInternal::EndpointHostResolver::resolve(const string& host, int port, Ice::En
     assert(!_destroyed);
 
     ResolveEntry entry;
+    entry.instance = instance;
     entry.host = host;
     entry.port = port;
     entry.selType = selType;
     entry.endpoint = endpoint;
     entry.callback = callback;
 
-    const CommunicatorObserverPtr& obsv = _instance->initializationData().observer;
+    const CommunicatorObserverPtr& obsv = instance->initializationData().observer;
     if(obsv)
     {
         entry.observer = obsv->getEndpointLookupObserver(endpoint);
@@ -612,11 +595,11 @@ IceInternal::EndpointHostResolver::run()
 
         try
         {
-            NetworkProxyPtr networkProxy = _instance->networkProxy();
-            ProtocolSupport protocol = _protocol;
+            NetworkProxyPtr networkProxy = r.instance->networkProxy();
+            ProtocolSupport protocol = r.instance->protocolSupport();
             if(networkProxy)
             {
-                networkProxy = networkProxy->resolveHost(_protocol);
+                networkProxy = networkProxy->resolveHost(protocol);
                 if(networkProxy)
                 {
                     protocol = networkProxy->getProtocolSupport();
@@ -627,7 +610,7 @@ IceInternal::EndpointHostResolver::run()
                                                                        r.port,
                                                                        protocol,
                                                                        r.selType,
-                                                                       _preferIPv6,
+                                                                       r.instance->preferIPv6(),
                                                                        true),
                                                           networkProxy));
 
@@ -694,7 +677,8 @@ IceInternal::EndpointHostResolver::EndpointHostResolver(const InstancePtr& insta
 
 
 void
-IceInternal::EndpointHostResolver::resolve(const string& host,
+IceInternal::EndpointHostResolver::resolve(const InstancePtr& instance,
+                                           const string& host,
                                            int port,
                                            Ice::EndpointSelectionType selType,
                                            const IPEndpointIPtr& endpoint,
@@ -704,11 +688,11 @@ IceInternal::EndpointHostResolver::resolve(const string& host,
     // No DNS lookup support with WinRT.
     //
     callback->connectors(endpoint->connectors(getAddresses(host, port,
-                                                           _instance->protocolSupport(),
+                                                           instance->protocolSupport(),
                                                            selType,
-                                                           _instance->preferIPv6(),
+                                                           instance->preferIPv6(),
                                                            false),
-                                              _instance->networkProxy()));
+                                              instance->networkProxy()));
 }
 
 void
@@ -12,6 +12,7 @@
 
 #include <IceUtil/Config.h>
 #include <IceUtil/Shared.h>
+#include <IceUtil/Atomic.h>
 #include <IceUtil/Thread.h>
 #include <IceUtil/Monitor.h>
 #include <Ice/IPEndpointIF.h>
@@ -104,8 +105,8 @@ protected:
 
 private:
 
-    mutable bool _hashInitialized;
-    mutable Ice::Int _hashValue;
+    mutable IceUtilInternal::Atomic _hashInitialized;
+    mutable IceUtilInternal::Atomic _hashValue;
 };
 
 #ifndef ICE_OS_WINRT
@@ -118,7 +119,7 @@ public:
 
     EndpointHostResolver(const InstancePtr&);
 
-    void resolve(const std::string&, int, Ice::EndpointSelectionType, const IPEndpointIPtr&,
+    void resolve(const InstancePtr&, const std::string&, int, Ice::EndpointSelectionType, const IPEndpointIPtr&,
                  const EndpointI_connectorsPtr&);
     void destroy();
 
@@ -130,6 +131,7 @@ private:
 #ifndef ICE_OS_WINRT
     struct ResolveEntry
     {
+        InstancePtr instance;
         std::string host;
         int port;
         Ice::EndpointSelectionType selType;
@@ -139,8 +141,6 @@ private:
     };
 
     const InstancePtr _instance;
-    const IceInternal::ProtocolSupport _protocol;
-    const bool _preferIPv6;
     bool _destroyed;
     std::deque<ResolveEntry> _queue;
     ObserverHelperT<Ice::Instrumentation::ThreadObserver> _observer;
@@ -49,6 +49,35 @@ public:
 
 Init init;
 
+//
+// The threads of a runtime are created by a communicator which isn't
+// otherwise used.
+//
+class RuntimeI : public Ice::Runtime
+{
+public:
+
+    RuntimeI(const CommunicatorPtr& communicator) : _communicator(communicator)
+    {
+    }
+
+    virtual void
+    destroy()
+    {
+        _communicator->destroy();
+    }
+
+    const CommunicatorPtr&
+    communicator() const
+    {
+        return _communicator;
+    }
+
+private:
+
+    const CommunicatorPtr _communicator;
+};
+
 }
 
 StringSeq
@@ -221,6 +250,29 @@ inline void checkIceVersion(Int version)
 #endif
 }
 
+//
+// The threads of a runtime are shared by its communicators, they
+// can't be configured by a communicator.
+//
+void
+checkRuntime(const InitializationData& initData)
+{
+    if(!initData.runtime)
+    {
+        return;
+    }
+#ifdef ICE_CPP11_MAPPING
+    if(initData.dispatcher || initData.threadStart || initData.threadStop)
+#else
+    if(initData.dispatcher || initData.threadHook)
+#endif
+    {
+        throw InitializationException(__FILE__, __LINE__,
+                                      "the dispatcher and thread hooks of a communicator using a runtime must be "
+                                      "set on the runtime");
+    }
+}
+
 }
 
 
@@ -228,6 +280,7 @@ Ice::CommunicatorPtr
 Ice::initialize(int& argc, char* argv[], const InitializationData& initializationData, Int version)
 {
     checkIceVersion(version);
+    checkRuntime(initializationData);
 
     InitializationData initData = initializationData;
     initData.properties = createProperties(argc, argv, initData.properties);
@@ -254,6 +307,7 @@ Ice::initialize(const InitializationData& initData, Int version)
     // the config file, while the other one always does.
     //
     checkIceVersion(version);
+    checkRuntime(initData);
 
     CommunicatorIPtr communicator = CommunicatorI::create(initData);
     int argc = 0;
@@ -262,6 +316,21 @@ Ice::initialize(const InitializationData& initData, Int version)
     return communicator;
 }
 
+Ice::Runtime::~Runtime()
+{
+    // Out of line to avoid weak vtable
+}
+
+RuntimePtr
+Ice::createRuntime(const InitializationData& initData)
+{
+    if(initData.runtime)
+    {
+        throw InitializationException(__FILE__, __LINE__, "a runtime can't use another runtime");
+    }
+    return ICE_MAKE_SHARED(RuntimeI, initialize(initData));
+}
+
 LoggerPtr
 Ice::getProcessLogger()
 {
@@ -354,6 +423,14 @@ IceInternal::getInstanceTimer(const CommunicatorPtr& communicator)
     return p->_instance->timer();
 }
 
+InstancePtr
+IceInternal::getInstance(const RuntimePtr& runtime)
+{
+    RuntimeI* p = dynamic_cast<RuntimeI*>(runtime.get());
+    assert(p);
+    return getInstance(p->communicator());
+}
+
 Identity
 Ice::stringToIdentity(const string& s)
 {
@@ -31,6 +31,7 @@
 #include <Ice/WSEndpoint.h>
 #include <Ice/RequestHandlerFactory.h>
 #include <Ice/RetryQueue.h>
+#include <Ice/CompressionPolicy.h>
 #include <Ice/DynamicLibrary.h>
 #include <Ice/PluginManagerI.h>
 #include <Ice/Initialize.h>
@@ -221,6 +222,43 @@ private:
     ObserverHelperT<Ice::Instrumentation::ThreadObserver> _observer;
 };
 
+//
+// Work item dispatched with a thread pool shared with the other
+// communicators of a runtime, the instance waits for these work items
+// to complete on destruction.
+//
+class SharedDispatchWorkItem : public DispatchWorkItem
+{
+public:
+
+    SharedDispatchWorkItem(const InstancePtr& instance, const DispatchWorkItemPtr& workItem) :
+        DispatchWorkItem(workItem->getConnection()),
+        _instance(instance),
+        _workItem(workItem)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        try
+        {
+            _workItem->run();
+        }
+        catch(...)
+        {
+            _instance->dispatchFinished();
+            throw;
+        }
+        _instance->dispatchFinished();
+    }
+
+private:
+
+    const InstancePtr _instance;
+    const DispatchWorkItemPtr _workItem;
+};
+
 }
 
 void
@@ -461,8 +499,15 @@ IceInternal::Instance::serverThreadPool()
         {
             throw CommunicatorDestroyedException(__FILE__, __LINE__);
         }
-        int timeout = _initData.properties->getPropertyAsInt("Ice.ServerIdleTime");
-        _serverThreadPool = new ThreadPool(this, "Ice.ThreadPool.Server", timeout);
+        if(_initData.runtime)
+        {
+            _serverThreadPool = getInstance(_initData.runtime)->serverThreadPool();
+        }
+        else
+        {
+            int timeout = _initData.properties->getPropertyAsInt("Ice.ServerIdleTime");
+            _serverThreadPool = new ThreadPool(this, "Ice.ThreadPool.Server", timeout);
+        }
     }
 
     return _serverThreadPool;
@@ -509,6 +554,46 @@ IceInternal::Instance::timer()
     return _timer;
 }
 
+void
+IceInternal::Instance::dispatch(const ThreadPoolPtr& threadPool, const DispatchWorkItemPtr& workItem)
+{
+    //
+    // The thread pools of a runtime outlive its communicators, keep
+    // track of the work items of this communicator to wait for them
+    // on destruction.
+    //
+    if(!_initData.runtime)
+    {
+        threadPool->dispatch(workItem);
+        return;
+    }
+
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_dispatchMonitor);
+        ++_dispatchCount;
+    }
+    try
+    {
+        threadPool->dispatch(new SharedDispatchWorkItem(this, workItem));
+    }
+    catch(...)
+    {
+        dispatchFinished();
+        throw;
+    }
+}
+
+void
+IceInternal::Instance::dispatchFinished()
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_dispatchMonitor);
+    assert(_dispatchCount > 0);
+    if(--_dispatchCount == 0)
+    {
+        _dispatchMonitor.notifyAll();
+    }
+}
+
 EndpointFactoryManagerPtr
 IceInternal::Instance::endpointFactoryManager() const
 {
@@ -951,7 +1036,8 @@ IceInternal::Instance::Instance(const CommunicatorPtr& communicator, const Initi
     _implicitContext(0),
     _stringConverter(Ice::getProcessStringConverter()),
     _wstringConverter(Ice::getProcessWstringConverter()),
-    _adminEnabled(false)
+    _adminEnabled(false),
+    _dispatchCount(0)
 {
     try
     {
@@ -1189,6 +1275,11 @@ IceInternal::Instance::Instance(const CommunicatorPtr& communicator, const Initi
 
         const_cast<bool&>(_collectObjects) = _initData.properties->getPropertyAsInt("Ice.CollectObjects") > 0;
 
+        const_cast<RetryBudgetPtr&>(_retryBudget) = new RetryBudget(_initData.properties);
+
+        const_cast<CompressionPolicyPtr&>(_compressionPolicy) =
+            new CompressionPolicy(_initData.properties, _traceLevels, _initData.logger);
+
         //
         // Client ACM enabled by default. Server ACM disabled by default.
         //
@@ -1427,41 +1518,28 @@ IceInternal::Instance::finishSetup(int& argc, char* argv[], const Ice::Communica
     }
 
     //
-    // Create threads.
+    // Create threads, unless they are shared with the other
+    // communicators of the runtime.
     //
-    try
+    if(_initData.runtime)
     {
-        bool hasPriority = _initData.properties->getProperty("Ice.ThreadPriority") != "";
-        int priority = _initData.properties->getPropertyAsInt("Ice.ThreadPriority");
-        if(hasPriority)
-        {
-            _timer = new Timer(priority);
-        }
-        else
+        InstancePtr runtime = getInstance(_initData.runtime);
         {
-            _timer = new Timer;
+            Lock sync(*runtime);
+            if(runtime->_state == StateDestroyed)
+            {
+                throw CommunicatorDestroyedException(__FILE__, __LINE__);
+            }
+            _timer = runtime->_timer;
         }
+        _endpointHostResolver = runtime->endpointHostResolver();
+        _clientThreadPool = runtime->clientThreadPool();
     }
-    catch(const IceUtil::Exception& ex)
-    {
-        Error out(_initData.logger);
-        out << "cannot create thread for timer:\n" << ex;
-        throw;
-    }
-
-    try
-    {
-        _endpointHostResolver = new EndpointHostResolver(this);
-    }
-    catch(const IceUtil::Exception& ex)
+    else
     {
-        Error out(_initData.logger);
-        out << "cannot create thread for endpoint host resolver:\n" << ex;
-        throw;
+        createThreads();
     }
 
-    _clientThreadPool = new ThreadPool(this, "Ice.ThreadPool.Client", 0);
-
     //
     // The default router/locator may have been set during the loading of plugins.
     // Therefore we make sure it is not already set before checking the property.
@@ -1540,6 +1618,43 @@ IceInternal::Instance::finishSetup(int& argc, char* argv[], const Ice::Communica
     }
 }
 
+void
+IceInternal::Instance::createThreads()
+{
+    try
+    {
+        bool hasPriority = _initData.properties->getProperty("Ice.ThreadPriority") != "";
+        int priority = _initData.properties->getPropertyAsInt("Ice.ThreadPriority");
+        if(hasPriority)
+        {
+            _timer = new Timer(priority);
+        }
+        else
+        {
+            _timer = new Timer;
+        }
+    }
+    catch(const IceUtil::Exception& ex)
+    {
+        Error out(_initData.logger);
+        out << "cannot create thread for timer:\n" << ex;
+        throw;
+    }
+
+    try
+    {
+        _endpointHostResolver = new EndpointHostResolver(this);
+    }
+    catch(const IceUtil::Exception& ex)
+    {
+        Error out(_initData.logger);
+        out << "cannot create thread for endpoint host resolver:\n" << ex;
+        throw;
+    }
+
+    _clientThreadPool = new ThreadPool(this, "Ice.ThreadPool.Client", 0);
+}
+
 void
 IceInternal::Instance::destroy()
 {
@@ -1614,42 +1729,59 @@ IceInternal::Instance::destroy()
     //
     // Now, destroy the thread pools. This must be done *only* after
     // all the connections are finished (the connections destruction
-    // can require invoking callbacks with the thread pools).
+    // can require invoking callbacks with the thread pools). The
+    // threads shared with other communicators are destroyed with the
+    // runtime.
     //
-    if(_serverThreadPool)
-    {
-        _serverThreadPool->destroy();
-    }
-    if(_clientThreadPool)
-    {
-        _clientThreadPool->destroy();
-    }
-    if(_endpointHostResolver)
-    {
-        _endpointHostResolver->destroy();
-    }
-    if(_timer)
+    if(!_initData.runtime)
     {
-        _timer->destroy();
-    }
+        if(_serverThreadPool)
+        {
+            _serverThreadPool->destroy();
+        }
+        if(_clientThreadPool)
+        {
+            _clientThreadPool->destroy();
+        }
+        if(_endpointHostResolver)
+        {
+            _endpointHostResolver->destroy();
+        }
+        if(_timer)
+        {
+            _timer->destroy();
+        }
 
-    //
-    // Wait for all the threads to be finished.
-    //
-    if(_clientThreadPool)
-    {
-        _clientThreadPool->joinWithAllThreads();
-    }
-    if(_serverThreadPool)
-    {
-        _serverThreadPool->joinWithAllThreads();
-    }
+        //
+        // Wait for all the threads to be finished.
+        //
+        if(_clientThreadPool)
+        {
+            _clientThreadPool->joinWithAllThreads();
+        }
+        if(_serverThreadPool)
+        {
+            _serverThreadPool->joinWithAllThreads();
+        }
 #ifndef ICE_OS_WINRT
-    if(_endpointHostResolver)
+        if(_endpointHostResolver)
+        {
+            _endpointHostResolver->getThreadControl().join();
+        }
+#endif
+    }
+    else
     {
-        _endpointHostResolver->getThreadControl().join();
+        //
+        // Wait for the work items dispatched with the shared thread
+        // pools to complete, they can still use this communicator.
+        //
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_dispatchMonitor);
+        while(_dispatchCount > 0)
+        {
+            _dispatchMonitor.wait();
+        }
     }
-#endif
 
     for_each(_objectFactoryMap.begin(), _objectFactoryMap.end(),
         Ice::secondVoidMemFun<const string, ObjectFactory>(&ObjectFactory::destroy));
@@ -1741,21 +1873,25 @@ IceInternal::Instance::updateThreadObservers()
 {
     try
     {
-        if(_clientThreadPool)
+        //
+        // The observers of the threads shared with other communicators
+        // are updated by the runtime.
+        //
+        if(_clientThreadPool && !_initData.runtime)
         {
             _clientThreadPool->updateObservers();
         }
-        if(_serverThreadPool)
+        if(_serverThreadPool && !_initData.runtime)
         {
             _serverThreadPool->updateObservers();
         }
         assert(_objectAdapterFactory);
         _objectAdapterFactory->updateObservers(&ObjectAdapterI::updateThreadObservers);
-        if(_endpointHostResolver)
+        if(_endpointHostResolver && !_initData.runtime)
         {
             _endpointHostResolver->updateObserver();
         }
-        if(_timer)
+        if(_timer && !_initData.runtime)
         {
             _timer->updateObserver(_initData.observer);
         }
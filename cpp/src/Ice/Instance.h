@@ -33,6 +33,7 @@
 #include <Ice/EndpointFactoryManagerF.h>
 #include <Ice/IPEndpointIF.h>
 #include <Ice/RetryQueueF.h>
+#include <Ice/CompressionPolicyF.h>
 #include <Ice/DynamicLibraryF.h>
 #include <Ice/PluginF.h>
 #include <Ice/NetworkF.h>
@@ -63,6 +64,9 @@ ICE_DEFINE_PTR(MetricsAdminIPtr, MetricsAdminI);
 class RequestHandlerFactory;
 typedef IceUtil::Handle<RequestHandlerFactory> RequestHandlerFactoryPtr;
 
+class DispatchWorkItem;
+typedef IceUtil::Handle<DispatchWorkItem> DispatchWorkItemPtr;
+
 //
 // Structure to track warnings for attempts to set socket buffer sizes
 //
@@ -103,7 +107,10 @@ public:
     ThreadPoolPtr serverThreadPool();
     EndpointHostResolverPtr endpointHostResolver();
     RetryQueuePtr retryQueue();
+    const RetryBudgetPtr& retryBudget() const { return _retryBudget; } // No mutex lock, immutable.
+    const CompressionPolicyPtr& compressionPolicy() const { return _compressionPolicy; } // No mutex lock, immutable.
     IceUtil::TimerPtr timer();
+    void dispatch(const ThreadPoolPtr&, const DispatchWorkItemPtr&);
     EndpointFactoryManagerPtr endpointFactoryManager() const;
     DynamicLibraryListPtr dynamicLibraryList() const;
     Ice::PluginManagerPtr pluginManager() const;
@@ -152,6 +159,7 @@ private:
     Instance(const Ice::CommunicatorPtr&, const Ice::InitializationData&);
     virtual ~Instance();
     void finishSetup(int&, char*[], const Ice::CommunicatorPtr&);
+    void createThreads();
     void destroy();
     friend class Ice::CommunicatorI;
 
@@ -159,6 +167,9 @@ private:
     void updateThreadObservers();
     friend class ObserverUpdaterI;
 
+    void dispatchFinished();
+    friend class SharedDispatchWorkItem;
+
     void addAllAdminFacets();
     void setServerProcessProxy(const Ice::ObjectAdapterPtr&, const Ice::Identity&);
 
@@ -193,6 +204,8 @@ private:
     ThreadPoolPtr _serverThreadPool;
     EndpointHostResolverPtr _endpointHostResolver;
     RetryQueuePtr _retryQueue;
+    const RetryBudgetPtr _retryBudget; // Immutable, not reset by destroy().
+    const CompressionPolicyPtr _compressionPolicy; // Immutable, not reset by destroy().
     TimerPtr _timer;
     EndpointFactoryManagerPtr _endpointFactoryManager;
     DynamicLibraryListPtr _dynamicLibraryList;
@@ -210,6 +223,8 @@ private:
     IceUtil::Mutex _setBufSizeWarnMutex;
     ObjectFactoryMap _objectFactoryMap;
     mutable ObjectFactoryMap::iterator _objectFactoryMapHint;
+    IceUtil::Monitor<IceUtil::Mutex> _dispatchMonitor;
+    int _dispatchCount;
 };
 
 class ProcessI : public Ice::Process
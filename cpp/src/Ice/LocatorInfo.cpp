@@ -19,7 +19,15 @@
 #include <Ice/Functional.h>
 #include <Ice/Properties.h>
 #include <Ice/Comparable.h>
+#include <Ice/EndpointFactoryManager.h>
+#include <Ice/ReferenceFactory.h>
+#include <Ice/OutputStream.h>
+#include <Ice/InputStream.h>
+#include <IceUtil/FileUtil.h>
+#include <IceUtil/Random.h>
+#include <IceUtil/StringUtil.h>
 #include <iterator>
+#include <fstream>
 
 using namespace std;
 using namespace Ice;
@@ -125,10 +133,183 @@ public:
     }
 };
 
+//
+// The locator cache file holds a sequence of records, each record
+// holds the endpoints of an adapter or the proxy of a well-known
+// object for a given locator. The endpoints and proxies are kept
+// marshaled so that the records of other locators are copied without
+// being unmarshaled.
+//
+const Int cacheFileVersion = 1;
+
+//
+// Delay between the first update of a locator table and the write
+// of the cache file, the updates made in the meantime are written
+// together.
+//
+const IceUtil::Time flushDelay = IceUtil::Time::seconds(1);
+
+const Byte adapterRecord = 0;
+const Byte objectRecord = 1;
+
+struct CacheRecord
+{
+    Identity locator;
+    EncodingVersion encoding;
+    Byte type;
+    string adapterId;
+    Identity id;
+    IceUtil::Int64 time; // Wall-clock time of the update, in microseconds.
+    vector<Byte> data;
+};
+
+vector<CacheRecord>
+readCacheFile(Instance* instance, const string& file)
+{
+    vector<CacheRecord> records;
+    ifstream in(IceUtilInternal::streamFilename(file).c_str(), ios::binary);
+    if(!in)
+    {
+        return records;
+    }
+
+    vector<Byte> bytes((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    if(bytes.empty())
+    {
+        return records;
+    }
+
+    try
+    {
+        Buffer buf(bytes);
+        InputStream is(instance, Ice::currentProtocolEncoding, buf, true);
+        Int version;
+        is.read(version);
+        if(version != cacheFileVersion)
+        {
+            return records;
+        }
+
+        Int sz = is.readSize();
+        for(Int i = 0; i < sz; ++i)
+        {
+            CacheRecord record;
+            is.read(record.locator);
+            is.read(record.encoding);
+            is.read(record.type);
+            is.read(record.adapterId);
+            is.read(record.id);
+            is.read(record.time);
+            is.read(record.data);
+            records.push_back(record);
+        }
+    }
+    catch(const Ice::LocalException&)
+    {
+        //
+        // The file is corrupted, it's rewritten with the next update.
+        //
+        records.clear();
+    }
+    return records;
+}
+
+bool
+writeCacheFile(Instance* instance, const string& file, const vector<CacheRecord>& records)
+{
+    OutputStream os(instance, Ice::currentProtocolEncoding);
+    os.write(cacheFileVersion);
+    os.writeSize(static_cast<Int>(records.size()));
+    for(vector<CacheRecord>::const_iterator p = records.begin(); p != records.end(); ++p)
+    {
+        os.write(p->locator);
+        os.write(p->encoding);
+        os.write(p->type);
+        os.write(p->adapterId);
+        os.write(p->id);
+        os.write(p->time);
+        os.write(p->data);
+    }
+
+    //
+    // Write a temporary file and rename it, other processes sharing
+    // the cache file never read a partially written file.
+    //
+    ostringstream tmp;
+    tmp << file << ".tmp" << IceUtilInternal::random();
+    {
+        ofstream out(IceUtilInternal::streamFilename(tmp.str()).c_str(), ios::binary | ios::trunc);
+        if(!out)
+        {
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(os.b.begin()), static_cast<streamsize>(os.b.size()));
+        out.close();
+        if(!out)
+        {
+            IceUtilInternal::remove(tmp.str());
+            return false;
+        }
+    }
+
+    if(IceUtilInternal::rename(tmp.str(), file) != 0)
+    {
+        //
+        // On Windows, rename fails if the file already exists.
+        //
+        IceUtilInternal::remove(file);
+        if(IceUtilInternal::rename(tmp.str(), file) != 0)
+        {
+            IceUtilInternal::remove(tmp.str());
+            return false;
+        }
+    }
+    return true;
+}
+
+//
+// The times of the locator table are monotonic, the times of the
+// cache file are wall-clock times since they are shared between
+// processes.
+//
+IceUtil::Time
+toMonotonic(IceUtil::Int64 time)
+{
+    IceUtil::Time age = IceUtil::Time::now() - IceUtil::Time::microSeconds(time);
+    return IceUtil::Time::now(IceUtil::Time::Monotonic) - (age > IceUtil::Time() ? age : IceUtil::Time());
+}
+
+IceUtil::Int64
+toRealtime(const IceUtil::Time& time)
+{
+    return (IceUtil::Time::now() - (IceUtil::Time::now(IceUtil::Time::Monotonic) - time)).toMicroSeconds();
+}
+
+class FlushTask : public IceUtil::TimerTask
+{
+public:
+
+    FlushTask(const LocatorTablePtr& table) : _table(table)
+    {
+    }
+
+    virtual void
+    runTimerTask()
+    {
+        _table->flush();
+    }
+
+private:
+
+    const LocatorTablePtr _table;
+};
+
 }
 
 IceInternal::LocatorManager::LocatorManager(const Ice::PropertiesPtr& properties) :
     _background(properties->getPropertyAsInt("Ice.BackgroundLocatorCacheUpdates") > 0),
+    _cacheFile(properties->getProperty("Ice.LocatorCacheFile")),
+    _registrationWindow(IceUtil::Time::milliSeconds(properties->getPropertyAsInt("Ice.LocatorRegistrationWindow"))),
     _tableHint(_table.end())
 {
 }
@@ -138,6 +319,16 @@ IceInternal::LocatorManager::destroy()
 {
     IceUtil::Mutex::Lock sync(*this);
 
+    //
+    // Write the pending updates of the tables before they are cleared
+    // by the locator infos.
+    //
+    for(map<pair<Identity, EncodingVersion>, LocatorTablePtr>::const_iterator p = _locatorTables.begin();
+        p != _locatorTables.end(); ++p)
+    {
+        p->second->destroy();
+    }
+
 #ifdef ICE_CPP11_MAPPING
     for_each(_table.begin(), _table.end(), [](pair<shared_ptr<Ice::LocatorPrx>, LocatorInfoPtr> it){ it.second->destroy(); });
 #else
@@ -191,15 +382,25 @@ IceInternal::LocatorManager::get(const LocatorPrxPtr& loc)
         map<pair<Identity, EncodingVersion>, LocatorTablePtr>::iterator t = _locatorTables.find(locatorKey);
         if(t == _locatorTables.end())
         {
+            LocatorTablePtr table;
+            if(_cacheFile.empty())
+            {
+                table = new LocatorTable();
+            }
+            else
+            {
+                table = new LocatorTable(locator->__reference()->getInstance(), _cacheFile, locatorKey.first,
+                                         locatorKey.second);
+            }
             t = _locatorTables.insert(_locatorTables.begin(),
-                                      pair<const pair<Identity, EncodingVersion>, LocatorTablePtr>(
-                                          locatorKey, new LocatorTable()));
+                                      pair<const pair<Identity, EncodingVersion>, LocatorTablePtr>(locatorKey, table));
         }
 
         _tableHint = _table.insert(_tableHint,
                                    pair<const LocatorPrxPtr, LocatorInfoPtr>(locator,
                                                                           new LocatorInfo(locator, t->second,
-                                                                                          _background)));
+                                                                                          _background,
+                                                                                          _registrationWindow)));
     }
     else
     {
@@ -209,10 +410,28 @@ IceInternal::LocatorManager::get(const LocatorPrxPtr& loc)
     return _tableHint->second;
 }
 
-IceInternal::LocatorTable::LocatorTable()
+IceInternal::LocatorTable::LocatorTable() :
+    _generation(0),
+    _dirty(false),
+    _destroyed(false),
+    _savedGeneration(0)
 {
 }
 
+IceInternal::LocatorTable::LocatorTable(const InstancePtr& instance, const string& file, const Identity& locator,
+                                        const EncodingVersion& encoding) :
+    _instance(instance),
+    _file(file),
+    _locator(locator),
+    _encoding(encoding),
+    _generation(0),
+    _dirty(false),
+    _destroyed(false),
+    _savedGeneration(0)
+{
+    load();
+}
+
 void
 IceInternal::LocatorTable::clear()
 {
@@ -220,6 +439,8 @@ IceInternal::LocatorTable::clear()
 
      _adapterEndpointsMap.clear();
      _objectMap.clear();
+     _loadedAdapters.clear();
+     _loadedObjects.clear();
 }
 
 bool
@@ -237,6 +458,10 @@ IceInternal::LocatorTable::getAdapterEndpoints(const string& adapter, int ttl, v
     if(p != _adapterEndpointsMap.end())
     {
         endpoints = p->second.second;
+        if(_loadedAdapters.find(adapter) != _loadedAdapters.end())
+        {
+            return false; // Loaded from the cache file, needs to be refreshed.
+        }
         return checkTTL(p->second.first, ttl);
     }
     return false;
@@ -258,6 +483,13 @@ IceInternal::LocatorTable::addAdapterEndpoints(const string& adapter, const vect
         _adapterEndpointsMap.insert(
             make_pair(adapter, make_pair(IceUtil::Time::now(IceUtil::Time::Monotonic), endpoints)));
     }
+
+    if(!_file.empty())
+    {
+        _loadedAdapters.erase(adapter);
+        _removedAdapters.erase(adapter);
+        markDirty();
+    }
 }
 
 vector<EndpointIPtr>
@@ -275,6 +507,13 @@ IceInternal::LocatorTable::removeAdapterEndpoints(const string& adapter)
 
     _adapterEndpointsMap.erase(p);
 
+    if(!_file.empty())
+    {
+        _loadedAdapters.erase(adapter);
+        _removedAdapters[adapter] = IceUtil::Time::now();
+        markDirty();
+    }
+
     return endpoints;
 }
 
@@ -293,6 +532,10 @@ IceInternal::LocatorTable::getObjectReference(const Identity& id, int ttl, Refer
     if(p != _objectMap.end())
     {
         ref = p->second.second;
+        if(_loadedObjects.find(id) != _loadedObjects.end())
+        {
+            return false; // Loaded from the cache file, needs to be refreshed.
+        }
         return checkTTL(p->second.first, ttl);
     }
     return false;
@@ -313,6 +556,13 @@ IceInternal::LocatorTable::addObjectReference(const Identity& id, const Referenc
     {
         _objectMap.insert(make_pair(id, make_pair(IceUtil::Time::now(IceUtil::Time::Monotonic), ref)));
     }
+
+    if(!_file.empty())
+    {
+        _loadedObjects.erase(id);
+        _removedObjects.erase(id);
+        markDirty();
+    }
 }
 
 ReferencePtr
@@ -328,6 +578,14 @@ IceInternal::LocatorTable::removeObjectReference(const Identity& id)
 
     ReferencePtr ref = p->second.second;
     _objectMap.erase(p);
+
+    if(!_file.empty())
+    {
+        _loadedObjects.erase(id);
+        _removedObjects[id] = IceUtil::Time::now();
+        markDirty();
+    }
+
     return ref;
 }
 
@@ -345,6 +603,230 @@ IceInternal::LocatorTable::checkTTL(const IceUtil::Time& time, int ttl) const
     }
 }
 
+void
+IceInternal::LocatorTable::destroy()
+{
+    IceUtil::TimerTaskPtr task;
+    {
+        IceUtil::Mutex::Lock sync(*this);
+        _destroyed = true;
+        task = _flushTask;
+        _flushTask = ICE_NULLPTR;
+    }
+
+    if(task)
+    {
+        try
+        {
+            _instance->timer()->cancel(task);
+        }
+        catch(const Ice::CommunicatorDestroyedException&)
+        {
+        }
+    }
+
+    if(!_file.empty())
+    {
+        flush();
+    }
+}
+
+void
+IceInternal::LocatorTable::load()
+{
+    vector<CacheRecord> records = readCacheFile(_instance.get(), _file);
+    for(vector<CacheRecord>::const_iterator p = records.begin(); p != records.end(); ++p)
+    {
+        if(p->locator != _locator || p->encoding != _encoding)
+        {
+            continue;
+        }
+
+        try
+        {
+            Buffer buf(p->data);
+            InputStream is(_instance.get(), Ice::currentProtocolEncoding, buf, true);
+            if(p->type == adapterRecord)
+            {
+                vector<EndpointIPtr> endpoints;
+                Int sz = is.readSize();
+                for(Int i = 0; i < sz; ++i)
+                {
+                    endpoints.push_back(_instance->endpointFactoryManager()->read(&is));
+                }
+                if(!endpoints.empty())
+                {
+                    _adapterEndpointsMap[p->adapterId] = make_pair(toMonotonic(p->time), endpoints);
+                    _loadedAdapters.insert(p->adapterId);
+                }
+            }
+            else if(p->type == objectRecord)
+            {
+                ReferencePtr ref = _instance->referenceFactory()->create(p->id, &is);
+                if(ref)
+                {
+                    _objectMap[p->id] = make_pair(toMonotonic(p->time), ref);
+                    _loadedObjects.insert(p->id);
+                }
+            }
+        }
+        catch(const Ice::LocalException&)
+        {
+            //
+            // Ignore the entries which can't be unmarshaled, they are
+            // removed from the file with the next update.
+            //
+        }
+    }
+
+    if(_instance->traceLevels()->location >= 1)
+    {
+        Trace out(_instance->initializationData().logger, _instance->traceLevels()->locationCat);
+        out << "loaded locator cache file `" << _file << "'";
+        out << "\nlocator = " << Ice::identityToString(_locator);
+        out << "\nadapters = " << _loadedAdapters.size();
+        out << "\nobjects = " << _loadedObjects.size();
+    }
+}
+
+void
+IceInternal::LocatorTable::markDirty()
+{
+    //
+    // Called with the table locked.
+    //
+    assert(!_file.empty());
+    _dirty = true;
+    if(_flushTask || _destroyed)
+    {
+        return;
+    }
+
+    try
+    {
+        _flushTask = ICE_MAKE_SHARED(FlushTask, this);
+        _instance->timer()->schedule(_flushTask, flushDelay);
+    }
+    catch(const IceUtil::Exception&)
+    {
+        //
+        // The communicator is being destroyed, the table is flushed
+        // when the locator manager is destroyed.
+        //
+        _flushTask = ICE_NULLPTR;
+    }
+}
+
+void
+IceInternal::LocatorTable::flush()
+{
+    IceUtil::Mutex::Lock sync(*this);
+
+    _flushTask = ICE_NULLPTR;
+    if(!_dirty)
+    {
+        return;
+    }
+    _dirty = false;
+
+    //
+    // The entries are marshaled while holding the lock and the file
+    // is written once it's released. Updates are written in order,
+    // an update is skipped if a more recent one was already written.
+    //
+    IceUtil::Int64 generation = ++_generation;
+    vector<CacheRecord> records;
+    set<string> adapters;
+    set<Identity> objects;
+    for(map<string, pair<IceUtil::Time, vector<EndpointIPtr> > >::const_iterator p = _adapterEndpointsMap.begin();
+        p != _adapterEndpointsMap.end(); ++p)
+    {
+        CacheRecord record;
+        record.locator = _locator;
+        record.encoding = _encoding;
+        record.type = adapterRecord;
+        record.adapterId = p->first;
+        record.time = toRealtime(p->second.first);
+
+        OutputStream os(_instance.get(), Ice::currentProtocolEncoding);
+        os.writeSize(static_cast<Int>(p->second.second.size()));
+        for(vector<EndpointIPtr>::const_iterator q = p->second.second.begin(); q != p->second.second.end(); ++q)
+        {
+            (*q)->streamWrite(&os);
+        }
+        os.finished(record.data);
+
+        records.push_back(record);
+        adapters.insert(p->first);
+    }
+    for(map<Identity, pair<IceUtil::Time, ReferencePtr> >::const_iterator p = _objectMap.begin();
+        p != _objectMap.end(); ++p)
+    {
+        CacheRecord record;
+        record.locator = _locator;
+        record.encoding = _encoding;
+        record.type = objectRecord;
+        record.id = p->first;
+        record.time = toRealtime(p->second.first);
+
+        OutputStream os(_instance.get(), Ice::currentProtocolEncoding);
+        p->second.second->streamWrite(&os);
+        os.finished(record.data);
+
+        records.push_back(record);
+        objects.insert(p->first);
+    }
+    map<string, IceUtil::Time> removedAdapters = _removedAdapters;
+    map<Identity, IceUtil::Time> removedObjects = _removedObjects;
+
+    sync.release();
+
+    IceUtil::Mutex::Lock fileSync(_fileMutex);
+    if(generation < _savedGeneration)
+    {
+        return;
+    }
+    _savedGeneration = generation;
+
+    //
+    // Keep the records of the other locators, and the records of this
+    // locator added by other processes unless the entry was updated
+    // or removed by this process since.
+    //
+    vector<CacheRecord> fileRecords = readCacheFile(_instance.get(), _file);
+    for(vector<CacheRecord>::const_iterator p = fileRecords.begin(); p != fileRecords.end(); ++p)
+    {
+        if(p->locator == _locator && p->encoding == _encoding)
+        {
+            if(p->type == adapterRecord)
+            {
+                map<string, IceUtil::Time>::const_iterator q = removedAdapters.find(p->adapterId);
+                if(adapters.find(p->adapterId) != adapters.end() ||
+                   (q != removedAdapters.end() && q->second.toMicroSeconds() >= p->time))
+                {
+                    continue;
+                }
+            }
+            else
+            {
+                map<Identity, IceUtil::Time>::const_iterator q = removedObjects.find(p->id);
+                if(objects.find(p->id) != objects.end() ||
+                   (q != removedObjects.end() && q->second.toMicroSeconds() >= p->time))
+                {
+                    continue;
+                }
+            }
+        }
+        records.push_back(*p);
+    }
+
+    if(!writeCacheFile(_instance.get(), _file, records) && _instance->traceLevels()->location >= 1)
+    {
+        Trace out(_instance->initializationData().logger, _instance->traceLevels()->locationCat);
+        out << "couldn't write locator cache file `" << _file << "':\n" << IceUtilInternal::lastErrorToString();
+    }
+}
+
 void
 IceInternal::LocatorInfo::RequestCallback::response(const LocatorInfoPtr& locatorInfo, const Ice::ObjectPrxPtr& proxy)
 {
@@ -543,10 +1025,14 @@ IceInternal::LocatorInfo::Request::exception(const Ice::Exception& ex)
     }
 }
 
-IceInternal::LocatorInfo::LocatorInfo(const LocatorPrxPtr& locator, const LocatorTablePtr& table, bool background) :
+IceInternal::LocatorInfo::LocatorInfo(const LocatorPrxPtr& locator, const LocatorTablePtr& table, bool background,
+                                      const IceUtil::Time& registrationWindow) :
     _locator(locator),
     _table(table),
-    _background(background)
+    _background(background),
+    _registrationWindow(registrationWindow),
+    _registering(false),
+    _batchRegistration(true)
 {
     assert(_locator);
     assert(_table);
@@ -606,6 +1092,174 @@ IceInternal::LocatorInfo::getLocatorRegistry()
     }
 }
 
+void
+IceInternal::LocatorInfo::setAdapterDirectProxy(const LocatorRegistryPrxPtr& locatorRegistry,
+                                                const string& adapterId,
+                                                const string& replicaGroupId,
+                                                const ObjectPrxPtr& proxy)
+{
+    RegistrationPtr registration = new Registration(adapterId, replicaGroupId, proxy);
+    vector<RegistrationPtr> registrations;
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_registrationMonitor);
+        _registrations.push_back(registration);
+
+        //
+        // Wait for the registration in progress to complete. The
+        // registrations queued in the meantime are then sent together
+        // by the first thread which finds no registration in progress.
+        //
+        while(_registering && !registration->done)
+        {
+            _registrationMonitor.wait();
+        }
+
+        if(!registration->done)
+        {
+            _registering = true;
+
+            //
+            // Wait for the registration window to expire before sending,
+            // the adapters activated or deactivated by other threads in
+            // the meantime are sent with this registration.
+            //
+            if(_registrationWindow > IceUtil::Time())
+            {
+                IceUtil::Time deadline = IceUtil::Time::now(IceUtil::Time::Monotonic) + _registrationWindow;
+                IceUtil::Time now;
+                while((now = IceUtil::Time::now(IceUtil::Time::Monotonic)) < deadline)
+                {
+                    _registrationMonitor.timedWait(deadline - now);
+                }
+            }
+            registrations.swap(_registrations);
+        }
+    }
+
+    if(!registrations.empty())
+    {
+        RegistrationGuard guard(*this, registrations);
+        sendRegistrations(locatorRegistry, registrations);
+        guard.sent();
+    }
+
+    if(registration->exception)
+    {
+        registration->exception->ice_throw();
+    }
+}
+
+void
+IceInternal::LocatorInfo::sendRegistrations(const LocatorRegistryPrxPtr& locatorRegistry,
+                                            const vector<RegistrationPtr>& registrations)
+{
+    //
+    // _batchRegistration is only used by the thread sending the
+    // registrations, there's no need to lock.
+    //
+    if(registrations.size() > 1 && _batchRegistration)
+    {
+        AdapterDirectProxyInfoSeq adapters;
+        for(vector<RegistrationPtr>::const_iterator p = registrations.begin(); p != registrations.end(); ++p)
+        {
+            AdapterDirectProxyInfo info;
+            info.id = (*p)->id;
+            info.replicaGroupId = (*p)->replicaGroupId;
+            info.proxy = (*p)->proxy;
+            adapters.push_back(info);
+        }
+
+        try
+        {
+            ICE_UNCHECKED_CAST(BatchLocatorRegistryPrx, locatorRegistry)->setAdapterDirectProxies(adapters);
+
+            InstancePtr instance = locatorRegistry->__reference()->getInstance();
+            if(instance->traceLevels()->location >= 1)
+            {
+                Trace out(instance->initializationData().logger, instance->traceLevels()->locationCat);
+                out << "updated the endpoints of " << adapters.size() << " object adapters with the locator registry";
+            }
+            return;
+        }
+        catch(const OperationNotExistException&)
+        {
+            //
+            // The locator registry doesn't support batch registrations,
+            // don't try again.
+            //
+            _batchRegistration = false;
+        }
+        catch(const UserException&)
+        {
+            //
+            // Register the adapters one by one to find out which
+            // registrations failed.
+            //
+        }
+        catch(const Ice::Exception& ex)
+        {
+            for(vector<RegistrationPtr>::const_iterator p = registrations.begin(); p != registrations.end(); ++p)
+            {
+                ICE_SET_EXCEPTION_FROM_CLONE((*p)->exception, ex.ice_clone());
+            }
+            return;
+        }
+    }
+
+    for(vector<RegistrationPtr>::const_iterator p = registrations.begin(); p != registrations.end(); ++p)
+    {
+        try
+        {
+            if((*p)->replicaGroupId.empty())
+            {
+                locatorRegistry->setAdapterDirectProxy((*p)->id, (*p)->proxy);
+            }
+            else
+            {
+                locatorRegistry->setReplicatedAdapterDirectProxy((*p)->id, (*p)->replicaGroupId, (*p)->proxy);
+            }
+        }
+        catch(const Ice::Exception& ex)
+        {
+            ICE_SET_EXCEPTION_FROM_CLONE((*p)->exception, ex.ice_clone());
+        }
+    }
+}
+
+IceInternal::LocatorInfo::RegistrationGuard::RegistrationGuard(LocatorInfo& info,
+                                                               const vector<RegistrationPtr>& registrations) :
+    _info(info),
+    _registrations(registrations),
+    _sent(false)
+{
+}
+
+IceInternal::LocatorInfo::RegistrationGuard::~RegistrationGuard()
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_info._registrationMonitor);
+    for(vector<RegistrationPtr>::const_iterator p = _registrations.begin(); p != _registrations.end(); ++p)
+    {
+        if(!_sent && !(*p)->exception)
+        {
+            UnknownException ex(__FILE__, __LINE__, "adapter registration failed");
+            ICE_SET_EXCEPTION_FROM_CLONE((*p)->exception, ex.ice_clone());
+        }
+        (*p)->done = true;
+    }
+    _info._registering = false;
+    _info._registrationMonitor.notifyAll();
+}
+
+IceInternal::LocatorInfo::Registration::Registration(const string& adapterId,
+                                                     const string& replicaGroup,
+                                                     const ObjectPrxPtr& prx) :
+    id(adapterId),
+    replicaGroupId(replicaGroup),
+    proxy(prx),
+    done(false)
+{
+}
+
 vector<EndpointIPtr>
 IceInternal::LocatorInfo::getEndpoints(const ReferencePtr& ref, const ReferencePtr& wellKnownRef, int ttl, bool& cached)
 {
@@ -615,7 +1269,7 @@ IceInternal::LocatorInfo::getEndpoints(const ReferencePtr& ref, const ReferenceP
     {
         if(!_table->getAdapterEndpoints(ref->getAdapterId(), ttl, endpoints))
         {
-            if(_background && !endpoints.empty())
+            if((_background || _table->isPersistent()) && !endpoints.empty())
             {
                 getAdapterRequest(ref)->addCallback(ref, wellKnownRef, ttl, 0);
             }
@@ -630,7 +1284,7 @@ IceInternal::LocatorInfo::getEndpoints(const ReferencePtr& ref, const ReferenceP
         ReferencePtr r;
         if(!_table->getObjectReference(ref->getIdentity(), ttl, r))
         {
-            if(_background && r)
+            if((_background || _table->isPersistent()) && r)
             {
                 getObjectRequest(ref)->addCallback(ref, 0, ttl, 0);
             }
@@ -671,7 +1325,7 @@ IceInternal::LocatorInfo::getEndpointsWithCallback(const ReferencePtr& ref,
     {
         if(!_table->getAdapterEndpoints(ref->getAdapterId(), ttl, endpoints))
         {
-            if(_background && !endpoints.empty())
+            if((_background || _table->isPersistent()) && !endpoints.empty())
             {
                 getAdapterRequest(ref)->addCallback(ref, wellKnownRef, ttl, 0);
             }
@@ -687,7 +1341,7 @@ IceInternal::LocatorInfo::getEndpointsWithCallback(const ReferencePtr& ref,
         ReferencePtr r;
         if(!_table->getObjectReference(ref->getIdentity(), ttl, r))
         {
-            if(_background && r)
+            if((_background || _table->isPersistent()) && r)
             {
                 getObjectRequest(ref)->addCallback(ref, 0, ttl, 0);
             }
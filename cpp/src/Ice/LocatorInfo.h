@@ -14,16 +14,20 @@
 #include <IceUtil/Mutex.h>
 #include <IceUtil/Monitor.h>
 #include <IceUtil/Time.h>
+#include <IceUtil/Timer.h>
 #include <Ice/LocatorInfoF.h>
 #include <Ice/LocatorF.h>
 #include <Ice/ReferenceF.h>
 #include <Ice/Identity.h>
 #include <Ice/EndpointIF.h>
+#include <Ice/InstanceF.h>
 #include <Ice/PropertiesF.h>
 #include <Ice/Version.h>
 
 #include <IceUtil/UniquePtr.h>
 
+#include <set>
+
 namespace IceInternal
 {
 
@@ -44,6 +48,8 @@ public:
 private:
 
     const bool _background;
+    const std::string _cacheFile;
+    const IceUtil::Time _registrationWindow;
 
 #ifdef ICE_CPP11_MAPPING
     using LocatorInfoTable = std::map<std::shared_ptr<Ice::LocatorPrx>,
@@ -64,8 +70,31 @@ public:
 
     LocatorTable();
 
+    //
+    // Creates a locator table which is persisted in the given cache
+    // file. The file can be shared with other processes and holds the
+    // entries of all the locators used by these processes.
+    //
+    LocatorTable(const InstancePtr&, const std::string&, const Ice::Identity&, const Ice::EncodingVersion&);
+
     void clear();
 
+    //
+    // Writes the pending updates to the cache file. The updates are
+    // written by a timer task shortly after the table is modified
+    // and when the table is destroyed.
+    //
+    void flush();
+    void destroy();
+
+    bool isPersistent() const
+    {
+        //
+        // No mutex lock necessary, _file is immutable.
+        //
+        return !_file.empty();
+    }
+
     bool getAdapterEndpoints(const std::string&, int, ::std::vector<EndpointIPtr>&);
     void addAdapterEndpoints(const std::string&, const ::std::vector<EndpointIPtr>&);
     ::std::vector<EndpointIPtr> removeAdapterEndpoints(const std::string&);
@@ -78,8 +107,33 @@ private:
 
     bool checkTTL(const IceUtil::Time&, int) const;
 
+    void load();
+    void markDirty();
+
     std::map<std::string, std::pair<IceUtil::Time, std::vector<EndpointIPtr> > > _adapterEndpointsMap;
     std::map<Ice::Identity, std::pair<IceUtil::Time, ReferencePtr> > _objectMap;
+
+    const InstancePtr _instance;
+    const std::string _file;
+    const Ice::Identity _locator;
+    const Ice::EncodingVersion _encoding;
+
+    //
+    // Entries loaded from the cache file which haven't been refreshed
+    // with the locator yet, and the entries removed since the table
+    // was loaded with the time of their removal.
+    //
+    std::set<std::string> _loadedAdapters;
+    std::set<Ice::Identity> _loadedObjects;
+    std::map<std::string, IceUtil::Time> _removedAdapters;
+    std::map<Ice::Identity, IceUtil::Time> _removedObjects;
+    IceUtil::Int64 _generation;
+    bool _dirty;
+    bool _destroyed;
+    IceUtil::TimerTaskPtr _flushTask;
+
+    IceUtil::Mutex _fileMutex;
+    IceUtil::Int64 _savedGeneration;
 };
 
 class LocatorInfo : public IceUtil::Shared, public IceUtil::Mutex
@@ -143,7 +197,7 @@ public:
     };
     typedef IceUtil::Handle<Request> RequestPtr;
 
-    LocatorInfo(const Ice::LocatorPrxPtr&, const LocatorTablePtr&, bool);
+    LocatorInfo(const Ice::LocatorPrxPtr&, const LocatorTablePtr&, bool, const IceUtil::Time&);
 
     void destroy();
 
@@ -159,6 +213,16 @@ public:
     }
     Ice::LocatorRegistryPrxPtr getLocatorRegistry();
 
+    //
+    // Set the endpoints of an object adapter with the locator
+    // registry. The adapters registered while a registration is in
+    // progress are registered together, with a single request if the
+    // locator registry supports it. Raises the exceptions of the
+    // LocatorRegistry operations.
+    //
+    void setAdapterDirectProxy(const Ice::LocatorRegistryPrxPtr&, const std::string&, const std::string&,
+                               const Ice::ObjectPrxPtr&);
+
     std::vector<EndpointIPtr> getEndpoints(const ReferencePtr& ref, int ttl, bool& cached)
     {
         return getEndpoints(ref, 0, ttl, cached);
@@ -186,13 +250,60 @@ private:
     friend class Request;
     friend class RequestCallback;
 
+    class Registration : public IceUtil::Shared
+    {
+    public:
+
+        Registration(const std::string&, const std::string&, const Ice::ObjectPrxPtr&);
+
+        const std::string id;
+        const std::string replicaGroupId;
+        const Ice::ObjectPrxPtr proxy;
+        bool done;
+        IceUtil::UniquePtr<Ice::Exception> exception;
+    };
+    typedef IceUtil::Handle<Registration> RegistrationPtr;
+
+    //
+    // Completes the registrations sent by a thread and lets another
+    // thread send the registrations queued in the meantime, even if
+    // the sending thread raised an unexpected exception.
+    //
+    class RegistrationGuard
+    {
+    public:
+
+        RegistrationGuard(LocatorInfo&, const std::vector<RegistrationPtr>&);
+        ~RegistrationGuard();
+
+        void sent()
+        {
+            _sent = true;
+        }
+
+    private:
+
+        LocatorInfo& _info;
+        const std::vector<RegistrationPtr>& _registrations;
+        bool _sent;
+    };
+    friend class RegistrationGuard;
+
+    void sendRegistrations(const Ice::LocatorRegistryPrxPtr&, const std::vector<RegistrationPtr>&);
+
     const Ice::LocatorPrxPtr _locator;
     Ice::LocatorRegistryPrxPtr _locatorRegistry;
     const LocatorTablePtr _table;
     const bool _background;
+    const IceUtil::Time _registrationWindow;
 
     std::map<std::string, RequestPtr> _adapterRequests;
     std::map<Ice::Identity, RequestPtr> _objectRequests;
+
+    IceUtil::Monitor<IceUtil::Mutex> _registrationMonitor;
+    std::vector<RegistrationPtr> _registrations;
+    bool _registering;
+    bool _batchRegistration;
 };
 
 }
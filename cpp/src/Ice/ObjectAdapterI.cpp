@@ -1316,14 +1316,7 @@ ObjectAdapterI::updateLocatorRegistry(const IceInternal::LocatorInfoPtr& locator
 
     try
     {
-        if(_replicaGroupId.empty())
-        {
-            locatorRegistry->setAdapterDirectProxy(_id, proxy);
-        }
-        else
-        {
-            locatorRegistry->setReplicatedAdapterDirectProxy(_id, _replicaGroupId, proxy);
-        }
+        locatorInfo->setAdapterDirectProxy(locatorRegistry, _id, _replicaGroupId, proxy);
     }
     catch(const AdapterNotFoundException&)
     {
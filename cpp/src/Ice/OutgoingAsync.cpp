@@ -20,6 +20,7 @@
 #include <Ice/ConnectionFactory.h>
 #include <Ice/ObjectAdapterFactory.h>
 #include <Ice/LoggerUtil.h>
+#include <IceUtil/InputUtil.h>
 
 using namespace std;
 using namespace Ice;
@@ -39,6 +40,70 @@ const unsigned char OutgoingAsyncBase::Done = 0x4;
 const unsigned char OutgoingAsyncBase::EndCalled = 0x8;
 #endif
 
+namespace
+{
+
+//
+// Updates the latency statistics of the endpoint used by an invocation
+// and clears the connection cached by the proxy if the invocations of
+// the proxy should select their endpoint again. This must be called
+// without the connection locked.
+//
+void
+updateLatency(const InstancePtr& instance, const ObjectPrxPtr& proxy, const RequestHandlerPtr& handler,
+              const EndpointIPtr& endpoint, const IceUtil::Time& rtt, bool failed)
+{
+    try
+    {
+        if(instance->outgoingConnectionFactory()->invocationCompleted(endpoint, rtt, failed) &&
+           proxy->__reference()->getEndpoints().size() != 1)
+        {
+            //
+            // Clear the connection cached by the proxy, the next
+            // invocation selects the endpoint again.
+            //
+            proxy->__updateRequestHandler(handler, 0);
+        }
+    }
+    catch(const CommunicatorDestroyedException&)
+    {
+    }
+}
+
+class LatencyUpdate : public DispatchWorkItem
+{
+public:
+
+    LatencyUpdate(const ConnectionIPtr& connection, const InstancePtr& instance, const ObjectPrxPtr& proxy,
+                  const RequestHandlerPtr& handler, const IceUtil::Time& rtt, bool failed) :
+        DispatchWorkItem(connection),
+        _endpoint(connection->endpoint()),
+        _instance(instance),
+        _proxy(proxy),
+        _handler(handler),
+        _rtt(rtt),
+        _failed(failed)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        updateLatency(_instance, _proxy, _handler, _endpoint, _rtt, _failed);
+    }
+
+private:
+
+    const EndpointIPtr _endpoint;
+    const InstancePtr _instance;
+    const ObjectPrxPtr _proxy;
+    const RequestHandlerPtr _handler;
+    const IceUtil::Time _rtt;
+    const bool _failed;
+};
+
+}
+
 OutgoingAsyncCompletionCallback::~OutgoingAsyncCompletionCallback()
 {
     // Out of line to avoid weak vtable
@@ -93,7 +158,8 @@ OutgoingAsyncBase::invokeSentAsync()
     //
     try
     {
-        _instance->clientThreadPool()->dispatch(new AsynchronousSent(_cachedConnection, ICE_SHARED_FROM_THIS));
+        _instance->dispatch(_instance->clientThreadPool(),
+                            new AsynchronousSent(_cachedConnection, ICE_SHARED_FROM_THIS));
     }
     catch(const Ice::CommunicatorDestroyedException&)
     {
@@ -127,7 +193,8 @@ OutgoingAsyncBase::invokeExceptionAsync()
     // CommunicatorDestroyedCompleted is the only exception that can propagate directly
     // from this method.
     //
-    _instance->clientThreadPool()->dispatch(new AsynchronousException(_cachedConnection, ICE_SHARED_FROM_THIS));
+    _instance->dispatch(_instance->clientThreadPool(),
+                        new AsynchronousException(_cachedConnection, ICE_SHARED_FROM_THIS));
 }
 
 void
@@ -157,7 +224,8 @@ OutgoingAsyncBase::invokeResponseAsync()
     // CommunicatorDestroyedCompleted is the only exception that can propagate directly
     // from this method.
     //
-    _instance->clientThreadPool()->dispatch(new AsynchronousResponse(_cachedConnection, ICE_SHARED_FROM_THIS));
+    _instance->dispatch(_instance->clientThreadPool(),
+                        new AsynchronousResponse(_cachedConnection, ICE_SHARED_FROM_THIS));
 }
 
 void
@@ -785,6 +853,7 @@ ProxyOutgoingAsyncBase::sentImpl(bool done)
         {
             _instance->timer()->cancel(ICE_SHARED_FROM_THIS);
         }
+        _instance->retryBudget()->completed();
     }
     return OutgoingAsyncBase::sentImpl(done);
 }
@@ -806,6 +875,7 @@ ProxyOutgoingAsyncBase::responseImpl(bool ok)
     {
         _instance->timer()->cancel(ICE_SHARED_FROM_THIS);
     }
+    _instance->retryBudget()->completed();
     return OutgoingAsyncBase::responseImpl(ok);
 }
 
@@ -825,7 +895,9 @@ ProxyOutgoingAsyncBase::runTimerTask()
 OutgoingAsync::OutgoingAsync(const ObjectPrxPtr& prx, bool synchronous) :
     ProxyOutgoingAsyncBase(prx),
     _encoding(getCompatibleEncoding(prx->__reference()->getEncoding())),
-    _synchronous(synchronous)
+    _priority(0),
+    _synchronous(synchronous),
+    _invokeResponse(false)
 {
 }
 
@@ -857,22 +929,7 @@ OutgoingAsync::prepare(const string& operation, OperationMode mode, const Contex
 
     Reference* ref = _proxy->__reference().get();
 
-    _os.write(ref->getIdentity());
-
-    //
-    // For compatibility with the old FacetPath.
-    //
-    if(ref->getFacet().empty())
-    {
-        _os.write(static_cast<string*>(0), static_cast<string*>(0));
-    }
-    else
-    {
-        string facet = ref->getFacet();
-        _os.write(&facet, &facet + 1);
-    }
-
-    _os.write(operation, false);
+    ref->streamWriteRequest(&_os, operation);
 
     _os.write(static_cast<Byte>(_mode));
 
@@ -899,6 +956,23 @@ OutgoingAsync::prepare(const string& operation, OperationMode mode, const Contex
             implicitContext->write(prxContext, &_os);
         }
     }
+
+    //
+    // Requests with a "_priority" context entry, set explicitly or with
+    // the proxy context, are sent before the requests with a lower
+    // priority queued on the connection.
+    //
+    const Context& ctx = &context != &Ice::noExplicitContext ? context : ref->getContext()->getValue();
+    Context::const_iterator p = ctx.find("_priority");
+    IceUtil::Int64 priority = 0;
+    if(p != ctx.end() && IceUtilInternal::stringToInt64(p->second, priority))
+    {
+        _priority = static_cast<int>(priority);
+    }
+    else
+    {
+        _priority = 0;
+    }
 }
 
 bool
@@ -907,6 +981,16 @@ OutgoingAsync::sent()
     return ProxyOutgoingAsyncBase::sentImpl(!_proxy->ice_isTwoway()); // done = true if it's not a two-way proxy
 }
 
+bool
+OutgoingAsync::exception(const Exception& ex)
+{
+    if(_sendTime != IceUtil::Time())
+    {
+        updateLatencyAsync(latencySample(), true);
+    }
+    return ProxyOutgoingAsyncBase::exception(ex);
+}
+
 bool
 OutgoingAsync::response()
 {
@@ -923,6 +1007,12 @@ OutgoingAsync::response()
         _childObserver.detach();
     }
 
+    IceUtil::Time rtt;
+    if(_sendTime != IceUtil::Time())
+    {
+        rtt = latencySample();
+    }
+
     Byte replyStatus;
     try
     {
@@ -1044,19 +1134,57 @@ OutgoingAsync::response()
             }
         }
 
-        return responseImpl(replyStatus == replyOK);
+        bool invoke = responseImpl(replyStatus == replyOK);
+        if(rtt != IceUtil::Time())
+        {
+            //
+            // The latency statistics are updated by invokeResponse once
+            // the connection is unlocked.
+            //
+            _rtt = rtt;
+            _invokeResponse = invoke;
+            return true;
+        }
+        return invoke;
     }
     catch(const Exception& ex)
     {
+        if(rtt != IceUtil::Time())
+        {
+            updateLatencyAsync(rtt, false);
+        }
         return exception(ex);
     }
 }
 
+void
+OutgoingAsync::invokeResponse()
+{
+    if(_rtt != IceUtil::Time())
+    {
+        ConnectionIPtr connection = ICE_DYNAMIC_CAST(ConnectionI, _cachedConnection);
+        if(connection)
+        {
+            updateLatency(_instance, _proxy, _handler, connection->endpoint(), _rtt, false);
+        }
+        _rtt = IceUtil::Time();
+        if(!_invokeResponse)
+        {
+            return;
+        }
+    }
+    ProxyOutgoingAsyncBase::invokeResponse();
+}
+
 AsyncStatus
 OutgoingAsync::invokeRemote(const ConnectionIPtr& connection, bool compress, bool response)
 {
     _cachedConnection = connection;
-    return connection->sendAsyncRequest(ICE_SHARED_FROM_THIS, compress, response, 0);
+    if(response && _proxy->__reference()->getLatencySelection())
+    {
+        _sendTime = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    }
+    return connection->sendAsyncRequest(ICE_SHARED_FROM_THIS, compress, response, 0, _priority);
 }
 
 AsyncStatus
@@ -1065,6 +1193,37 @@ OutgoingAsync::invokeCollocated(CollocatedRequestHandler* handler)
     return handler->invokeAsyncRequest(this, 0, _synchronous);
 }
 
+IceUtil::Time
+OutgoingAsync::latencySample()
+{
+    IceUtil::Time rtt = IceUtil::Time::now(IceUtil::Time::Monotonic) - _sendTime;
+    _sendTime = IceUtil::Time();
+    return rtt;
+}
+
+void
+OutgoingAsync::updateLatencyAsync(const IceUtil::Time& rtt, bool failed)
+{
+    //
+    // This can be called with the connection locked, the latency
+    // statistics are updated by the client thread pool.
+    //
+    ConnectionIPtr connection = ICE_DYNAMIC_CAST(ConnectionI, _cachedConnection);
+    if(!connection)
+    {
+        return;
+    }
+
+    try
+    {
+        _instance->dispatch(_instance->clientThreadPool(),
+                            new LatencyUpdate(connection, _instance, _proxy, _handler, rtt, failed));
+    }
+    catch(const CommunicatorDestroyedException&)
+    {
+    }
+}
+
 void
 OutgoingAsync::abort(const Exception& ex)
 {
@@ -1100,6 +1259,19 @@ OutgoingAsync::invoke(const string& operation)
     // exception.
     //
     invokeImpl(true); // userThread = true
+
+    if(_synchronous && _sentSynchronously && mode == Reference::ModeTwoway)
+    {
+        //
+        // The reply of a synchronous twoway invocation sent by this
+        // thread can be read by this thread, see ConnectionI::readReply.
+        //
+        ConnectionIPtr connection = ICE_DYNAMIC_CAST(ConnectionI, _cachedConnection);
+        if(connection)
+        {
+            connection->readReply(this);
+        }
+    }
 }
 
 #ifdef ICE_CPP11_MAPPING
@@ -1384,6 +1556,16 @@ CommunicatorFlushBatchAsync::flushConnection(const ConnectionIPtr& con)
         InvocationObserver& _observer;
     };
 
+    //
+    // Don't create the batch request queue of connections which were
+    // never used for batch requests.
+    //
+    BatchRequestQueuePtr batchRequestQueue = con->getBatchRequestQueue(false);
+    if(!batchRequestQueue)
+    {
+        return;
+    }
+
     {
         Lock sync(_m);
         ++_useCount;
@@ -1392,7 +1574,7 @@ CommunicatorFlushBatchAsync::flushConnection(const ConnectionIPtr& con)
     try
     {
         OutgoingAsyncBasePtr flushBatch = ICE_MAKE_SHARED(FlushBatch, ICE_SHARED_FROM_THIS, _instance, _observer);
-        int batchRequestNum = con->getBatchRequestQueue()->swap(flushBatch->getOs());
+        int batchRequestNum = batchRequestQueue->swap(flushBatch->getOs());
         if(batchRequestNum == 0)
         {
             flushBatch->sent();
@@ -23,6 +23,13 @@
 #include <Ice/StringConverter.h>
 #include <iterator>
 
+#ifdef _WIN32
+#   include <io.h>
+#else
+#   include <unistd.h>
+#   include <errno.h>
+#endif
+
 using namespace std;
 using namespace Ice;
 using namespace IceInternal;
@@ -77,20 +84,32 @@ Ice::OutputStream::OutputStream() :
     _closure(0),
     _encoding(currentEncoding),
     _format(CompactFormat),
-    _currentEncaps(0)
+    _currentEncaps(0),
+    _fileFd(-1),
+    _fileOffset(0),
+    _fileLength(0),
+    _filePos(0)
 {
 }
 
 Ice::OutputStream::OutputStream(const CommunicatorPtr& communicator) :
     _closure(0),
-    _currentEncaps(0)
+    _currentEncaps(0),
+    _fileFd(-1),
+    _fileOffset(0),
+    _fileLength(0),
+    _filePos(0)
 {
     initialize(communicator);
 }
 
 Ice::OutputStream::OutputStream(const CommunicatorPtr& communicator, const EncodingVersion& encoding) :
     _closure(0),
-    _currentEncaps(0)
+    _currentEncaps(0),
+    _fileFd(-1),
+    _fileOffset(0),
+    _fileLength(0),
+    _filePos(0)
 {
     initialize(communicator, encoding);
 }
@@ -99,7 +118,11 @@ Ice::OutputStream::OutputStream(const CommunicatorPtr& communicator, const Encod
                                 const pair<const Byte*, const Byte*>& buf) :
     Buffer(buf.first, buf.second),
     _closure(0),
-    _currentEncaps(0)
+    _currentEncaps(0),
+    _fileFd(-1),
+    _fileOffset(0),
+    _fileLength(0),
+    _filePos(0)
 {
     initialize(communicator, encoding);
     b.reset();
@@ -107,7 +130,11 @@ Ice::OutputStream::OutputStream(const CommunicatorPtr& communicator, const Encod
 
 Ice::OutputStream::OutputStream(Instance* instance, const EncodingVersion& encoding) :
     _closure(0),
-    _currentEncaps(0)
+    _currentEncaps(0),
+    _fileFd(-1),
+    _fileOffset(0),
+    _fileLength(0),
+    _filePos(0)
 {
     initialize(instance, encoding);
 }
@@ -147,6 +174,11 @@ Ice::OutputStream::clear()
         _currentEncaps = _currentEncaps->previous;
         delete oldEncaps;
     }
+
+    if(_fileFd >= 0)
+    {
+        closeFile();
+    }
 }
 
 void
@@ -178,6 +210,10 @@ Ice::OutputStream::swap(OutputStream& other)
     std::swap(_closure, other._closure);
     std::swap(_encoding, other._encoding);
     std::swap(_format, other._format);
+    std::swap(_fileFd, other._fileFd);
+    std::swap(_fileOffset, other._fileOffset);
+    std::swap(_fileLength, other._fileLength);
+    std::swap(_filePos, other._filePos);
 
     //
     // Swap is never called for streams that have encapsulations being written. However,
@@ -866,12 +902,14 @@ Ice::OutputStream::writeOptImpl(Int tag, OptionalFormat type)
 void
 Ice::OutputStream::finished(vector<Byte>& bytes)
 {
+    copyFile();
     vector<Byte>(b.begin(), b.end()).swap(bytes);
 }
 
 pair<const Byte*, const Byte*>
 Ice::OutputStream::finished()
 {
+    copyFile();
     if(b.empty())
     {
         return pair<const Byte*, const Byte*>(reinterpret_cast<Ice::Byte*>(0), reinterpret_cast<Ice::Byte*>(0));
@@ -882,6 +920,137 @@ Ice::OutputStream::finished()
     }
 }
 
+void
+Ice::OutputStream::writeFile(int fd, Long offset, Long length)
+{
+    if(fd < 0 || offset < 0 || length < 0 || length > static_cast<Long>(0x7fffffff))
+    {
+        throw MarshalException(__FILE__, __LINE__, "invalid file range");
+    }
+
+    //
+    // Only one range is sent after the buffer, a previous range is
+    // copied into the buffer since data now follows it.
+    //
+    copyFile();
+
+    writeSize(static_cast<Int>(length));
+    if(length == 0)
+    {
+        return;
+    }
+
+#ifdef _WIN32
+    _fileFd = _dup(fd);
+#else
+    _fileFd = ::dup(fd);
+#endif
+    if(_fileFd < 0)
+    {
+        throw FileException(__FILE__, __LINE__, IceInternal::getSystemErrno(), "");
+    }
+    _fileOffset = offset;
+    _fileLength = length;
+    _filePos = b.size();
+
+    //
+    // Values and exceptions are marshaled with sizes which can't
+    // account for a range sent after the buffer.
+    //
+    if(!_currentEncaps || _currentEncaps->encoder)
+    {
+        copyFile();
+    }
+}
+
+void
+Ice::OutputStream::copyFile()
+{
+    if(_fileFd < 0)
+    {
+        return;
+    }
+
+    //
+    // Insert the file range at its position, data written after the
+    // range is moved after it.
+    //
+    Container::size_type sz = static_cast<Container::size_type>(_fileLength);
+    Container::size_type tail = b.size() - _filePos;
+    resize(b.size() + sz);
+    if(tail > 0)
+    {
+        memmove(&b[_filePos + sz], &b[_filePos], tail);
+    }
+
+    Container::size_type pos = 0;
+    while(pos < sz)
+    {
+        Long offset = _fileOffset + static_cast<Long>(pos);
+#ifdef _WIN32
+        int ret = -1;
+        if(_lseeki64(_fileFd, offset, SEEK_SET) == offset)
+        {
+            ret = _read(_fileFd, &b[_filePos + pos], static_cast<unsigned int>(min<Container::size_type>(sz - pos,
+                                                                                                       0x40000000)));
+        }
+#else
+        ssize_t ret = ::pread(_fileFd, &b[_filePos + pos], sz - pos, static_cast<off_t>(offset));
+        if(ret < 0 && errno == EINTR)
+        {
+            continue;
+        }
+#endif
+        if(ret <= 0)
+        {
+            //
+            // The file is shorter than the range or can't be read.
+            // The stream is restored and keeps the range, a retry of
+            // the invocation fails the same way instead of sending
+            // the partially read range.
+            //
+            int error = ret < 0 ? IceInternal::getSystemErrno() : 0;
+            if(tail > 0)
+            {
+                memmove(&b[_filePos], &b[_filePos + sz], tail);
+            }
+            resize(_filePos + tail);
+            throw FileException(__FILE__, __LINE__, error, "");
+        }
+        pos += static_cast<Container::size_type>(ret);
+    }
+    closeFile();
+}
+
+Int
+Ice::OutputStream::endFileEncapsulation(Int sz)
+{
+    if(b.size() != _filePos)
+    {
+        //
+        // Data was written after the file range, it's not sent after
+        // the buffer.
+        //
+        copyFile();
+        return static_cast<Int>(b.size() - _currentEncaps->start);
+    }
+    return sz + static_cast<Int>(_fileLength);
+}
+
+void
+Ice::OutputStream::closeFile()
+{
+#ifdef _WIN32
+    _close(_fileFd);
+#else
+    ::close(_fileFd);
+#endif
+    _fileFd = -1;
+    _fileOffset = 0;
+    _fileLength = 0;
+    _filePos = 0;
+}
+
 void
 Ice::OutputStream::throwEncapsulationException(const char* file, int line)
 {
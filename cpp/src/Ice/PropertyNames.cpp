@@ -6,7 +6,7 @@
 // ICE_LICENSE file included in this distribution.
 //
 // **********************************************************************
-// Generated by makeprops.py from file ../config/PropertyNames.xml, Wed Oct  5 19:04:47 2016
+// Generated by makeprops.py from file ../config/PropertyNames.xml, Sun Oct 18 22:33:13 2026
 
 // IMPORTANT: Do not edit this file -- any edits made here will be lost!
 
@@ -57,6 +57,8 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.Admin.Router.Context.*", false, 0),
     IceInternal::Property("Ice.Admin.Router", false, 0),
     IceInternal::Property("Ice.Admin.ProxyOptions", false, 0),
+    IceInternal::Property("Ice.Admin.ThreadPool.Adaptive", false, 0),
+    IceInternal::Property("Ice.Admin.ThreadPool.CallerRuns", false, 0),
     IceInternal::Property("Ice.Admin.ThreadPool.Size", false, 0),
     IceInternal::Property("Ice.Admin.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("Ice.Admin.ThreadPool.SizeWarn", false, 0),
@@ -77,8 +79,13 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.BatchAutoFlush", true, 0),
     IceInternal::Property("Ice.BatchAutoFlushSize", false, 0),
     IceInternal::Property("Ice.ChangeUser", false, 0),
+    IceInternal::Property("Ice.CircuitBreaker.Threshold", false, 0),
+    IceInternal::Property("Ice.CircuitBreaker.Timeout", false, 0),
     IceInternal::Property("Ice.ClientAccessPolicyProtocol", false, 0),
+    IceInternal::Property("Ice.Compression.Adaptive", false, 0),
+    IceInternal::Property("Ice.Compression.Auto", false, 0),
     IceInternal::Property("Ice.Compression.Level", false, 0),
+    IceInternal::Property("Ice.Compression.MaxRatio", false, 0),
     IceInternal::Property("Ice.CollectObjects", false, 0),
     IceInternal::Property("Ice.Config", false, 0),
     IceInternal::Property("Ice.ConsoleListener", false, 0),
@@ -122,6 +129,8 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.InitPlugins", false, 0),
     IceInternal::Property("Ice.IPv4", false, 0),
     IceInternal::Property("Ice.IPv6", false, 0),
+    IceInternal::Property("Ice.LocatorCacheFile", false, 0),
+    IceInternal::Property("Ice.LocatorRegistrationWindow", false, 0),
     IceInternal::Property("Ice.LogFile", false, 0),
     IceInternal::Property("Ice.LogFile.SizeMax", false, 0),
     IceInternal::Property("Ice.LogStdErr.Convert", false, 0),
@@ -141,13 +150,18 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.PrintProcessId", false, 0),
     IceInternal::Property("Ice.PrintStackTraces", false, 0),
     IceInternal::Property("Ice.ProgramName", false, 0),
+    IceInternal::Property("Ice.RetryBudget", false, 0),
+    IceInternal::Property("Ice.RetryBudget.Reserve", false, 0),
     IceInternal::Property("Ice.RetryIntervals", false, 0),
+    IceInternal::Property("Ice.RetryJitter", false, 0),
     IceInternal::Property("Ice.ServerIdleTime", false, 0),
     IceInternal::Property("Ice.SOCKSProxyHost", false, 0),
     IceInternal::Property("Ice.SOCKSProxyPort", false, 0),
     IceInternal::Property("Ice.StdErr", false, 0),
     IceInternal::Property("Ice.StdOut", false, 0),
     IceInternal::Property("Ice.SyslogFacility", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Client.Adaptive", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Client.CallerRuns", false, 0),
     IceInternal::Property("Ice.ThreadPool.Client.Size", false, 0),
     IceInternal::Property("Ice.ThreadPool.Client.SizeMax", false, 0),
     IceInternal::Property("Ice.ThreadPool.Client.SizeWarn", false, 0),
@@ -155,6 +169,8 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.ThreadPool.Client.Serialize", false, 0),
     IceInternal::Property("Ice.ThreadPool.Client.ThreadIdleTime", false, 0),
     IceInternal::Property("Ice.ThreadPool.Client.ThreadPriority", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Server.Adaptive", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Server.CallerRuns", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.Size", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.SizeMax", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.SizeWarn", false, 0),
@@ -239,6 +255,8 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Multicast.Router.Context.*", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Router", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.ProxyOptions", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.ThreadPool.Adaptive", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.ThreadPool.CallerRuns", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.Size", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.SizeWarn", false, 0),
@@ -276,6 +294,8 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Reply.Router.Context.*", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Router", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ProxyOptions", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.ThreadPool.Adaptive", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.ThreadPool.CallerRuns", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.Size", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.SizeWarn", false, 0),
@@ -313,6 +333,8 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Locator.Router.Context.*", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Router", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ProxyOptions", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.ThreadPool.Adaptive", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.ThreadPool.CallerRuns", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.Size", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.SizeWarn", false, 0),
@@ -366,6 +388,8 @@ const IceInternal::Property IceGridDiscoveryPropsData[] =
     IceInternal::Property("IceGridDiscovery.Reply.Router.Context.*", false, 0),
     IceInternal::Property("IceGridDiscovery.Reply.Router", false, 0),
     IceInternal::Property("IceGridDiscovery.Reply.ProxyOptions", false, 0),
+    IceInternal::Property("IceGridDiscovery.Reply.ThreadPool.Adaptive", false, 0),
+    IceInternal::Property("IceGridDiscovery.Reply.ThreadPool.CallerRuns", false, 0),
     IceInternal::Property("IceGridDiscovery.Reply.ThreadPool.Size", false, 0),
     IceInternal::Property("IceGridDiscovery.Reply.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceGridDiscovery.Reply.ThreadPool.SizeWarn", false, 0),
@@ -403,6 +427,8 @@ const IceInternal::Property IceGridDiscoveryPropsData[] =
     IceInternal::Property("IceGridDiscovery.Locator.Router.Context.*", false, 0),
     IceInternal::Property("IceGridDiscovery.Locator.Router", false, 0),
     IceInternal::Property("IceGridDiscovery.Locator.ProxyOptions", false, 0),
+    IceInternal::Property("IceGridDiscovery.Locator.ThreadPool.Adaptive", false, 0),
+    IceInternal::Property("IceGridDiscovery.Locator.ThreadPool.CallerRuns", false, 0),
     IceInternal::Property("IceGridDiscovery.Locator.ThreadPool.Size", false, 0),
     IceInternal::Property("IceGridDiscovery.Locator.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceGridDiscovery.Locator.ThreadPool.SizeWarn", false, 0),
@@ -444,6 +470,7 @@ const IceInternal::Property IceBoxPropsData[] =
     IceInternal::Property("IceBox.ServiceManager.ThreadPool.StackSize", true, 0),
     IceInternal::Property("IceBox.Trace.ServiceObserver", false, 0),
     IceInternal::Property("IceBox.UseSharedCommunicator.*", false, 0),
+    IceInternal::Property("IceBox.UseSharedRuntime", false, 0),
 };
 
 const IceInternal::PropertyArray
@@ -510,6 +537,8 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Router.Context.*", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Router", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ProxyOptions", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.Adaptive", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.CallerRuns", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.Size", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.SizeWarn", false, 0),
@@ -557,6 +586,8 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.AdminRouter.Router.Context.*", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Router", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.ProxyOptions", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.ThreadPool.Adaptive", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.ThreadPool.CallerRuns", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.Size", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.SizeWarn", false, 0),
@@ -595,6 +626,8 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Node.Router.Context.*", false, 0),
     IceInternal::Property("IceGrid.Node.Router", false, 0),
     IceInternal::Property("IceGrid.Node.ProxyOptions", false, 0),
+    IceInternal::Property("IceGrid.Node.ThreadPool.Adaptive", false, 0),
+    IceInternal::Property("IceGrid.Node.ThreadPool.CallerRuns", false, 0),
     IceInternal::Property("IceGrid.Node.ThreadPool.Size", false, 0),
     IceInternal::Property("IceGrid.Node.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceGrid.Node.ThreadPool.SizeWarn", false, 0),
@@ -672,6 +705,8 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Router.Context.*", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ProxyOptions", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.Adaptive", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.CallerRuns", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.Size", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.SizeWarn", false, 0),
@@ -719,6 +754,8 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Client.Router.Context.*", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.ProxyOptions", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.ThreadPool.Adaptive", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.ThreadPool.CallerRuns", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.Size", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.SizeWarn", false, 0),
@@ -758,6 +795,8 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Discovery.Router.Context.*", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ProxyOptions", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.Adaptive", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.CallerRuns", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.Size", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.SizeWarn", false, 0),
@@ -800,6 +839,8 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Internal.Router.Context.*", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.ProxyOptions", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.Adaptive", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.CallerRuns", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.Size", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.SizeWarn", false, 0),
@@ -823,6 +864,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.PermissionsVerifier", false, 0),
     IceInternal::Property("IceGrid.Registry.ReplicaName", false, 0),
     IceInternal::Property("IceGrid.Registry.ReplicaSessionTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.RollingUpdate.HealthCheck", false, 0),
+    IceInternal::Property("IceGrid.Registry.RollingUpdate.NodeConcurrency", false, 0),
+    IceInternal::Property("IceGrid.Registry.RollingUpdate.ReplicaGroupConcurrency", false, 0),
     IceInternal::Property("IceGrid.Registry.RequireNodeCertCN", false, 0),
     IceInternal::Property("IceGrid.Registry.RequireReplicaCertCN", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ACM.Timeout", false, 0),
@@ -854,6 +898,8 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Server.Router.Context.*", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ProxyOptions", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.ThreadPool.Adaptive", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.ThreadPool.CallerRuns", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.Size", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.SizeWarn", false, 0),
@@ -892,6 +938,8 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.SessionManager.Router.Context.*", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ProxyOptions", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.Adaptive", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.CallerRuns", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.Size", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.SizeWarn", false, 0),
@@ -961,6 +1009,8 @@ const IceInternal::Property IcePatch2PropsData[] =
     IceInternal::Property("IcePatch2.Router.Context.*", false, 0),
     IceInternal::Property("IcePatch2.Router", false, 0),
     IceInternal::Property("IcePatch2.ProxyOptions", false, 0),
+    IceInternal::Property("IcePatch2.ThreadPool.Adaptive", false, 0),
+    IceInternal::Property("IcePatch2.ThreadPool.CallerRuns", false, 0),
     IceInternal::Property("IcePatch2.ThreadPool.Size", false, 0),
     IceInternal::Property("IcePatch2.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IcePatch2.ThreadPool.SizeWarn", false, 0),
@@ -1032,6 +1082,7 @@ const IceInternal::Property IceSSLPropsData[] =
     IceInternal::Property("IceSSL.TruststorePassword", false, 0),
     IceInternal::Property("IceSSL.TruststoreType", false, 0),
     IceInternal::Property("IceSSL.UsePlatformCAs", false, 0),
+    IceInternal::Property("IceSSL.VerifyCacheSize", false, 0),
     IceInternal::Property("IceSSL.VerifyDepthMax", false, 0),
     IceInternal::Property("IceSSL.VerifyPeer", false, 0),
 };
@@ -1093,6 +1144,8 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Client.Router.Context.*", false, 0),
     IceInternal::Property("Glacier2.Client.Router", false, 0),
     IceInternal::Property("Glacier2.Client.ProxyOptions", false, 0),
+    IceInternal::Property("Glacier2.Client.ThreadPool.Adaptive", false, 0),
+    IceInternal::Property("Glacier2.Client.ThreadPool.CallerRuns", false, 0),
     IceInternal::Property("Glacier2.Client.ThreadPool.Size", false, 0),
     IceInternal::Property("Glacier2.Client.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("Glacier2.Client.ThreadPool.SizeWarn", false, 0),
@@ -1104,10 +1157,22 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Client.AlwaysBatch", false, 0),
     IceInternal::Property("Glacier2.Client.Buffered", false, 0),
     IceInternal::Property("Glacier2.Client.ForwardContext", false, 0),
+    IceInternal::Property("Glacier2.Client.MaxQueued", false, 0),
+    IceInternal::Property("Glacier2.Client.Password.MaxQueued", false, 0),
+    IceInternal::Property("Glacier2.Client.Password.RateLimit", false, 0),
+    IceInternal::Property("Glacier2.Client.Password.RateLimit.Burst", false, 0),
+    IceInternal::Property("Glacier2.Client.Password.Weight", false, 0),
+    IceInternal::Property("Glacier2.Client.RateLimit", false, 0),
+    IceInternal::Property("Glacier2.Client.RateLimit.Burst", false, 0),
+    IceInternal::Property("Glacier2.Client.SSL.MaxQueued", false, 0),
+    IceInternal::Property("Glacier2.Client.SSL.RateLimit", false, 0),
+    IceInternal::Property("Glacier2.Client.SSL.RateLimit.Burst", false, 0),
+    IceInternal::Property("Glacier2.Client.SSL.Weight", false, 0),
     IceInternal::Property("Glacier2.Client.SleepTime", false, 0),
     IceInternal::Property("Glacier2.Client.Trace.Override", false, 0),
     IceInternal::Property("Glacier2.Client.Trace.Reject", false, 0),
     IceInternal::Property("Glacier2.Client.Trace.Request", false, 0),
+    IceInternal::Property("Glacier2.Client.Weight", false, 0),
     IceInternal::Property("Glacier2.CryptPasswords", false, 0),
     IceInternal::Property("Glacier2.Filter.Address.Reject", false, 0),
     IceInternal::Property("Glacier2.Filter.Address.Accept", false, 0),
@@ -1168,6 +1233,8 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Server.Router.Context.*", false, 0),
     IceInternal::Property("Glacier2.Server.Router", false, 0),
     IceInternal::Property("Glacier2.Server.ProxyOptions", false, 0),
+    IceInternal::Property("Glacier2.Server.ThreadPool.Adaptive", false, 0),
+    IceInternal::Property("Glacier2.Server.ThreadPool.CallerRuns", false, 0),
     IceInternal::Property("Glacier2.Server.ThreadPool.Size", false, 0),
     IceInternal::Property("Glacier2.Server.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("Glacier2.Server.ThreadPool.SizeWarn", false, 0),
@@ -6,7 +6,7 @@
 // ICE_LICENSE file included in this distribution.
 //
 // **********************************************************************
-// Generated by makeprops.py from file ../config/PropertyNames.xml, Wed Oct  5 19:04:47 2016
+// Generated by makeprops.py from file ../config/PropertyNames.xml, Sun Oct 18 22:33:13 2026
 
 // IMPORTANT: Do not edit this file -- any edits made here will be lost!
 
@@ -125,6 +125,6 @@ void
 IceInternal::ProtocolInstance::resolve(const string& host, int port, EndpointSelectionType type,
                                        const IPEndpointIPtr& endpt, const EndpointI_connectorsPtr& cb) const
 {
-    _instance->endpointHostResolver()->resolve(host, port, type, endpt, cb);
+    _instance->endpointHostResolver()->resolve(_instance, host, port, type, endpt, cb);
 }
 
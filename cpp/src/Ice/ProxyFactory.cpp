@@ -9,6 +9,7 @@
 
 #include <IceUtil/Thread.h>
 #include <IceUtil/Time.h>
+#include <IceUtil/Random.h>
 #include <Ice/ProxyFactory.h>
 #include <Ice/Instance.h>
 #include <Ice/Proxy.h>
@@ -22,6 +23,7 @@
 #include <Ice/TraceLevels.h>
 #include <Ice/LocalException.h>
 #include <Ice/OutgoingAsync.h>
+#include <Ice/RetryQueue.h>
 
 using namespace std;
 using namespace Ice;
@@ -242,6 +244,29 @@ IceInternal::ProxyFactory::checkRetryAfterException(const LocalException& ex, co
     else
     {
         interval = _retryIntervals[cnt - 1];
+        if(interval > 0 && _retryJitter)
+        {
+            //
+            // Wait between half the interval and the interval, so
+            // that invocations which failed together don't all retry
+            // at the same time.
+            //
+            interval = interval / 2 + static_cast<int>(IceUtilInternal::random(interval / 2 + 1));
+        }
+    }
+
+    //
+    // Close connection exceptions are caused by a graceful shutdown
+    // of the server and aren't charged to the retry budget.
+    //
+    if(!dynamic_cast<const CloseConnectionException*>(&ex) && !_instance->retryBudget()->withdraw())
+    {
+        if(traceLevels->retry >= 1)
+        {
+            Trace out(logger, traceLevels->retryCat);
+            out << "cannot retry operation call because the retry budget is exhausted\n" << ex;
+        }
+        ex.ice_throw();
     }
 
     if(traceLevels->retry >= 1)
@@ -258,7 +283,8 @@ IceInternal::ProxyFactory::checkRetryAfterException(const LocalException& ex, co
 }
 
 IceInternal::ProxyFactory::ProxyFactory(const InstancePtr& instance) :
-    _instance(instance)
+    _instance(instance),
+    _retryJitter(instance->initializationData().properties->getPropertyAsInt("Ice.RetryJitter") > 0)
 {
     StringSeq retryValues = _instance->initializationData().properties->getPropertyAsList("Ice.RetryIntervals");
     if(retryValues.size() == 0)
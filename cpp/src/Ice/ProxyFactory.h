@@ -55,6 +55,7 @@ private:
 
     InstancePtr _instance;
     std::vector<int> _retryIntervals;
+    const bool _retryJitter;
 };
 
 }
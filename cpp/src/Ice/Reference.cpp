@@ -31,7 +31,6 @@
 
 #include <IceUtil/StringUtil.h>
 #include <IceUtil/Random.h>
-#include <IceUtil/MutexPtrLock.h>
 
 #include <functional>
 #include <algorithm>
@@ -45,26 +44,6 @@ IceUtil::Shared* IceInternal::upCast(IceInternal::Reference* p) { return p; }
 namespace
 {
 
-IceUtil::Mutex* hashMutex = 0;
-
-class Init
-{
-public:
-
-    Init()
-    {
-        hashMutex = new IceUtil::Mutex;
-    }
-
-    ~Init()
-    {
-        delete hashMutex;
-        hashMutex = 0;
-    }
-};
-
-Init init;
-
 struct RandomNumberGenerator : public std::unary_function<ptrdiff_t, ptrdiff_t>
 {
     ptrdiff_t operator()(ptrdiff_t d)
@@ -122,6 +101,7 @@ IceInternal::Reference::changeIdentity(const Identity& newIdentity) const
     }
     ReferencePtr r = _instance->referenceFactory()->copy(this);
     r->_identity = newIdentity;
+    r->initRequestPrefix();
     return r;
 }
 
@@ -134,6 +114,7 @@ IceInternal::Reference::changeFacet(const string& newFacet) const
     }
     ReferencePtr r = _instance->referenceFactory()->copy(this);
     r->_facet = newFacet;
+    r->initRequestPrefix();
     return r;
 }
 
@@ -177,13 +158,23 @@ IceInternal::Reference::changeCompress(bool newCompress) const
 Int
 Reference::hash() const
 {
-    IceUtilInternal::MutexPtrLock<IceUtil::Mutex> lock(hashMutex);
-    if(!_hashInitialized)
+    //
+    // The hash is computed on first use and published with atomics, threads
+    // which compute it concurrently store the same value.
+    //
+    if(!_hashInitialized.load())
     {
-        _hashValue = hashInit();
-        _hashInitialized = true;
+        _hashValue.exchange(hashInit());
+        _hashInitialized.exchange(1);
     }
-    return _hashValue;
+    return _hashValue.load();
+}
+
+void
+IceInternal::Reference::streamWriteRequest(OutputStream* s, const string& operation) const
+{
+    s->writeBlob(_requestPrefix);
+    s->write(operation, false);
 }
 
 void
@@ -516,7 +507,8 @@ IceInternal::Reference::Reference(const InstancePtr& instance,
                                   const EncodingVersion& encoding,
                                   int invocationTimeout,
                                   const Ice::Context& ctx) :
-    _hashInitialized(false),
+    _hashValue(0),
+    _hashInitialized(0),
     _instance(instance),
     _communicator(communicator),
     _mode(mode),
@@ -530,10 +522,12 @@ IceInternal::Reference::Reference(const InstancePtr& instance,
     _overrideCompress(false),
     _compress(false)
 {
+    initRequestPrefix();
 }
 
 IceInternal::Reference::Reference(const Reference& r) :
-    _hashInitialized(false),
+    _hashValue(0),
+    _hashInitialized(0),
     _instance(r._instance),
     _communicator(r._communicator),
     _mode(r._mode),
@@ -544,11 +538,35 @@ IceInternal::Reference::Reference(const Reference& r) :
     _protocol(r._protocol),
     _encoding(r._encoding),
     _invocationTimeout(r._invocationTimeout),
+    _requestPrefix(r._requestPrefix),
     _overrideCompress(r._overrideCompress),
     _compress(r._compress)
 {
 }
 
+void
+IceInternal::Reference::initRequestPrefix()
+{
+    OutputStream os(_instance.get(), Ice::currentProtocolEncoding);
+    os.write(_identity);
+
+    //
+    // For compatibility with the old FacetPath.
+    //
+    if(_facet.empty())
+    {
+        os.write(static_cast<string*>(0), static_cast<string*>(0));
+    }
+    else
+    {
+        os.write(&_facet, &_facet + 1);
+    }
+
+    vector<Byte> prefix;
+    os.finished(prefix);
+    _requestPrefix.swap(prefix);
+}
+
 int
 IceInternal::Reference::hashInit() const
 {
@@ -623,6 +641,12 @@ IceInternal::FixedReference::getEndpointSelection() const
     return Random;
 }
 
+bool
+IceInternal::FixedReference::getLatencySelection() const
+{
+    return false;
+}
+
 int
 IceInternal::FixedReference::getLocatorCacheTimeout() const
 {
@@ -890,6 +914,7 @@ IceInternal::RoutableReference::RoutableReference(const InstancePtr& instance,
                                                   bool cacheConnection,
                                                   bool preferSecure,
                                                   EndpointSelectionType endpointSelection,
+                                                  bool latencySelection,
                                                   int locatorCacheTimeout,
                                                   int invocationTimeout,
                                                   const Ice::Context& ctx) :
@@ -902,6 +927,7 @@ IceInternal::RoutableReference::RoutableReference(const InstancePtr& instance,
     _cacheConnection(cacheConnection),
     _preferSecure(preferSecure),
     _endpointSelection(endpointSelection),
+    _latencySelection(latencySelection),
     _locatorCacheTimeout(locatorCacheTimeout),
     _overrideTimeout(false),
     _timeout(-1)
@@ -957,6 +983,12 @@ IceInternal::RoutableReference::getEndpointSelection() const
     return _endpointSelection;
 }
 
+bool
+IceInternal::RoutableReference::getLatencySelection() const
+{
+    return _latencySelection;
+}
+
 int
 IceInternal::RoutableReference::getLocatorCacheTimeout() const
 {
@@ -1093,12 +1125,13 @@ IceInternal::RoutableReference::changePreferSecure(bool newPreferSecure) const
 ReferencePtr
 IceInternal::RoutableReference::changeEndpointSelection(EndpointSelectionType newType) const
 {
-    if(newType == _endpointSelection)
+    if(newType == _endpointSelection && !_latencySelection)
     {
         return RoutableReferencePtr(const_cast<RoutableReference*>(this));
     }
     RoutableReferencePtr r = RoutableReferencePtr::dynamicCast(getInstance()->referenceFactory()->copy(this));
     r->_endpointSelection = newType;
+    r->_latencySelection = false;
     return r;
 }
 
@@ -1253,7 +1286,14 @@ IceInternal::RoutableReference::toProperty(const string& prefix) const
     properties[prefix + ".CollocationOptimized"] = _collocationOptimized ? "1" : "0";
     properties[prefix + ".ConnectionCached"] = _cacheConnection ? "1" : "0";
     properties[prefix + ".PreferSecure"] = _preferSecure ? "1" : "0";
-    properties[prefix + ".EndpointSelection"] = _endpointSelection == Random ? "Random" : "Ordered";
+    if(_latencySelection)
+    {
+        properties[prefix + ".EndpointSelection"] = "Latency";
+    }
+    else
+    {
+        properties[prefix + ".EndpointSelection"] = _endpointSelection == Random ? "Random" : "Ordered";
+    }
     {
         ostringstream s;
         s << _locatorCacheTimeout;
@@ -1325,6 +1365,10 @@ IceInternal::RoutableReference::operator==(const Reference& r) const
     {
         return false;
     }
+    if(_latencySelection != rhs->_latencySelection)
+    {
+        return false;
+    }
     if(_connectionId != rhs->_connectionId)
     {
         return false;
@@ -1421,6 +1465,14 @@ IceInternal::RoutableReference::operator<(const Reference& r) const
     {
         return false;
     }
+    if(!_latencySelection && rhs->_latencySelection)
+    {
+        return true;
+    }
+    else if(_latencySelection && !rhs->_latencySelection)
+    {
+        return false;
+    }
     if(_connectionId < rhs->_connectionId)
     {
         return true;
@@ -1732,7 +1784,8 @@ IceInternal::RoutableReference::createConnection(const vector<EndpointIPtr>& all
         // Get an existing connection or create one if there's no
         // existing connection to one of the given endpoints.
         //
-        factory->create(endpoints, false, getEndpointSelection(), new CB1(_routerInfo, callback));
+        factory->create(endpoints, false, getEndpointSelection(), getLatencySelection(),
+                        new CB1(_routerInfo, callback));
         return;
     }
     else
@@ -1775,7 +1828,8 @@ IceInternal::RoutableReference::createConnection(const vector<EndpointIPtr>& all
                 endpoint.push_back(_endpoints[_i]);
 
                 OutgoingConnectionFactoryPtr factory = _reference->getInstance()->outgoingConnectionFactory();
-                factory->create(endpoint, more, _reference->getEndpointSelection(), this);
+                factory->create(endpoint, more, _reference->getEndpointSelection(),
+                                _reference->getLatencySelection(), this);
             }
 
             CB2(const RoutableReferencePtr& reference, const vector<EndpointIPtr>& endpoints,
@@ -1807,7 +1861,8 @@ IceInternal::RoutableReference::createConnection(const vector<EndpointIPtr>& all
         vector<EndpointIPtr> endpt;
         endpt.push_back(endpoints[0]);
         RoutableReference* self = const_cast<RoutableReference*>(this);
-        factory->create(endpt, true, getEndpointSelection(), new CB2(self, endpoints, callback));
+        factory->create(endpt, true, getEndpointSelection(), getLatencySelection(),
+                        new CB2(self, endpoints, callback));
         return;
     }
 }
@@ -1839,6 +1894,7 @@ IceInternal::RoutableReference::RoutableReference(const RoutableReference& r) :
     _cacheConnection(r._cacheConnection),
     _preferSecure(r._preferSecure),
     _endpointSelection(r._endpointSelection),
+    _latencySelection(r._latencySelection),
     _locatorCacheTimeout(r._locatorCacheTimeout),
     _overrideTimeout(r._overrideTimeout),
     _timeout(r._timeout),
@@ -1902,6 +1958,11 @@ IceInternal::RoutableReference::filterEndpoints(const vector<EndpointIPtr>& allE
         }
     }
 
+    //
+    // Filter out the endpoints whose circuit breaker is open.
+    //
+    endpoints = getInstance()->outgoingConnectionFactory()->filterBrokenEndpoints(endpoints);
+
     //
     // Sort the endpoints according to the endpoint selection type.
     //
@@ -1924,6 +1985,10 @@ IceInternal::RoutableReference::filterEndpoints(const vector<EndpointIPtr>& allE
             break;
         }
     }
+    if(_latencySelection)
+    {
+        endpoints = getInstance()->outgoingConnectionFactory()->sortByLatency(endpoints);
+    }
 
     //
     // If a secure connection is requested or secure overrides is set,
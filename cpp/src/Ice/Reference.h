@@ -11,6 +11,7 @@
 #define ICE_REFERENCE_H
 
 #include <IceUtil/Shared.h>
+#include <IceUtil/Atomic.h>
 #include <Ice/ReferenceF.h>
 #include <Ice/ReferenceFactoryF.h>
 #include <Ice/EndpointIF.h>
@@ -84,6 +85,7 @@ public:
     virtual bool getCacheConnection() const = 0;
     virtual bool getPreferSecure() const = 0;
     virtual Ice::EndpointSelectionType getEndpointSelection() const = 0;
+    virtual bool getLatencySelection() const = 0;
     virtual int getLocatorCacheTimeout() const = 0;
     virtual std::string getConnectionId() const = 0;
 
@@ -127,6 +129,13 @@ public:
     //
     virtual void streamWrite(Ice::OutputStream*) const;
 
+    //
+    // Marshal the identity, facet and operation name of a request
+    // sent with this reference. The identity and facet are encoded
+    // once, when the reference is created or changed.
+    //
+    void streamWriteRequest(Ice::OutputStream*, const std::string&) const;
+
     //
     // Convert the reference to its string form.
     //
@@ -156,8 +165,8 @@ protected:
 
     virtual Ice::Int hashInit() const;
 
-    mutable Ice::Int _hashValue;
-    mutable bool _hashInitialized;
+    mutable IceUtilInternal::Atomic _hashValue;
+    mutable IceUtilInternal::Atomic _hashInitialized;
 
 private:
 
@@ -173,6 +182,10 @@ private:
     Ice::EncodingVersion _encoding;
     int _invocationTimeout;
 
+    std::vector<Ice::Byte> _requestPrefix; // The encoded identity and facet of the requests.
+
+    void initRequestPrefix();
+
 protected:
 
     bool _overrideCompress;
@@ -192,6 +205,7 @@ public:
     virtual bool getCacheConnection() const;
     virtual bool getPreferSecure() const;
     virtual Ice::EndpointSelectionType getEndpointSelection() const;
+    virtual bool getLatencySelection() const;
     virtual int getLocatorCacheTimeout() const;
     virtual std::string getConnectionId() const;
 
@@ -237,7 +251,7 @@ public:
     RoutableReference(const InstancePtr&, const Ice::CommunicatorPtr&, const Ice::Identity&, const std::string&, Mode,
                       bool, const Ice::ProtocolVersion&, const Ice::EncodingVersion&, const std::vector<EndpointIPtr>&,
                       const std::string&, const LocatorInfoPtr&, const RouterInfoPtr&, bool, bool, bool,
-                      Ice::EndpointSelectionType, int, int, const Ice::Context&);
+                      Ice::EndpointSelectionType, bool, int, int, const Ice::Context&);
 
     virtual std::vector<EndpointIPtr> getEndpoints() const;
     virtual std::string getAdapterId() const;
@@ -247,6 +261,7 @@ public:
     virtual bool getCacheConnection() const;
     virtual bool getPreferSecure() const;
     virtual Ice::EndpointSelectionType getEndpointSelection() const;
+    virtual bool getLatencySelection() const;
     virtual int getLocatorCacheTimeout() const;
     virtual std::string getConnectionId() const;
 
@@ -305,6 +320,14 @@ private:
     bool _cacheConnection;
     bool _preferSecure;
     Ice::EndpointSelectionType _endpointSelection;
+
+    //
+    // True for the Latency endpoint selection type. This type is only
+    // supported by the C++ run time and can only be set with the
+    // EndpointSelection properties, it isn't an enumerator of
+    // Ice::EndpointSelectionType. _endpointSelection is Random then.
+    //
+    bool _latencySelection;
     int _locatorCacheTimeout;
 
     bool _overrideTimeout;
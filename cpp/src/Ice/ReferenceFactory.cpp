@@ -797,6 +797,7 @@ IceInternal::ReferenceFactory::create(const Identity& ident,
     bool cacheConnection = true;
     bool preferSecure = defaultsAndOverrides->defaultPreferSecure;
     Ice::EndpointSelectionType endpointSelection = defaultsAndOverrides->defaultEndpointSelection;
+    bool latencySelection = defaultsAndOverrides->defaultLatencySelection;
     int locatorCacheTimeout = defaultsAndOverrides->defaultLocatorCacheTimeout;
     int invocationTimeout = defaultsAndOverrides->defaultInvocationTimeout;
     Ice::Context ctx;
@@ -857,6 +858,7 @@ IceInternal::ReferenceFactory::create(const Identity& ident,
         if(!properties->getProperty(property).empty())
         {
             string type = properties->getProperty(property);
+            latencySelection = false;
             if(type == "Random")
             {
                 endpointSelection = Random;
@@ -865,10 +867,15 @@ IceInternal::ReferenceFactory::create(const Identity& ident,
             {
                 endpointSelection = Ordered;
             }
+            else if(type == "Latency")
+            {
+                endpointSelection = Random;
+                latencySelection = true;
+            }
             else
             {
                 EndpointSelectionTypeParseException ex(__FILE__, __LINE__);
-                ex.str = "illegal value `" + type + "'; expected `Random' or `Ordered'";
+                ex.str = "illegal value `" + type + "'; expected `Random', `Ordered' or `Latency'";
                 throw ex;
             }
         }
@@ -930,6 +937,7 @@ IceInternal::ReferenceFactory::create(const Identity& ident,
                                  cacheConnection,
                                  preferSecure,
                                  endpointSelection,
+                                 latencySelection,
                                  locatorCacheTimeout,
                                  invocationTimeout,
                                  ctx);
@@ -13,12 +13,14 @@
 #include <Ice/Instance.h>
 #include <Ice/TraceLevels.h>
 #include <Ice/LoggerUtil.h>
+#include <Ice/Properties.h>
 
 using namespace std;
 using namespace Ice;
 using namespace IceInternal;
 
 IceUtil::Shared* IceInternal::upCast(RetryQueue* p) { return p; }
+IceUtil::Shared* IceInternal::upCast(RetryBudget* p) { return p; }
 
 IceInternal::RetryTask::RetryTask(const InstancePtr& instance,
                                   const RetryQueuePtr& queue,
@@ -157,3 +159,43 @@ IceInternal::RetryQueue::cancel(const RetryTaskPtr& task)
     }
     return false;
 }
+
+IceInternal::RetryBudget::RetryBudget(const PropertiesPtr& properties) :
+    _percent(properties->getPropertyAsInt("Ice.RetryBudget")),
+    _reserve(max(properties->getPropertyAsIntWithDefault("Ice.RetryBudget.Reserve", 10), 0) * 100),
+    _balance(_reserve)
+{
+}
+
+bool
+IceInternal::RetryBudget::withdraw()
+{
+    if(_percent <= 0)
+    {
+        return true;
+    }
+
+    //
+    // The balance is updated with compare-and-swap, completed
+    // invocations and retries don't contend on a lock.
+    //
+    int balance = _balance.load();
+    do
+    {
+        if(balance < 100)
+        {
+            return false;
+        }
+    }
+    while(!_balance.compare_exchange_strong(balance, balance - 100));
+    return true;
+}
+
+void
+IceInternal::RetryBudget::deposit()
+{
+    int balance = _balance.load();
+    while(balance < _reserve && !_balance.compare_exchange_strong(balance, min(balance + _percent, _reserve)))
+    {
+    }
+}
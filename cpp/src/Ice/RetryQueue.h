@@ -12,10 +12,12 @@
 
 #include <IceUtil/Shared.h>
 #include <IceUtil/Mutex.h>
+#include <IceUtil/Atomic.h>
 #include <IceUtil/Timer.h>
 #include <Ice/RetryQueueF.h>
 #include <Ice/OutgoingAsyncF.h>
 #include <Ice/InstanceF.h>
+#include <Ice/PropertiesF.h>
 #include <Ice/RequestHandler.h> // For CancellationHandler
 
 namespace IceInternal
@@ -67,6 +69,41 @@ private:
     std::set<RetryTaskPtr> _requests;
 };
 
+//
+// The retry budget limits the retries of a communicator to a
+// percentage of its completed invocations, so that the retries of
+// many clients don't multiply the load of a degraded server. The
+// budget starts with a reserve of Ice.RetryBudget.Reserve retries (10
+// by default), so that retries are allowed before any invocation
+// completed. The balance is capped at the reserve: a long period
+// without failures doesn't allow a burst of retries larger than the
+// reserve.
+//
+class RetryBudget : public IceUtil::Shared
+{
+public:
+
+    RetryBudget(const Ice::PropertiesPtr&);
+
+    void completed()
+    {
+        if(_percent > 0)
+        {
+            deposit();
+        }
+    }
+
+    bool withdraw();
+
+private:
+
+    void deposit();
+
+    const int _percent;
+    const int _reserve; // In hundredths of a retry.
+    IceUtilInternal::Atomic _balance; // In hundredths of a retry.
+};
+
 }
 
 #endif
@@ -19,6 +19,10 @@ class RetryQueue;
 IceUtil::Shared* upCast(RetryQueue*);
 typedef Handle<RetryQueue> RetryQueuePtr;
 
+class RetryBudget;
+IceUtil::Shared* upCast(RetryBudget*);
+typedef Handle<RetryBudget> RetryBudgetPtr;
+
 }
 
 #endif
@@ -11,6 +11,11 @@
 #include <Ice/NetworkProxy.h>
 #include <Ice/ProtocolInstance.h>
 
+#if defined(__linux__)
+#   include <sys/sendfile.h>
+#   include <errno.h>
+#endif
+
 using namespace IceInternal;
 
 #if defined(ICE_OS_WINRT)
@@ -368,6 +373,64 @@ StreamSocket::write(const char* buf, size_t length)
 }
 #endif
 
+#if defined(__linux__)
+ssize_t
+StreamSocket::writeFile(int fd, Ice::Long offset, size_t length)
+{
+    assert(_fd != INVALID_SOCKET);
+
+    off_t off = static_cast<off_t>(offset);
+    ssize_t sent = 0;
+    while(length > 0)
+    {
+        ssize_t ret = ::sendfile(_fd, fd, &off, length);
+        if(ret == 0)
+        {
+            //
+            // The file is shorter than the range being sent.
+            //
+            throw Ice::FileException(__FILE__, __LINE__, 0, "");
+        }
+        else if(ret == SOCKET_ERROR)
+        {
+            if(interrupted())
+            {
+                continue;
+            }
+
+            if(wouldBlock())
+            {
+                return sent;
+            }
+
+            if(connectionLost())
+            {
+                Ice::ConnectionLostException ex(__FILE__, __LINE__);
+                ex.error = getSocketErrno();
+                throw ex;
+            }
+            else if(errno == EINVAL || errno == EIO || errno == ENOSYS || errno == EOVERFLOW)
+            {
+                //
+                // The file can't be read, or can't be sent with sendfile.
+                //
+                throw Ice::FileException(__FILE__, __LINE__, getSocketErrno(), "");
+            }
+            else
+            {
+                Ice::SocketException ex(__FILE__, __LINE__);
+                ex.error = getSocketErrno();
+                throw ex;
+            }
+        }
+
+        sent += ret;
+        length -= ret;
+    }
+    return sent;
+}
+#endif
+
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_WINRT)
 AsyncInfo*
 StreamSocket::getAsyncInfo(SocketOperation op)
@@ -41,6 +41,10 @@ public:
     ssize_t write(const char*, size_t);
 #endif
 
+#if defined(__linux__)
+    ssize_t writeFile(int, Ice::Long, size_t);
+#endif
+
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_WINRT)
     AsyncInfo* getAsyncInfo(SocketOperation);
 #endif
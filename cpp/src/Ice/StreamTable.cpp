@@ -0,0 +1,127 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/StreamTable.h>
+
+using namespace std;
+using namespace Ice;
+
+void
+Ice::writeTable(OutputStream* os, const void* const* members, const StreamTableEntry* entries, size_t sz)
+{
+    for(size_t i = 0; i < sz; ++i)
+    {
+        const void* v = members[i];
+        switch(entries[i].kind)
+        {
+            case StreamTableBool:
+            {
+                os->write(*static_cast<const bool*>(v));
+                break;
+            }
+            case StreamTableByte:
+            {
+                os->write(*static_cast<const Byte*>(v));
+                break;
+            }
+            case StreamTableShort:
+            {
+                os->write(*static_cast<const Short*>(v));
+                break;
+            }
+            case StreamTableInt:
+            {
+                os->write(*static_cast<const Int*>(v));
+                break;
+            }
+            case StreamTableLong:
+            {
+                os->write(*static_cast<const Long*>(v));
+                break;
+            }
+            case StreamTableFloat:
+            {
+                os->write(*static_cast<const Float*>(v));
+                break;
+            }
+            case StreamTableDouble:
+            {
+                os->write(*static_cast<const Double*>(v));
+                break;
+            }
+            case StreamTableString:
+            {
+                os->write(*static_cast<const string*>(v), true);
+                break;
+            }
+            case StreamTableHelper:
+            {
+                entries[i].write(os, v);
+                break;
+            }
+        }
+    }
+}
+
+void
+Ice::readTable(InputStream* is, void* const* members, const StreamTableEntry* entries, size_t sz)
+{
+    for(size_t i = 0; i < sz; ++i)
+    {
+        void* v = members[i];
+        switch(entries[i].kind)
+        {
+            case StreamTableBool:
+            {
+                is->read(*static_cast<bool*>(v));
+                break;
+            }
+            case StreamTableByte:
+            {
+                is->read(*static_cast<Byte*>(v));
+                break;
+            }
+            case StreamTableShort:
+            {
+                is->read(*static_cast<Short*>(v));
+                break;
+            }
+            case StreamTableInt:
+            {
+                is->read(*static_cast<Int*>(v));
+                break;
+            }
+            case StreamTableLong:
+            {
+                is->read(*static_cast<Long*>(v));
+                break;
+            }
+            case StreamTableFloat:
+            {
+                is->read(*static_cast<Float*>(v));
+                break;
+            }
+            case StreamTableDouble:
+            {
+                is->read(*static_cast<Double*>(v));
+                break;
+            }
+            case StreamTableString:
+            {
+                is->read(*static_cast<string*>(v), true);
+                break;
+            }
+            case StreamTableHelper:
+            {
+                entries[i].read(is, v);
+                break;
+            }
+        }
+    }
+}
@@ -124,6 +124,26 @@ IceInternal::TcpTransceiver::setBufferSize(int rcvSize, int sndSize)
     _stream->setBufferSize(rcvSize, sndSize);
 }
 
+bool
+IceInternal::TcpTransceiver::canWriteFile() const
+{
+#if defined(__linux__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+size_t
+IceInternal::TcpTransceiver::writeFile(int fd, Ice::Long offset, size_t length)
+{
+#if defined(__linux__)
+    return static_cast<size_t>(_stream->writeFile(fd, offset, length));
+#else
+    return Transceiver::writeFile(fd, offset, length);
+#endif
+}
+
 IceInternal::TcpTransceiver::TcpTransceiver(const ProtocolInstancePtr& instance, const StreamSocketPtr& stream) :
     _instance(instance),
     _stream(stream)
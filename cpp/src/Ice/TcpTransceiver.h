@@ -45,6 +45,8 @@ public:
     virtual Ice::ConnectionInfoPtr getInfo() const;
     virtual void checkSendSize(const Buffer&);
     virtual void setBufferSize(int rcvSize, int sndSize);
+    virtual bool canWriteFile() const;
+    virtual size_t writeFile(int, Ice::Long, size_t);
 
 private:
 
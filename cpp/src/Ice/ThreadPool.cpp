@@ -107,6 +107,13 @@ private:
     IceUtil::ThreadPtr _thread;
 };
 
+//
+// The interval at which the adaptive thread pool samples the dispatch
+// throughput and adjusts its target size. Threads above the target
+// size are also released after being idle for this interval.
+//
+const IceUtil::Time adaptiveInterval = IceUtil::Time::milliSeconds(500);
+
 //
 // Exception raised by the thread pool work queue when the thread pool
 // is destroyed.
@@ -265,6 +272,14 @@ IceInternal::ThreadPool::ThreadPool(const InstancePtr& instance, const string& p
     _serverIdleTime(timeout),
     _threadIdleTime(0),
     _stackSize(0),
+    _adaptive(_instance->initializationData().properties->getPropertyAsInt(_prefix + ".Adaptive") > 0),
+    _callerRuns(_instance->initializationData().properties->getPropertyAsInt(_prefix + ".CallerRuns") > 0),
+    _targetSize(0),
+    _targetStep(1),
+    _lastThroughput(0),
+    _dispatchCount(0),
+    _utilization(0),
+    _waitCount(0),
     _inUse(0),
 #if !defined(ICE_USE_IOCP) && !defined(ICE_OS_WINRT)
     _inUseIO(0),
@@ -342,6 +357,9 @@ IceInternal::ThreadPool::ThreadPool(const InstancePtr& instance, const string& p
 #endif
     const_cast<int&>(_threadIdleTime) = threadIdleTime;
 
+    _targetSize = size;
+    _sampleStart = IceUtil::Time::now(IceUtil::Time::Monotonic);
+
 #ifdef ICE_USE_IOCP
     _selector.setup(_sizeIO);
 #endif
@@ -371,6 +389,14 @@ IceInternal::ThreadPool::ThreadPool(const InstancePtr& instance, const string& p
         Trace out(_instance->initializationData().logger, _instance->traceLevels()->threadPoolCat);
         out << "creating " << _prefix << ": Size = " << _size << ", SizeMax = " << _sizeMax << ", SizeWarn = "
             << _sizeWarn;
+        if(_adaptive)
+        {
+            out << ", Adaptive = 1";
+        }
+        if(_callerRuns)
+        {
+            out << ", CallerRuns = 1";
+        }
     }
 
     __setNoDelete(true);
@@ -653,6 +679,10 @@ IceInternal::ThreadPool::run(const EventHandlerThreadPtr& thread)
                     _selector.finishSelect(_handlers);
                     _nextHandler = _handlers.begin();
                     select = false;
+                    if(_adaptive)
+                    {
+                        _selectTime = IceUtil::Time::now(IceUtil::Time::Monotonic);
+                    }
                 }
                 else if(!current._leader && followerWait(current))
                 {
@@ -704,6 +734,15 @@ IceInternal::ThreadPool::run(const EventHandlerThreadPtr& thread)
                 current.operation = _nextHandler->second;
                 ++_nextHandler;
                 thread->setState(ThreadStateInUseForIO);
+                if(_adaptive)
+                {
+                    //
+                    // Account for the time the handler waited for a thread
+                    // since it was selected.
+                    //
+                    _waitTime += IceUtil::Time::now(IceUtil::Time::Monotonic) - _selectTime;
+                    ++_waitCount;
+                }
             }
             else
             {
@@ -917,10 +956,26 @@ IceInternal::ThreadPool::ioCompleted(ThreadPoolCurrent& current)
                 << "Size=" << _size << ", " << "SizeMax=" << _sizeMax << ", " << "SizeWarn=" << _sizeWarn;
         }
 
+        if(_adaptive)
+        {
+            ++_dispatchCount;
+            _utilization += static_cast<double>(_inUse) / _threads.size();
+            IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+            if(now - _sampleStart >= adaptiveInterval)
+            {
+                adapt(now);
+            }
+        }
+
         if(!_destroyed)
         {
+            //
+            // Grow the pool if all the threads are in use, or if the
+            // adaptive controller raised the target size.
+            //
             assert(_inUse <= static_cast<int>(_threads.size()));
-            if(_inUse < _sizeMax && _inUse == static_cast<int>(_threads.size()))
+            if((_inUse < _sizeMax && _inUse == static_cast<int>(_threads.size())) ||
+               (_adaptive && static_cast<int>(_threads.size()) < _targetSize))
             {
                 if(_instance->traceLevels()->threadPool >= 1)
                 {
@@ -1089,15 +1144,49 @@ IceInternal::ThreadPool::followerWait(ThreadPoolCurrent& current)
     current.stream.clear();
     current.stream.b.clear();
 
+    IceUtil::Time idleStart;
+    if(_adaptive)
+    {
+        idleStart = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    }
+
     //
     // Wait to be promoted and for all the IO threads to be done.
     //
     while(!_promote || _inUseIO == _sizeIO || (_nextHandler == _handlers.end() && _inUseIO > 0))
     {
-        if(_threadIdleTime)
+        //
+        // The followers of an adaptive thread pool wake up once per
+        // sampling interval to adjust the target size, so that the pool
+        // also shrinks when it no longer dispatches. Threads above the
+        // target size are released once they have been idle for the
+        // sampling interval.
+        //
+        if(_threadIdleTime || _adaptive)
         {
-            if(!timedWait(IceUtil::Time::seconds(_threadIdleTime)))
+            if(!timedWait(_adaptive ? adaptiveInterval : IceUtil::Time::seconds(_threadIdleTime)))
             {
+                if(_adaptive)
+                {
+                    IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+                    if(now - _sampleStart >= adaptiveInterval)
+                    {
+                        adapt(now);
+                    }
+
+                    //
+                    // Other surplus followers might have timed out at the
+                    // same time and released their thread, so check again
+                    // whether this thread is still a surplus thread. Other
+                    // threads are released once idle for ThreadIdleTime.
+                    //
+                    if(static_cast<int>(_threads.size()) <= max(_size, _targetSize) &&
+                       (!_threadIdleTime || now - idleStart < IceUtil::Time::seconds(_threadIdleTime)))
+                    {
+                        continue;
+                    }
+                }
+
                 if(!_destroyed && (!_promote || _inUseIO == _sizeIO ||
                                    (_nextHandler == _handlers.end() && _inUseIO > 0)))
                 {
@@ -1124,6 +1213,69 @@ IceInternal::ThreadPool::followerWait(ThreadPoolCurrent& current)
 }
 #endif
 
+//
+// Adjusts the target size of an adaptive thread pool. This is called
+// with the thread pool locked once per sampling interval, either when
+// a request is dispatched or by an idle follower thread. The target
+// size moves in the same direction as long as the dispatch throughput
+// improves and reverses direction when it degrades. If the throughput
+// doesn't change significantly, the dispatch wait time and the thread
+// utilization decide whether threads are added or removed.
+//
+void
+IceInternal::ThreadPool::adapt(const IceUtil::Time& now)
+{
+    assert(_adaptive);
+    double throughput = _dispatchCount / (now - _sampleStart).toSecondsDouble();
+    double utilization = _dispatchCount > 0 ? _utilization / _dispatchCount : 0.0;
+    IceUtil::Time wait = _waitCount > 0 ? _waitTime / _waitCount : IceUtil::Time();
+
+    if(_dispatchCount == 0)
+    {
+        _targetStep = -1; // The pool is idle, shrink it down to its minimum size.
+    }
+    else if(throughput < _lastThroughput * 0.95)
+    {
+        _targetStep = -_targetStep;
+    }
+    else if(throughput <= _lastThroughput * 1.05)
+    {
+        if(wait > IceUtil::Time::milliSeconds(1) && utilization > 0.75)
+        {
+            _targetStep = 1;
+        }
+        else if(utilization < 0.5)
+        {
+            _targetStep = -1;
+        }
+        else
+        {
+            _targetStep = 0;
+        }
+    }
+
+    int targetSize = max(_size, min(_sizeMax, _targetSize + _targetStep));
+    if(targetSize == _targetSize && _targetStep != 0)
+    {
+        _targetStep = -_targetStep;
+    }
+    else if(_instance->traceLevels()->threadPool >= 1)
+    {
+        Trace out(_instance->initializationData().logger, _instance->traceLevels()->threadPoolCat);
+        out << "adjusting " << _prefix << ": TargetSize=" << targetSize << ", Size=" << _threads.size()
+            << ", Throughput=" << throughput << "/s, Wait=" << wait.toMilliSecondsDouble() << "ms, Utilization="
+            << utilization;
+    }
+    _targetSize = targetSize;
+
+    _lastThroughput = throughput;
+    _sampleStart = now;
+    _dispatchCount = 0;
+    _utilization = 0;
+    _waitTime = IceUtil::Time();
+    _waitCount = 0;
+}
+
 string
 IceInternal::ThreadPool::nextThreadId()
 {
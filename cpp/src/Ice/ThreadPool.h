@@ -115,6 +115,11 @@ public:
 
     std::string prefix() const;
 
+    bool callerRuns() const
+    {
+        return _callerRuns;
+    }
+
 private:
 
     void run(const EventHandlerThreadPtr&);
@@ -130,6 +135,7 @@ private:
 #endif
 
     std::string nextThreadId();
+    void adapt(const IceUtil::Time&);
 
     const InstancePtr _instance;
 #ifdef ICE_CPP11_MAPPING
@@ -157,6 +163,22 @@ private:
     const int _serverIdleTime;
     const int _threadIdleTime;
     const size_t _stackSize;
+    const bool _adaptive; // True if the number of threads is adjusted with the dispatch feedback.
+    const bool _callerRuns; // True if synchronous invocations read their reply from the calling thread.
+
+    //
+    // State of the adaptive sizing controller. The target size is the
+    // number of threads kept by the pool, it's adjusted by hill-climbing
+    // on the dispatch throughput within [_size, _sizeMax].
+    //
+    int _targetSize;
+    int _targetStep;
+    double _lastThroughput;
+    IceUtil::Time _sampleStart;
+    int _dispatchCount;
+    double _utilization;
+    IceUtil::Time _waitTime;
+    int _waitCount;
 
     std::set<EventHandlerThreadPtr> _threads; // All threads, running or not.
     int _inUse; // Number of threads that are currently in use.
@@ -164,6 +186,7 @@ private:
     int _inUseIO; // Number of threads that are currently performing IO.
     std::vector<std::pair<EventHandler*, SocketOperation> > _handlers;
     std::vector<std::pair<EventHandler*, SocketOperation> >::const_iterator _nextHandler;
+    IceUtil::Time _selectTime; // Time at which the ready handlers were selected.
 #endif
 
     bool _promote;
@@ -22,3 +22,16 @@ IceInternal::Transceiver::bind()
     return 0;
 }
 
+bool
+IceInternal::Transceiver::canWriteFile() const
+{
+    return false;
+}
+
+size_t
+IceInternal::Transceiver::writeFile(int, Ice::Long, size_t)
+{
+    assert(false);
+    return 0;
+}
+
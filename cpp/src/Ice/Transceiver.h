@@ -47,6 +47,16 @@ public:
     virtual Ice::ConnectionInfoPtr getInfo() const = 0;
     virtual void checkSendSize(const Buffer&) = 0;
     virtual void setBufferSize(int, int) = 0;
+
+    //
+    // Transceivers which can write a file to their socket without
+    // copying it return true from canWriteFile. writeFile then writes
+    // the given number of bytes of the file, starting at the given
+    // offset, and returns the number of bytes written, which is less
+    // if the socket isn't writable.
+    //
+    virtual bool canWriteFile() const;
+    virtual size_t writeFile(int, Ice::Long, size_t);
 };
 
 }
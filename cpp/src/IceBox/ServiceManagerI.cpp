@@ -369,6 +369,25 @@ IceBox::ServiceManagerI::start()
             servicesInfo.push_back(StartServiceInfo(p->first.substr(prefix.size()), p->second, _argv));
         }
 
+        //
+        // If IceBox.UseSharedRuntime is set, the service communicators share
+        // the thread pools, timer and endpoint host resolver of a runtime
+        // configured with the thread pool properties of the IceBox communicator.
+        //
+        if(properties->getPropertyAsInt("IceBox.UseSharedRuntime") > 0)
+        {
+            InitializationData initData;
+            initData.properties = createProperties();
+            PropertyDict threadPoolProps = properties->getPropertiesForPrefix("Ice.ThreadPool.");
+            for(PropertyDict::const_iterator q = threadPoolProps.begin(); q != threadPoolProps.end(); ++q)
+            {
+                initData.properties->setProperty(q->first, q->second);
+            }
+            initData.properties->setProperty("Ice.ThreadPriority", properties->getProperty("Ice.ThreadPriority"));
+            initData.logger = _logger;
+            _runtime = createRuntime(initData);
+        }
+
         //
         // Check if some services are using the shared communicator in which
         // case we create the shared communicator now with a property set that
@@ -380,6 +399,7 @@ IceBox::ServiceManagerI::start()
         {
             InitializationData initData;
             initData.properties = createServiceProperties("SharedCommunicator");
+            initData.runtime = _runtime;
 
             for(vector<StartServiceInfo>::iterator q = servicesInfo.begin(); q != servicesInfo.end(); ++q)
             {
@@ -589,6 +609,7 @@ IceBox::ServiceManagerI::start(const string& service, const string& entryPoint,
             //
             InitializationData initData;
             initData.properties = createServiceProperties(service);
+            initData.runtime = _runtime;
 
             if(!info.args.empty())
             {
@@ -904,6 +925,20 @@ IceBox::ServiceManagerI::stopAll()
         _sharedCommunicator = 0;
     }
 
+    if(_runtime)
+    {
+        try
+        {
+            _runtime->destroy();
+        }
+        catch(const std::exception& ex)
+        {
+            Warning out(_logger);
+            out << "ServiceManager: exception while destroying shared runtime:\n" << ex;
+        }
+        _runtime = 0;
+    }
+
     _services.clear();
 
     servicesStopped(stoppedServices, _observers);
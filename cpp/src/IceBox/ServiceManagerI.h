@@ -94,6 +94,7 @@ private:
     bool _adminEnabled;
     std::set<std::string> _adminFacetFilter;
     ::Ice::CommunicatorPtr _sharedCommunicator;
+    ::Ice::RuntimePtr _runtime;
     ::Ice::LoggerPtr _logger;
     ::Ice::StringSeq _argv; // Filtered server argument vector, not including program name
     std::vector<ServiceInfo> _services;
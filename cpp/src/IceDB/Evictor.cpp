@@ -0,0 +1,288 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <IceDB/Evictor.h>
+#include <Ice/LocalException.h>
+
+using namespace std;
+using namespace IceDB;
+
+ServantStore::~ServantStore()
+{
+    // Out of line to avoid weak vtable
+}
+
+Evictor::Evictor(const ServantStorePtr& store, size_t size, size_t batchSize) :
+    _store(store),
+    _size(size),
+    _batchSize(batchSize > 0 ? batchSize : 1),
+    _dirtyCount(0),
+    _hits(0),
+    _misses(0)
+{
+}
+
+Ice::ObjectPtr
+Evictor::locate(const Ice::Current& current, Ice::LocalObjectPtr& cookie)
+{
+    Lock sync(*this);
+    while(true)
+    {
+        map<Ice::Identity, EntryPtr>::const_iterator p = _map.find(current.id);
+        if(p == _map.end())
+        {
+            break;
+        }
+
+        EntryPtr entry = p->second;
+        if(entry->busy)
+        {
+            //
+            // Another thread is loading or saving this servant, wait
+            // for it to be done.
+            //
+            wait();
+            continue;
+        }
+
+        ++_hits;
+        ++entry->useCount;
+        _queue.splice(_queue.begin(), _queue, entry->pos);
+        cookie = entry;
+        return entry->servant;
+    }
+
+    //
+    // Load the servant without holding the lock, the entry is marked
+    // busy in the meantime so that concurrent requests for this
+    // servant wait for this load.
+    //
+    ++_misses;
+    EntryPtr entry = new Entry(current.id);
+    _map.insert(make_pair(current.id, entry));
+
+    Ice::ObjectPtr servant;
+    sync.release();
+    try
+    {
+        servant = _store->load(current.id);
+    }
+    catch(...)
+    {
+        sync.acquire();
+        _map.erase(current.id);
+        notifyAll();
+        throw;
+    }
+    sync.acquire();
+
+    entry->busy = false;
+    notifyAll();
+
+    if(!servant)
+    {
+        _map.erase(current.id);
+        return 0;
+    }
+
+    entry->servant = servant;
+    entry->useCount = 1;
+    _queue.push_front(entry);
+    entry->pos = _queue.begin();
+
+    try
+    {
+        writeBack(sync, false);
+    }
+    catch(...)
+    {
+        //
+        // finished() isn't called if locate() throws, release the
+        // servant here so that it can still be evicted.
+        //
+        --entry->useCount;
+        throw;
+    }
+
+    cookie = entry;
+    return servant;
+}
+
+void
+Evictor::finished(const Ice::Current& current, const Ice::ObjectPtr&, const Ice::LocalObjectPtr& cookie)
+{
+    EntryPtr entry = EntryPtr::dynamicCast(cookie);
+    assert(entry);
+
+    Lock sync(*this);
+    assert(entry->useCount > 0);
+    --entry->useCount;
+    if(current.mode == Ice::Normal && !entry->dirty)
+    {
+        entry->dirty = true;
+        ++_dirtyCount;
+    }
+
+    //
+    // Servants in use can't be evicted, check if the queue needs to
+    // be trimmed now that this servant is no longer in use.
+    //
+    writeBack(sync, false);
+}
+
+void
+Evictor::deactivate(const string&)
+{
+    Lock sync(*this);
+    writeBack(sync, true);
+
+    for(map<Ice::Identity, EntryPtr>::const_iterator p = _map.begin(); p != _map.end(); ++p)
+    {
+        p->second->servant = 0;
+    }
+    _map.clear();
+    _queue.clear();
+}
+
+void
+Evictor::setSize(size_t size)
+{
+    Lock sync(*this);
+    _size = size;
+    writeBack(sync, false);
+}
+
+void
+Evictor::flush()
+{
+    Lock sync(*this);
+    writeBack(sync, true);
+}
+
+IceUtil::Int64
+Evictor::hits() const
+{
+    Lock sync(*this);
+    return _hits;
+}
+
+IceUtil::Int64
+Evictor::misses() const
+{
+    Lock sync(*this);
+    return _misses;
+}
+
+//
+// Evicts the least recently used servants which are not in use and
+// saves the modified servants if all is true or if there are enough
+// of them to fill a batch. The lock is released while the servants
+// are saved.
+//
+void
+Evictor::writeBack(Lock& sync, bool all)
+{
+    ServantSeq batch;
+    vector<EntryPtr> evicted;
+    vector<EntryPtr> saved;
+
+    list<EntryPtr>::iterator p = _queue.end();
+    while(_queue.size() > _size && p != _queue.begin())
+    {
+        --p;
+        EntryPtr entry = *p;
+        if(entry->useCount > 0)
+        {
+            continue;
+        }
+
+        p = _queue.erase(p);
+        if(entry->dirty)
+        {
+            //
+            // The entry is kept until the servant is saved, requests
+            // for this servant wait until then.
+            //
+            entry->dirty = false;
+            entry->busy = true;
+            --_dirtyCount;
+            batch.push_back(make_pair(entry->id, entry->servant));
+            evicted.push_back(entry);
+        }
+        else
+        {
+            _map.erase(entry->id);
+        }
+    }
+
+    if(all || _dirtyCount >= _batchSize)
+    {
+        for(list<EntryPtr>::const_iterator q = _queue.begin(); q != _queue.end() && _dirtyCount > 0; ++q)
+        {
+            if((*q)->dirty)
+            {
+                (*q)->dirty = false;
+                --_dirtyCount;
+                batch.push_back(make_pair((*q)->id, (*q)->servant));
+                saved.push_back(*q);
+            }
+        }
+    }
+
+    if(batch.empty())
+    {
+        return;
+    }
+
+    sync.release();
+    try
+    {
+        _store->save(batch);
+    }
+    catch(...)
+    {
+        //
+        // Keep the servants which couldn't be saved in memory, they
+        // will be saved again with the next batch.
+        //
+        sync.acquire();
+        for(vector<EntryPtr>::const_iterator q = evicted.begin(); q != evicted.end(); ++q)
+        {
+            (*q)->busy = false;
+            (*q)->dirty = true;
+            ++_dirtyCount;
+            _queue.push_back(*q);
+            (*q)->pos = --_queue.end();
+        }
+        for(vector<EntryPtr>::const_iterator q = saved.begin(); q != saved.end(); ++q)
+        {
+            if(!(*q)->dirty)
+            {
+                (*q)->dirty = true;
+                ++_dirtyCount;
+            }
+        }
+        notifyAll();
+        throw;
+    }
+    sync.acquire();
+
+    for(vector<EntryPtr>::const_iterator q = evicted.begin(); q != evicted.end(); ++q)
+    {
+        map<Ice::Identity, EntryPtr>::iterator r = _map.find((*q)->id);
+        if(r != _map.end() && r->second == *q)
+        {
+            _map.erase(r);
+        }
+    }
+    if(!evicted.empty())
+    {
+        notifyAll();
+    }
+}
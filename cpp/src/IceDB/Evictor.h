@@ -0,0 +1,173 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef ICE_DB_EVICTOR_H
+#define ICE_DB_EVICTOR_H
+
+#include <IceDB/IceDB.h>
+#include <IceUtil/Monitor.h>
+#include <IceUtil/Mutex.h>
+#include <Ice/ServantLocator.h>
+#include <Ice/Identity.h>
+
+#include <list>
+#include <map>
+
+namespace IceDB
+{
+
+typedef std::vector<std::pair<Ice::Identity, Ice::ObjectPtr> > ServantSeq;
+
+//
+// ServantStore is the storage backend of the evictor. load returns a
+// null servant if there's no persistent servant with the given
+// identity. save writes back a batch of modified servants, it's
+// called concurrently with the dispatch of requests on these servants
+// so the servants must synchronize the access to their state.
+//
+class ICE_DB_API ServantStore : public IceUtil::Shared
+{
+public:
+
+    virtual ~ServantStore();
+
+    virtual Ice::ObjectPtr load(const Ice::Identity&) = 0;
+    virtual void save(const ServantSeq&) = 0;
+};
+typedef IceUtil::Handle<ServantStore> ServantStorePtr;
+
+//
+// Evictor is a servant locator which keeps at most size servants in
+// memory and evicts the least recently used servants which are not
+// dispatching requests. Concurrent requests for a servant which isn't
+// in memory wait for a single load from the store.
+//
+// Servants which dispatched a request whose mode is Normal (neither
+// idempotent nor nonmutating) are considered modified. They are saved
+// in batches of batchSize servants, when they are evicted, and when
+// the evictor is flushed or deactivated.
+//
+class ICE_DB_API Evictor : public Ice::ServantLocator, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    Evictor(const ServantStorePtr&, size_t, size_t = 1);
+
+    virtual Ice::ObjectPtr locate(const Ice::Current&, Ice::LocalObjectPtr&);
+    virtual void finished(const Ice::Current&, const Ice::ObjectPtr&, const Ice::LocalObjectPtr&);
+    virtual void deactivate(const std::string&);
+
+    void setSize(size_t);
+    void flush();
+
+    IceUtil::Int64 hits() const;
+    IceUtil::Int64 misses() const;
+
+private:
+
+    class Entry;
+    typedef IceUtil::Handle<Entry> EntryPtr;
+
+    class Entry : public Ice::LocalObject
+    {
+    public:
+
+        Entry(const Ice::Identity& i) : id(i), useCount(0), dirty(false), busy(true)
+        {
+        }
+
+        const Ice::Identity id;
+        Ice::ObjectPtr servant;
+        std::list<EntryPtr>::iterator pos;
+        int useCount;
+        bool dirty;
+        bool busy; // The servant is being loaded, or saved after being evicted.
+    };
+
+    void writeBack(Lock&, bool);
+
+    const ServantStorePtr _store;
+    size_t _size;
+    const size_t _batchSize;
+
+    std::map<Ice::Identity, EntryPtr> _map;
+    std::list<EntryPtr> _queue; // Most recently used first.
+    size_t _dirtyCount;
+
+    IceUtil::Int64 _hits;
+    IceUtil::Int64 _misses;
+};
+typedef IceUtil::Handle<Evictor> EvictorPtr;
+
+//
+// ServantStore implementation which stores the servants state in an
+// LMDB database. D is the Slice type holding the state of a servant.
+// Subclasses implement createServant, which creates a servant from
+// its state, and getState, which returns the state of a servant.
+//
+template<typename D>
+class LMDBServantStore : public ServantStore
+{
+public:
+
+    LMDBServantStore(const Ice::CommunicatorPtr& communicator, const std::string& path, const std::string& name,
+                     size_t mapSize = 0) :
+        _env(path, 1, mapSize)
+    {
+        IceContext context;
+        context.communicator = communicator;
+        context.encoding.major = 1;
+        context.encoding.minor = 1;
+
+        ReadWriteTxn txn(_env);
+        _dbi = Dbi<Ice::Identity, D, IceContext, Ice::OutputStream>(txn, name, context, MDB_CREATE);
+        txn.commit();
+    }
+
+    virtual Ice::ObjectPtr
+    load(const Ice::Identity& id)
+    {
+        D state;
+        ReadOnlyTxn txn(_env);
+        if(!_dbi.get(txn, id, state))
+        {
+            return 0;
+        }
+        txn.commit();
+        return createServant(id, state);
+    }
+
+    virtual void
+    save(const ServantSeq& servants)
+    {
+        //
+        // The whole batch is saved with a single transaction.
+        //
+        ReadWriteTxn txn(_env);
+        for(ServantSeq::const_iterator p = servants.begin(); p != servants.end(); ++p)
+        {
+            _dbi.put(txn, p->first, getState(p->second));
+        }
+        txn.commit();
+    }
+
+protected:
+
+    virtual Ice::ObjectPtr createServant(const Ice::Identity&, const D&) = 0;
+    virtual D getState(const Ice::ObjectPtr&) = 0;
+
+private:
+
+    Env _env;
+    Dbi<Ice::Identity, D, IceContext, Ice::OutputStream> _dbi;
+};
+
+}
+
+#endif
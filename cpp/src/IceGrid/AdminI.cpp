@@ -415,6 +415,260 @@ AdminI::getServerAdmin(const string& id, const Current& current) const
 namespace
 {
 
+class ServerMetricsViewsCB : public IceUtil::TimerTask, public IceUtil::Mutex
+{
+public:
+
+    ServerMetricsViewsCB(const AMD_Admin_getAllServerMetricsViewsPtr& amdCB, const Ice::StringSeq& ids, int timeout,
+                         const IceUtil::TimerPtr& timer) :
+        _amdCB(amdCB), _pending(ids.begin(), ids.end()), _timeout(timeout), _timer(timer)
+    {
+        assert(!_pending.empty());
+        if(_timeout > 0)
+        {
+            _deadline = IceUtil::Time::now(IceUtil::Time::Monotonic) + IceUtil::Time::milliSeconds(_timeout);
+        }
+    }
+
+    void
+    response(const string& id, const IceMX::MetricsView& view)
+    {
+        Lock sync(*this);
+        if(_pending.erase(id) == 0)
+        {
+            return; // The view was received after the deadline.
+        }
+
+        for(IceMX::MetricsView::const_iterator p = view.begin(); p != view.end(); ++p)
+        {
+            ServerMetricsMap map;
+            map.id = id;
+            map.map = p->second;
+            _view[p->first].push_back(map);
+        }
+        finished();
+    }
+
+    void
+    exception(const string& id)
+    {
+        Lock sync(*this);
+        if(_pending.erase(id) == 0)
+        {
+            return;
+        }
+        _unreachable.push_back(id);
+        finished();
+    }
+
+    //
+    // Returns the time left before the deadline, 0 if the deadline is
+    // reached and -1 if no timeout was specified.
+    //
+    int
+    remaining() const
+    {
+        if(_timeout <= 0)
+        {
+            return -1;
+        }
+        IceUtil::Int64 left = (_deadline - IceUtil::Time::now(IceUtil::Time::Monotonic)).toMilliSeconds();
+        return left > 0 ? static_cast<int>(left) : 0;
+    }
+
+    virtual void
+    runTimerTask()
+    {
+        //
+        // The deadline is reached, the servers which didn't reply yet
+        // are reported as unreachable.
+        //
+        Lock sync(*this);
+        if(_pending.empty())
+        {
+            return;
+        }
+        _unreachable.insert(_unreachable.end(), _pending.begin(), _pending.end());
+        _pending.clear();
+        _amdCB->ice_response(_view, _unreachable);
+    }
+
+private:
+
+    void
+    finished()
+    {
+        if(_pending.empty())
+        {
+            _amdCB->ice_response(_view, _unreachable);
+
+            //
+            // All the servers replied before the deadline, the timer
+            // task is no longer needed.
+            //
+            if(_timer)
+            {
+                _timer->cancel(this);
+            }
+        }
+    }
+
+    const AMD_Admin_getAllServerMetricsViewsPtr _amdCB;
+    set<string> _pending;
+    const int _timeout;
+    const IceUtil::TimerPtr _timer;
+    IceUtil::Time _deadline;
+    ServerMetricsView _view;
+    Ice::StringSeq _unreachable;
+};
+typedef IceUtil::Handle<ServerMetricsViewsCB> ServerMetricsViewsCBPtr;
+
+class ServerMetricsViewCB : public IceUtil::Shared
+{
+public:
+
+    ServerMetricsViewCB(const ServerMetricsViewsCBPtr& cb, const string& id) : _cb(cb), _id(id)
+    {
+    }
+
+    void
+    response(const IceMX::MetricsView& view, Ice::Long)
+    {
+        _cb->response(_id, view);
+    }
+
+    void
+    exception(const Ice::Exception&)
+    {
+        _cb->exception(_id);
+    }
+
+private:
+
+    const ServerMetricsViewsCBPtr _cb;
+    const string _id;
+};
+
+void requestServerMetricsView(const DatabasePtr&, const ServerMetricsViewsCBPtr&, const string&, const string&);
+
+class ServerMetricsViewSyncCB : public SynchronizationCallback
+{
+public:
+
+    ServerMetricsViewSyncCB(const DatabasePtr& database, const ServerMetricsViewsCBPtr& cb, const string& id,
+                            const string& view) :
+        _database(database), _cb(cb), _id(id), _view(view)
+    {
+    }
+
+    virtual void
+    synchronized()
+    {
+        requestServerMetricsView(_database, _cb, _id, _view);
+    }
+
+    virtual void
+    synchronized(const Ice::Exception&)
+    {
+        _cb->exception(_id);
+    }
+
+private:
+
+    const DatabasePtr _database;
+    const ServerMetricsViewsCBPtr _cb;
+    const string _id;
+    const string _view;
+};
+
+void
+requestServerMetricsView(const DatabasePtr& database, const ServerMetricsViewsCBPtr& cb, const string& id,
+                         const string& view)
+{
+    Ice::ObjectPrx admin;
+    try
+    {
+        //
+        // If the server is being loaded on its node, the request is
+        // sent once it's synchronized rather than waiting for it here.
+        //
+        while(!(admin = database->getServer(id)->getAdminProxy()))
+        {
+            if(database->getServer(id)->addSyncCallback(new ServerMetricsViewSyncCB(database, cb, id, view)))
+            {
+                return;
+            }
+        }
+    }
+    catch(const Ice::UserException&)
+    {
+        cb->exception(id);
+        return;
+    }
+
+    int timeout = cb->remaining();
+    if(timeout == 0)
+    {
+        cb->exception(id);
+        return;
+    }
+
+    IceMX::MetricsAdminPrx metrics = IceMX::MetricsAdminPrx::uncheckedCast(admin->ice_facet("Metrics"));
+    if(timeout > 0)
+    {
+        metrics = IceMX::MetricsAdminPrx::uncheckedCast(metrics->ice_invocationTimeout(timeout));
+    }
+    metrics->begin_getMetricsView(view, IceMX::newCallback_MetricsAdmin_getMetricsView(
+                                      new ServerMetricsViewCB(cb, id),
+                                      &ServerMetricsViewCB::response,
+                                      &ServerMetricsViewCB::exception));
+}
+
+}
+
+void
+AdminI::getAllServerMetricsViews_async(const AMD_Admin_getAllServerMetricsViewsPtr& amdCB, const string& view,
+                                       Ice::Int timeout, const Current&)
+{
+    Ice::StringSeq ids = _database->getServerCache().getAll("");
+    if(ids.empty())
+    {
+        amdCB->ice_response(ServerMetricsView(), Ice::StringSeq());
+        return;
+    }
+
+    //
+    // Request the view from all the servers in parallel, each request
+    // goes through the server's node. The response is sent once all
+    // the requests completed or when the timeout expires, whichever
+    // comes first.
+    //
+    IceUtil::TimerPtr timer = timeout > 0 ? _registry->getTimer() : IceUtil::TimerPtr();
+    ServerMetricsViewsCBPtr cb = new ServerMetricsViewsCB(amdCB, ids, timeout, timer);
+    if(timer)
+    {
+        try
+        {
+            timer->schedule(cb, IceUtil::Time::milliSeconds(timeout));
+        }
+        catch(const IceUtil::IllegalArgumentException&)
+        {
+            //
+            // The timer is destroyed, the registry is shutting down. The
+            // invocation timeout of each request still applies.
+            //
+        }
+    }
+
+    for(Ice::StringSeq::const_iterator p = ids.begin(); p != ids.end(); ++p)
+    {
+        requestServerMetricsView(_database, cb, *p, view);
+    }
+}
+
+namespace
+{
+
 class StartCB : public virtual IceUtil::Shared
 {
 public:
@@ -53,6 +53,8 @@ public:
     virtual Ice::Int getServerPid(const ::std::string&, const Ice::Current&) const;
     virtual std::string getServerAdminCategory(const Ice::Current&) const;
     virtual Ice::ObjectPrx getServerAdmin(const std::string&, const Ice::Current&) const;
+    virtual void getAllServerMetricsViews_async(const AMD_Admin_getAllServerMetricsViewsPtr&, const std::string&,
+                                                Ice::Int, const Ice::Current&);
     virtual void startServer_async(const AMD_Admin_startServerPtr&, const ::std::string&, const Ice::Current&);
     virtual void stopServer_async(const AMD_Admin_stopServerPtr&, const ::std::string&, const Ice::Current&);
     virtual void patchServer_async(const AMD_Admin_patchServerPtr&, const ::std::string&, bool, const Ice::Current&);
@@ -48,6 +48,17 @@ const string internalObjectsDbName = "internal-objects";
 const string internalObjectsByTypeDbName = "internal-objectsByType";
 const string serialsDbName = "serials";
 
+struct AdapterUpdate
+{
+    AdapterUpdate(const string& k, Ice::Long s, const AdapterInfo& i) : kind(k), serial(s), info(i)
+    {
+    }
+
+    string kind;
+    Ice::Long serial;
+    AdapterInfo info;
+};
+
 struct ObjectLoadCI : binary_function<pair<Ice::ObjectPrx, float>&, pair<Ice::ObjectPrx, float>&, bool>
 {
     bool operator()(const pair<Ice::ObjectPrx, float>& lhs, const pair<Ice::ObjectPrx, float>& rhs)
@@ -205,6 +216,12 @@ Database::Database(const Ice::ObjectAdapterPtr& registryAdapter,
     _traceLevels(traceLevels),
     _master(info.name == "Master"),
     _readonly(readonly || !_master),
+    _rollingUpdateNodeConcurrency(
+        _communicator->getProperties()->getPropertyAsInt("IceGrid.Registry.RollingUpdate.NodeConcurrency")),
+    _rollingUpdateReplicaGroupConcurrency(
+        _communicator->getProperties()->getPropertyAsInt("IceGrid.Registry.RollingUpdate.ReplicaGroupConcurrency")),
+    _rollingUpdateHealthCheck(
+        _communicator->getProperties()->getPropertyAsInt("IceGrid.Registry.RollingUpdate.HealthCheck") > 0),
     _replicaCache(_communicator, topicManager),
     _nodeCache(_communicator, _replicaCache, _readonly && _master ? string("Master (read-only)") : info.name),
     _adapterCache(_communicator),
@@ -1079,6 +1096,99 @@ Database::setAdapterDirectProxy(const string& adapterId, const string& replicaGr
     _adapterObserverTopic->waitForSyncedSubscribers(serial);
 }
 
+//
+// Set the direct proxy of several dynamically registered adapters with
+// a single transaction. The adapters which are deployed are not set
+// and are returned to the caller.
+//
+AdapterInfoSeq
+Database::setAdapterDirectProxies(const AdapterInfoSeq& adapters)
+{
+    assert(_master);
+
+    AdapterInfoSeq deployed;
+    int serial = 0;
+    {
+        Lock sync(*this);
+
+        vector<AdapterUpdate> updates;
+        try
+        {
+            IceDB::ReadWriteTxn txn(_env);
+
+            for(AdapterInfoSeq::const_iterator p = adapters.begin(); p != adapters.end(); ++p)
+            {
+                if(_adapterCache.has(p->id))
+                {
+                    deployed.push_back(*p);
+                    continue;
+                }
+
+                AdapterInfo oldInfo;
+                bool found = _adapters.get(txn, p->id, oldInfo);
+                if(p->proxy)
+                {
+                    if(p->replicaGroupId != oldInfo.replicaGroupId)
+                    {
+                        _adaptersByGroupId.del(txn, oldInfo.replicaGroupId, p->id);
+                    }
+                    addAdapter(txn, *p);
+                    updates.push_back(AdapterUpdate(found ? "updated" : "added", updateSerial(txn, adaptersDbName),
+                                                    *p));
+                }
+                else if(found)
+                {
+                    deleteAdapter(txn, oldInfo);
+                    updates.push_back(AdapterUpdate("removed", updateSerial(txn, adaptersDbName), *p));
+                }
+            }
+
+            txn.commit();
+        }
+        catch(const IceDB::KeyTooLongException&)
+        {
+            throw;
+        }
+        catch(const IceDB::LMDBException& ex)
+        {
+            logError(_communicator, ex);
+            throw;
+        }
+
+        for(vector<AdapterUpdate>::const_iterator p = updates.begin(); p != updates.end(); ++p)
+        {
+            if(_traceLevels->adapter > 0)
+            {
+                Ice::Trace out(_traceLevels->logger, _traceLevels->adapterCat);
+                out << p->kind << " adapter `" << p->info.id << "'";
+                if(!p->info.replicaGroupId.empty())
+                {
+                    out << " with replica group `" << p->info.replicaGroupId << "'";
+                }
+                out << " (serial = `" << p->serial << "')";
+            }
+
+            if(p->kind == "added")
+            {
+                serial = _adapterObserverTopic->adapterAdded(p->serial, p->info);
+            }
+            else if(p->kind == "updated")
+            {
+                serial = _adapterObserverTopic->adapterUpdated(p->serial, p->info);
+            }
+            else
+            {
+                serial = _adapterObserverTopic->adapterRemoved(p->serial, p->info.id);
+            }
+        }
+    }
+    if(serial > 0)
+    {
+        _adapterObserverTopic->waitForSyncedSubscribers(serial);
+    }
+    return deployed;
+}
+
 Ice::ObjectPrx
 Database::getAdapterDirectProxy(const string& id, const Ice::EncodingVersion& encoding, const Ice::ConnectionPtr& con,
                                 const Ice::Context& ctx)
@@ -2545,6 +2655,12 @@ Database::finishApplicationUpdate(const ApplicationUpdateInfo& update,
 {
     const ApplicationDescriptor& newDesc = helper.getDefinition();
 
+    //
+    // With a rolling update, the master synchronizes the servers once
+    // the replicas are updated, a few servers at a time.
+    //
+    const bool rolling = _master && (_rollingUpdateNodeConcurrency > 0 || _rollingUpdateReplicaGroupConcurrency > 0);
+
     ServerEntrySeq entries;
     int serial = 0;
     try
@@ -2561,7 +2677,10 @@ Database::finishApplicationUpdate(const ApplicationUpdateInfo& update,
         checkForUpdate(previous, helper, txn);
         reload(previous, helper, entries, oldApp.uuid, oldApp.revision + 1, noRestart);
 
-        for_each(entries.begin(), entries.end(), IceUtil::voidMemFun(&ServerEntry::sync));
+        if(!rolling)
+        {
+            for_each(entries.begin(), entries.end(), IceUtil::voidMemFun(&ServerEntry::sync));
+        }
 
         ApplicationInfo info = oldApp;
         info.updateTime = update.updateTime;
@@ -2602,6 +2721,12 @@ Database::finishApplicationUpdate(const ApplicationUpdateInfo& update,
     {
         try
         {
+            if(rolling)
+            {
+                RollingUpdate(_traceLevels, _rollingUpdateNodeConcurrency, _rollingUpdateReplicaGroupConcurrency,
+                              _rollingUpdateHealthCheck).run(entries);
+            }
+
             for(ServerEntrySeq::const_iterator p = entries.begin(); p != entries.end(); ++p)
             {
                 try
@@ -115,6 +115,7 @@ public:
     AllocatableObjectEntryPtr getAllocatableObject(const Ice::Identity&) const;
 
     void setAdapterDirectProxy(const std::string&, const std::string&, const Ice::ObjectPrx&, Ice::Long = 0);
+    AdapterInfoSeq setAdapterDirectProxies(const AdapterInfoSeq&);
     Ice::ObjectPrx getAdapterDirectProxy(const std::string&, const Ice::EncodingVersion&, const Ice::ConnectionPtr&,
                                          const Ice::Context&);
 
@@ -214,6 +215,9 @@ private:
     const TraceLevelsPtr _traceLevels;
     const bool _master;
     const bool _readonly;
+    const int _rollingUpdateNodeConcurrency;
+    const int _rollingUpdateReplicaGroupConcurrency;
+    const bool _rollingUpdateHealthCheck;
 
     ReplicaCache _replicaCache;
     NodeCache _nodeCache;
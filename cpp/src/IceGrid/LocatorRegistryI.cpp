@@ -88,6 +88,65 @@ newSetDirectProxyCB(const AmdCB& cb, const TraceLevelsPtr& traceLevels, const st
     return new SetDirectProxyCB<AmdCB>(cb, traceLevels, id, p);
 }
 
+//
+// Collects the responses of the adapter registrations of a
+// setAdapterDirectProxies request. The request fails with the first
+// exception.
+//
+class SetDirectProxiesCB : public IceUtil::Shared, public IceUtil::Mutex
+{
+public:
+
+    SetDirectProxiesCB(const Ice::AMD_BatchLocatorRegistry_setAdapterDirectProxiesPtr& cb, int count) :
+        _cb(cb), _count(count)
+    {
+    }
+
+    void ice_response()
+    {
+        finished();
+    }
+
+    void ice_exception(const Ice::Exception& ex)
+    {
+        {
+            Lock sync(*this);
+            if(!_exception.get())
+            {
+                _exception.reset(ex.ice_clone());
+            }
+        }
+        finished();
+    }
+
+private:
+
+    void finished()
+    {
+        {
+            Lock sync(*this);
+            if(--_count > 0)
+            {
+                return;
+            }
+        }
+
+        if(_exception.get())
+        {
+            _cb->ice_exception(*_exception);
+        }
+        else
+        {
+            _cb->ice_response();
+        }
+    }
+
+    const Ice::AMD_BatchLocatorRegistry_setAdapterDirectProxiesPtr _cb;
+    int _count;
+    IceUtil::UniquePtr<Ice::Exception> _exception;
+};
+typedef IceUtil::Handle<SetDirectProxiesCB> SetDirectProxiesCBPtr;
+
 class ServerSetProcessCB : public virtual IceUtil::Shared
 {
 public:
@@ -344,6 +403,93 @@ LocatorRegistryI::setServerProcessProxy_async(const Ice::AMD_LocatorRegistry_set
     }
 }
 
+void
+LocatorRegistryI::setAdapterDirectProxies_async(const Ice::AMD_BatchLocatorRegistry_setAdapterDirectProxiesPtr& cb,
+                                                const Ice::AdapterDirectProxyInfoSeq& adapters,
+                                                const Ice::Current&)
+{
+    const TraceLevelsPtr traceLevels = _database->getTraceLevels();
+
+    //
+    // The dynamically registered adapters are set with a single
+    // database transaction on the master. The other adapters are set
+    // one by one, as with setAdapterDirectProxy.
+    //
+    AdapterInfoSeq infos;
+    for(Ice::AdapterDirectProxyInfoSeq::const_iterator p = adapters.begin(); p != adapters.end(); ++p)
+    {
+        if(p->id.empty())
+        {
+            continue; // Ignore adapters with an empty adapter id.
+        }
+        AdapterInfo info;
+        info.id = p->id;
+        info.replicaGroupId = p->replicaGroupId;
+        info.proxy = p->proxy;
+        infos.push_back(info);
+    }
+
+    if(_master && _dynamicRegistration)
+    {
+        try
+        {
+            AdapterInfoSeq deployed = _database->setAdapterDirectProxies(infos);
+            if(traceLevels->locator > 1)
+            {
+                set<string> deployedIds;
+                for(AdapterInfoSeq::const_iterator p = deployed.begin(); p != deployed.end(); ++p)
+                {
+                    deployedIds.insert(p->id);
+                }
+                for(AdapterInfoSeq::const_iterator p = infos.begin(); p != infos.end(); ++p)
+                {
+                    if(deployedIds.find(p->id) == deployedIds.end())
+                    {
+                        Ice::Trace out(traceLevels->logger, traceLevels->locatorCat);
+                        out << "registered adapter `" << p->id << "' endpoints: `";
+                        out << (p->proxy ? p->proxy->ice_toString() : string("")) << "'";
+                    }
+                }
+            }
+            infos.swap(deployed);
+        }
+        catch(const Ice::Exception& ex)
+        {
+            //
+            // Nothing is saved if the transaction fails. Register the
+            // adapters one by one instead, the request then fails with
+            // the exception of the adapter which can't be registered.
+            //
+            if(traceLevels->locator > 0)
+            {
+                Ice::Trace out(traceLevels->logger, traceLevels->locatorCat);
+                out << "couldn't register adapters endpoints, registering them one by one:\n" << toString(ex);
+            }
+        }
+    }
+
+    //
+    // The count includes this dispatch, so that the response isn't
+    // sent before all the registrations are started.
+    //
+    SetDirectProxiesCBPtr callback = new SetDirectProxiesCB(cb, static_cast<int>(infos.size()) + 1);
+    for(AdapterInfoSeq::const_iterator p = infos.begin(); p != infos.end(); ++p)
+    {
+        try
+        {
+            setAdapterDirectProxy(newSetDirectProxyCB(callback, traceLevels, p->id, p->proxy),
+                                  p->id,
+                                  p->replicaGroupId,
+                                  p->proxy);
+        }
+        catch(const Ice::Exception& ex)
+        {
+            callback->ice_exception(ex);
+        }
+    }
+    callback->ice_response();
+}
+
 void
 LocatorRegistryI::setAdapterDirectProxy(const LocatorRegistryI::AdapterSetDirectProxyCBPtr& amiCB,
                                         const string& adapterId, 
@@ -25,7 +25,7 @@ typedef IceUtil::Handle<TraceLevels> TraceLevelsPtr;
 
 class ReplicaSessionManager;
 
-class LocatorRegistryI : public Ice::LocatorRegistry
+class LocatorRegistryI : public Ice::BatchLocatorRegistry
 {
 public:
     
@@ -50,6 +50,9 @@ public:
     virtual void setServerProcessProxy_async(const Ice::AMD_LocatorRegistry_setServerProcessProxyPtr&,
                                              const ::std::string&, const ::Ice::ProcessPrx&, const ::Ice::Current&);
 
+    virtual void setAdapterDirectProxies_async(const Ice::AMD_BatchLocatorRegistry_setAdapterDirectProxiesPtr&,
+                                               const Ice::AdapterDirectProxyInfoSeq&, const Ice::Current&);
+
     void setAdapterDirectProxy(const AdapterSetDirectProxyCBPtr&, const std::string&, const std::string&,
                                const Ice::ObjectPrx&);
 
@@ -16,6 +16,13 @@ using namespace IceGrid;
 namespace
 {
 
+//
+// Reapables without timeout are only reaped on shutdown or when their
+// connection is closed. They are checked at this interval to release
+// the ones which have been destroyed.
+//
+const IceUtil::Time livenessCheckInterval = IceUtil::Time::seconds(10);
+
 class CloseCallbackI : public Ice::CloseCallback
 {
 public:
@@ -77,18 +84,21 @@ ReapThread::run()
                 break;
             }
 
-            calcWakeInterval();
-
             //
-            // If the wake interval is zero then we wait forever.
+            // Wait until the next reapable is due, forever if there
+            // are no reapables.
             //
-            if(_wakeInterval == IceUtil::Time())
+            if(_sessions.empty())
             {
                 wait();
             }
             else
             {
-                timedWait(_wakeInterval);
+                IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+                if(_sessions.begin()->first > now)
+                {
+                    timedWait(_sessions.begin()->first - now);
+                }
             }
 
             if(_terminated)
@@ -96,49 +106,37 @@ ReapThread::run()
                 break;
             }
 
-            list<ReapableItem>::iterator p = _sessions.begin();
-            while(p != _sessions.end())
+            //
+            // Only check the reapables which are due. Reapables which
+            // have been kept alive in the meantime are re-scheduled
+            // with their new expiry time.
+            //
+            IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+            while(!_sessions.empty() && _sessions.begin()->first <= now)
             {
+                ReapableItem item = _sessions.begin()->second;
+                _sessions.erase(_sessions.begin());
                 try
                 {
-                    if(p->timeout == IceUtil::Time())
+                    if(item.timeout == IceUtil::Time())
                     {
-                        p->item->timestamp(); // This should throw if the reapable is destroyed.
-                        ++p;
+                        item.item->timestamp(); // This should throw if the reapable is destroyed.
+                        schedule(item, now + livenessCheckInterval);
                         continue;
                     }
-                    else if((IceUtil::Time::now(IceUtil::Time::Monotonic) - p->item->timestamp()) > p->timeout)
-                    {
-                        reap.push_back(*p);
-                    }
-                    else
+
+                    IceUtil::Time expires = item.item->timestamp() + item.timeout;
+                    if(expires > now)
                     {
-                        ++p;
+                        schedule(item, expires);
                         continue;
                     }
+                    reap.push_back(item);
                 }
                 catch(const Ice::ObjectNotExistException&)
                 {
                 }
-
-                //
-                // Remove the reapable
-                //
-                if(p->connection)
-                {
-                    map<Ice::ConnectionPtr, set<ReapablePtr> >::iterator q = _connections.find(p->connection);
-                    if(q != _connections.end())
-                    {
-                        q->second.erase(p->item);
-                        if(q->second.empty())
-                        {
-                            p->connection->setCloseCallback(0);
-                            p->connection->setHeartbeatCallback(0);
-                            _connections.erase(q);
-                        }
-                    }
-                }
-                p = _sessions.erase(p);
+                remove(item);
             }
         }
 
@@ -153,7 +151,7 @@ ReapThread::run()
 void
 ReapThread::terminate()
 {
-    list<ReapableItem> reap;
+    multimap<IceUtil::Time, ReapableItem> reap;
     {
         Lock sync(*this);
         if(_terminated)
@@ -175,9 +173,9 @@ ReapThread::terminate()
         _heartbeatCallback = 0;
     }
 
-    for(list<ReapableItem>::iterator p = reap.begin(); p != reap.end(); ++p)
+    for(multimap<IceUtil::Time, ReapableItem>::iterator p = reap.begin(); p != reap.end(); ++p)
     {
-        p->item->destroy(true);
+        p->second.item->destroy(true);
     }
 }
 
@@ -207,7 +205,9 @@ ReapThread::add(const ReapablePtr& reapable, int timeout, const Ice::ConnectionP
     item.item = reapable;
     item.connection = connection;
     item.timeout = timeout == 0 ? IceUtil::Time() : IceUtil::Time::seconds(timeout);
-    _sessions.push_back(item);
+
+    IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    schedule(item, now + (timeout == 0 ? livenessCheckInterval : item.timeout));
 
     if(connection)
     {
@@ -221,24 +221,6 @@ ReapThread::add(const ReapablePtr& reapable, int timeout, const Ice::ConnectionP
         }
         p->second.insert(reapable);
     }
-
-    if(timeout > 0)
-    {
-        //
-        // If there is a new minimum wake interval then wake the reaping
-        // thread.
-        //
-        if(calcWakeInterval())
-        {
-            notify();
-        }
-
-        //
-        // Since we just added a new session with a non null timeout there
-        // must be a non-zero wakeInterval.
-        //
-        assert(_wakeInterval != IceUtil::Time());
-    }
 }
 
 void
@@ -278,26 +260,35 @@ ReapThread::connectionClosed(const Ice::ConnectionPtr& con)
     _connections.erase(p);
 }
 
-//
-// Returns true if the calculated wake interval is less than the current wake
-// interval (or if the original wake interval was "forever").
-//
-bool
-ReapThread::calcWakeInterval()
+void
+ReapThread::schedule(const ReapableItem& item, const IceUtil::Time& time)
 {
-    // Re-calculate minimum timeout
-    IceUtil::Time oldWakeInterval = _wakeInterval;
-    IceUtil::Time minimum;
-    bool first = true;
-    for(list<ReapableItem>::const_iterator p = _sessions.begin(); p != _sessions.end(); ++p)
+    //
+    // Wake up the reaper thread if the reapable is due before the
+    // reapable it's currently waiting for.
+    //
+    if(_sessions.empty() || time < _sessions.begin()->first)
     {
-        if(p->timeout != IceUtil::Time() && (first || p->timeout < minimum))
+        notify();
+    }
+    _sessions.insert(make_pair(time, item));
+}
+
+void
+ReapThread::remove(const ReapableItem& item)
+{
+    if(item.connection)
+    {
+        map<Ice::ConnectionPtr, set<ReapablePtr> >::iterator q = _connections.find(item.connection);
+        if(q != _connections.end())
         {
-            minimum = p->timeout;
-            first = false;
+            q->second.erase(item.item);
+            if(q->second.empty())
+            {
+                item.connection->setCloseCallback(0);
+                item.connection->setHeartbeatCallback(0);
+                _connections.erase(q);
+            }
         }
     }
-
-    _wakeInterval = minimum;
-    return oldWakeInterval == IceUtil::Time() || minimum < oldWakeInterval;
 }
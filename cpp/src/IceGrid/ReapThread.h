@@ -19,7 +19,8 @@
 #include <Ice/LoggerUtil.h>
 #include <Ice/Connection.h>
 
-#include <list>
+#include <map>
+#include <set>
 
 namespace IceGrid
 {
@@ -131,19 +132,26 @@ public:
 
 private:
 
-    bool calcWakeInterval();
-
-    Ice::CloseCallbackPtr _closeCallback;
-    Ice::HeartbeatCallbackPtr _heartbeatCallback;
-    IceUtil::Time _wakeInterval;
-    bool _terminated;
     struct ReapableItem
     {
         ReapablePtr item;
         Ice::ConnectionPtr connection;
         IceUtil::Time timeout;
     };
-    std::list<ReapableItem> _sessions;
+
+    void schedule(const ReapableItem&, const IceUtil::Time&);
+    void remove(const ReapableItem&);
+
+    Ice::CloseCallbackPtr _closeCallback;
+    Ice::HeartbeatCallbackPtr _heartbeatCallback;
+    bool _terminated;
+
+    //
+    // The reapables ordered by the time at which they need to be
+    // checked next. This is the expiry time computed from the last
+    // known timestamp for reapables with a timeout.
+    //
+    std::multimap<IceUtil::Time, ReapableItem> _sessions;
 
     std::map<Ice::ConnectionPtr, std::set<ReapablePtr> > _connections;
 };
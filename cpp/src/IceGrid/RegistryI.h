@@ -78,6 +78,7 @@ public:
     Ice::ObjectPrx createAdminCallbackProxy(const Ice::Identity&) const;
 
     const Ice::ObjectAdapterPtr& getRegistryAdapter() { return _registryAdapter; }
+    const IceUtil::TimerPtr& getTimer() const { return _timer; }
 
     Ice::LocatorPrx getLocator();
 
@@ -1284,3 +1284,360 @@ ServerEntry::releasedNoSync(const SessionIPtr& /*session*/)
     sync();
     waitForSyncNoThrow();
 }
+
+namespace
+{
+
+class RollingUpdateCallback : public SynchronizationCallback
+{
+public:
+
+    RollingUpdateCallback(RollingUpdate& update, const ServerEntryPtr& entry) : _update(update), _entry(entry)
+    {
+    }
+
+    virtual void
+    synchronized()
+    {
+        _update.synchronized(_entry);
+    }
+
+    virtual void
+    synchronized(const Ice::Exception&)
+    {
+        _update.synchronized(_entry);
+    }
+
+private:
+
+    RollingUpdate& _update;
+    const ServerEntryPtr _entry;
+};
+
+void
+addReplicaGroups(const CommunicatorDescriptorPtr& desc, set<string>& replicaGroups)
+{
+    for(AdapterDescriptorSeq::const_iterator p = desc->adapters.begin(); p != desc->adapters.end(); ++p)
+    {
+        if(!p->replicaGroupId.empty())
+        {
+            replicaGroups.insert(p->replicaGroupId);
+        }
+    }
+}
+
+}
+
+RollingUpdate::RollingUpdate(const TraceLevelsPtr& traceLevels, int nodeConcurrency, int replicaGroupConcurrency,
+                             bool healthCheck) :
+    _traceLevels(traceLevels),
+    _nodeConcurrency(nodeConcurrency),
+    _replicaGroupConcurrency(replicaGroupConcurrency),
+    _healthCheck(healthCheck)
+{
+}
+
+void
+RollingUpdate::run(const ServerEntrySeq& entries)
+{
+    list<Server> pending;
+    for(ServerEntrySeq::const_iterator p = entries.begin(); p != entries.end(); ++p)
+    {
+        Server server;
+        server.entry = *p;
+        server.checkHealth = false;
+        try
+        {
+            ServerInfo info = (*p)->getInfo();
+            server.node = info.node;
+            server.checkHealth = _healthCheck && info.descriptor->activation == "always";
+            addReplicaGroups(info.descriptor, server.replicaGroups);
+            IceBoxDescriptorPtr iceBox = IceBoxDescriptorPtr::dynamicCast(info.descriptor);
+            if(iceBox)
+            {
+                for(ServiceInstanceDescriptorSeq::const_iterator q = iceBox->services.begin();
+                    q != iceBox->services.end(); ++q)
+                {
+                    if(q->descriptor)
+                    {
+                        addReplicaGroups(q->descriptor, server.replicaGroups);
+                    }
+                }
+            }
+        }
+        catch(const ServerNotExistException&)
+        {
+        }
+        pending.push_back(server);
+    }
+
+    list<Server> running;
+    string failure;
+
+    Lock sync(*this);
+    while(true)
+    {
+        //
+        // Start the synchronization of the servers which don't exceed
+        // the limits, unless a server failed to update.
+        //
+        list<Server>::iterator p = pending.begin();
+        while(failure.empty() && p != pending.end())
+        {
+            if(!canStart(*p))
+            {
+                ++p;
+                continue;
+            }
+
+            acquire(*p);
+            ServerEntryPtr entry = p->entry;
+            running.splice(running.end(), pending, p++);
+
+            if(_traceLevels && _traceLevels->application > 1)
+            {
+                Ice::Trace out(_traceLevels->logger, _traceLevels->applicationCat);
+                out << "updating server `" << entry->getId() << "' (" << running.size() << " in progress, "
+                    << pending.size() << " pending)";
+            }
+
+            sync.release();
+            bool synchronizing = false;
+            entry->sync();
+            try
+            {
+                synchronizing = entry->addSyncCallback(new RollingUpdateCallback(*this, entry));
+            }
+            catch(const ServerNotExistException&)
+            {
+            }
+            sync.acquire();
+
+            if(!synchronizing)
+            {
+                _synchronized.push_back(entry);
+            }
+        }
+
+        if(running.empty())
+        {
+            break;
+        }
+
+        bool checking = false;
+        for(list<Server>::const_iterator q = running.begin(); q != running.end(); ++q)
+        {
+            checking |= q->proxy != 0;
+        }
+
+        if(_synchronized.empty())
+        {
+            if(checking)
+            {
+                timedWait(IceUtil::Time::seconds(1));
+            }
+            else
+            {
+                wait();
+            }
+        }
+
+        vector<ServerEntryPtr> synchronized;
+        synchronized.swap(_synchronized);
+        for(vector<ServerEntryPtr>::const_iterator q = synchronized.begin(); q != synchronized.end(); ++q)
+        {
+            list<Server>::iterator r = running.begin();
+            while(r->entry != *q)
+            {
+                ++r;
+            }
+
+            sync.release();
+            try
+            {
+                r->entry->waitForSync(0);
+                if(r->checkHealth && failure.empty())
+                {
+                    int activationTimeout, deactivationTimeout;
+                    string node;
+                    r->proxy = r->entry->getProxy(activationTimeout, deactivationTimeout, node, false);
+
+                    //
+                    // The server is deactivated and activated again by
+                    // the update.
+                    //
+                    int timeout = (activationTimeout > 0 ? activationTimeout : 60) +
+                        (deactivationTimeout > 0 ? deactivationTimeout : 60);
+                    r->deadline = IceUtil::Time::now(IceUtil::Time::Monotonic) + IceUtil::Time::seconds(timeout);
+                }
+            }
+            catch(const DeploymentException& ex)
+            {
+                if(failure.empty())
+                {
+                    failure = ex.reason;
+                }
+            }
+            catch(const Ice::Exception&)
+            {
+                //
+                // The node is unreachable or the server was removed, the
+                // server is updated once the node is reachable again.
+                //
+            }
+            sync.acquire();
+
+            if(!r->proxy)
+            {
+                release(*r);
+                running.erase(r);
+            }
+        }
+
+        //
+        // Check the health of the synchronized servers which hold their
+        // slots until they are activated again.
+        //
+        list<Server>::iterator q = running.begin();
+        while(q != running.end())
+        {
+            bool done = !failure.empty();
+            if(q->proxy && !done)
+            {
+                try
+                {
+                    done = checkHealth(*q);
+                }
+                catch(const DeploymentException& ex)
+                {
+                    failure = ex.reason;
+                    done = true;
+                }
+            }
+
+            if(q->proxy && done)
+            {
+                release(*q);
+                q = running.erase(q);
+            }
+            else
+            {
+                ++q;
+            }
+        }
+    }
+
+    if(!failure.empty())
+    {
+        throw DeploymentException(failure);
+    }
+}
+
+void
+RollingUpdate::synchronized(const ServerEntryPtr& entry)
+{
+    Lock sync(*this);
+    _synchronized.push_back(entry);
+    notify();
+}
+
+bool
+RollingUpdate::canStart(const Server& server) const
+{
+    if(_nodeConcurrency > 0)
+    {
+        map<string, int>::const_iterator p = _nodes.find(server.node);
+        if(p != _nodes.end() && p->second >= _nodeConcurrency)
+        {
+            return false;
+        }
+    }
+    if(_replicaGroupConcurrency > 0)
+    {
+        for(set<string>::const_iterator q = server.replicaGroups.begin(); q != server.replicaGroups.end(); ++q)
+        {
+            map<string, int>::const_iterator p = _replicaGroups.find(*q);
+            if(p != _replicaGroups.end() && p->second >= _replicaGroupConcurrency)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void
+RollingUpdate::acquire(const Server& server)
+{
+    ++_nodes[server.node];
+    for(set<string>::const_iterator q = server.replicaGroups.begin(); q != server.replicaGroups.end(); ++q)
+    {
+        ++_replicaGroups[*q];
+    }
+}
+
+void
+RollingUpdate::release(const Server& server)
+{
+    if(--_nodes[server.node] == 0)
+    {
+        _nodes.erase(server.node);
+    }
+    for(set<string>::const_iterator q = server.replicaGroups.begin(); q != server.replicaGroups.end(); ++q)
+    {
+        if(--_replicaGroups[*q] == 0)
+        {
+            _replicaGroups.erase(*q);
+        }
+    }
+}
+
+bool
+RollingUpdate::checkHealth(Server& server)
+{
+    IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    if(server.state)
+    {
+        if(server.state->isCompleted())
+        {
+            ServerState state;
+            try
+            {
+                state = server.proxy->end_getState(server.state);
+            }
+            catch(const Ice::Exception&)
+            {
+                return true; // The node is unreachable or the server was removed.
+            }
+            server.state = 0;
+
+            if(state == Active)
+            {
+                return true;
+            }
+            else if(state == ActivationTimedOut)
+            {
+                throw DeploymentException("server `" + server.entry->getId() + "' activation timed out");
+            }
+        }
+    }
+
+    if(now > server.deadline)
+    {
+        throw DeploymentException("server `" + server.entry->getId() + "' wasn't activated after the update");
+    }
+
+    if(!server.state && now >= server.nextCheck)
+    {
+        try
+        {
+            server.state = server.proxy->begin_getState();
+        }
+        catch(const Ice::Exception&)
+        {
+            return true;
+        }
+        server.nextCheck = now + IceUtil::Time::seconds(1);
+    }
+    return false;
+}
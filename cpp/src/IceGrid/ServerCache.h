@@ -11,6 +11,7 @@
 #define ICE_GRID_SERVERCACHE_H
 
 #include <IceUtil/Mutex.h>
+#include <IceUtil/Monitor.h>
 #include <IceUtil/Shared.h>
 #include <IceGrid/Descriptor.h>
 #include <IceGrid/Internal.h>
@@ -171,6 +172,56 @@ private:
     AllocatableObjectCache& _allocatableObjectCache;
 };
 
+//
+// RollingUpdate synchronizes the servers of an application update
+// with at most nodeConcurrency servers synchronizing at the same time
+// on a node and at most replicaGroupConcurrency servers with adapters
+// in the same replica group (0 means unlimited). With health checking,
+// a server whose activation mode is `always' holds its slots until it
+// is active again, that is until its server lifetime adapters are
+// activated. run returns once all the servers are synchronized, or
+// throws DeploymentException once the synchronizations in progress
+// are done if a server couldn't be updated or failed to activate.
+//
+class RollingUpdate : public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    RollingUpdate(const TraceLevelsPtr&, int, int, bool);
+
+    void run(const ServerEntrySeq&);
+
+    void synchronized(const ServerEntryPtr&);
+
+private:
+
+    struct Server
+    {
+        ServerEntryPtr entry;
+        std::string node;
+        std::set<std::string> replicaGroups;
+        bool checkHealth;
+        ServerPrx proxy;
+        Ice::AsyncResultPtr state;
+        IceUtil::Time deadline;
+        IceUtil::Time nextCheck;
+    };
+
+    bool canStart(const Server&) const;
+    void acquire(const Server&);
+    void release(const Server&);
+    bool checkHealth(Server&);
+
+    const TraceLevelsPtr _traceLevels;
+    const int _nodeConcurrency;
+    const int _replicaGroupConcurrency;
+    const bool _healthCheck;
+
+    std::map<std::string, int> _nodes;
+    std::map<std::string, int> _replicaGroups;
+    std::vector<ServerEntryPtr> _synchronized;
+};
+
 };
 
 #endif
@@ -11,6 +11,7 @@
 #include <IceSSL/TrustManager.h>
 
 #include <IceUtil/StringUtil.h>
+#include <IceUtil/SHA1.h>
 
 #include <Ice/Communicator.h>
 #include <Ice/Properties.h>
@@ -29,7 +30,8 @@ IceUtil::Shared* IceSSL::upCast(IceSSL::SSLEngine* p) { return p; }
 IceSSL::SSLEngine::SSLEngine(const Ice::CommunicatorPtr& communicator) :
     _communicator(communicator),
     _logger(communicator->getLogger()),
-    _trustManager(new TrustManager(communicator))
+    _trustManager(new TrustManager(communicator)),
+    _verifiedCacheSize(0)
 {
 }
 
@@ -125,6 +127,18 @@ IceSSL::SSLEngine::initialize()
 
     _securityTraceLevel = properties->getPropertyAsInt("IceSSL.Trace.Security");
     _securityTraceCategory = "Security";
+
+    //
+    // VerifyCacheSize is the maximum number of peer certificates for which
+    // the host name and trust manager verifications are cached. A value of
+    // 0 disables the cache.
+    //
+#if defined(ICE_USE_SECURE_TRANSPORT_IOS)
+    _verifiedCacheSize = 0; // The certificate validity can't be checked on iOS.
+#else
+    int verifyCacheSize = properties->getPropertyAsIntWithDefault(propPrefix + "VerifyCacheSize", 100);
+    _verifiedCacheSize = verifyCacheSize > 0 ? static_cast<size_t>(verifyCacheSize) : 0;
+#endif
 }
 
 void
@@ -132,12 +146,21 @@ IceSSL::SSLEngine::verifyPeer(const string& address, const NativeConnectionInfoP
 {
     const CertificateVerifierPtr verifier = getCertificateVerifier();
 
+    //
+    // The host name and trust manager verifications are skipped if the
+    // peer certificate already passed them for this address and adapter.
+    // The certificate verifier and the chain length are always checked.
+    //
+    const string key = verifiedKey(address, info);
+    const bool verified = !key.empty() && isVerified(key, info);
+    bool cache = !key.empty() && !verified;
+
 #if !defined(ICE_USE_SECURE_TRANSPORT_IOS)
     //
     // For an outgoing connection, we compare the proxy address (if any) against
     // fields in the server's certificate (if any).
     //
-    if(!info->nativeCerts.empty() && !address.empty())
+    if(!verified && !info->nativeCerts.empty() && !address.empty())
     {
         const CertificatePtr cert = info->nativeCerts[0];
         //
@@ -197,6 +220,11 @@ IceSSL::SSLEngine::verifyPeer(const string& address, const NativeConnectionInfoP
         // we also raise an exception to abort the connection. Don't log a message if
         // CheckCertName is not defined and a verifier is present.
         //
+        if(!certNameOK)
+        {
+            cache = false; // Don't cache ignored failures, they are traced for each connection.
+        }
+
         if(!certNameOK && (_checkCertName || (_securityTraceLevel >= 1 && !verifier)))
         {
             ostringstream ostr;
@@ -267,7 +295,7 @@ IceSSL::SSLEngine::verifyPeer(const string& address, const NativeConnectionInfoP
         throw ex;
     }
 
-    if(!_trustManager->verify(info, desc))
+    if(!verified && !_trustManager->verify(info, desc))
     {
         string msg = string(info->incoming ? "incoming" : "outgoing") + " connection rejected by trust manager";
         if(_securityTraceLevel >= 1)
@@ -279,6 +307,11 @@ IceSSL::SSLEngine::verifyPeer(const string& address, const NativeConnectionInfoP
         throw ex;
     }
 
+    if(cache)
+    {
+        addVerified(key);
+    }
+
     if(verifier && !verifier->verify(info))
     {
         string msg = string(info->incoming ? "incoming" : "outgoing") + " connection rejected by certificate verifier";
@@ -291,3 +324,76 @@ IceSSL::SSLEngine::verifyPeer(const string& address, const NativeConnectionInfoP
         throw ex;
     }
 }
+
+string
+IceSSL::SSLEngine::verifiedKey(const string& address, const NativeConnectionInfoPtr& info) const
+{
+    if(_verifiedCacheSize == 0 || info->certs.empty() || info->nativeCerts.empty())
+    {
+        return string();
+    }
+
+    //
+    // The key is the SHA-1 fingerprint of the encoded peer certificate,
+    // the connection direction, the adapter name and the peer address,
+    // which are all the inputs of the cached verifications.
+    //
+    const string& cert = info->certs[0];
+    vector<unsigned char> fingerprint;
+    IceUtilInternal::sha1(reinterpret_cast<const unsigned char*>(cert.data()), cert.size(), fingerprint);
+
+    string key(fingerprint.begin(), fingerprint.end());
+    key += info->incoming ? 'i' : 'o';
+    key += info->adapterName;
+    key += '\0';
+    key += IceUtilInternal::toLower(address);
+    return key;
+}
+
+bool
+IceSSL::SSLEngine::isVerified(const string& key, const NativeConnectionInfoPtr& info)
+{
+    {
+        IceUtil::Mutex::Lock sync(_verifiedMutex);
+        if(_verified.find(key) == _verified.end())
+        {
+            return false;
+        }
+    }
+
+#if !defined(ICE_USE_SECURE_TRANSPORT_IOS)
+    //
+    // Entries are only valid as long as the certificate is valid.
+    //
+    if(!info->nativeCerts[0]->checkValidity())
+    {
+        return false;
+    }
+#endif
+
+    if(_securityTraceLevel >= 2)
+    {
+        Trace out(_logger, _securityTraceCategory);
+        out << "using cached verification of peer certificate\nsubject = "
+            << string(info->nativeCerts[0]->getSubjectDN());
+    }
+    return true;
+}
+
+void
+IceSSL::SSLEngine::addVerified(const string& key)
+{
+    IceUtil::Mutex::Lock sync(_verifiedMutex);
+    pair<set<string>::iterator, bool> r = _verified.insert(key);
+    if(!r.second)
+    {
+        return; // Already cached, by a concurrent connection or before the certificate expired.
+    }
+    _verifiedQueue.push_back(r.first);
+
+    while(_verifiedQueue.size() > _verifiedCacheSize)
+    {
+        _verified.erase(_verifiedQueue.front());
+        _verifiedQueue.pop_front();
+    }
+}
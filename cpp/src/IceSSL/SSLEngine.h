@@ -20,6 +20,9 @@
 #include <Ice/CommunicatorF.h>
 #include <Ice/Network.h>
 
+#include <deque>
+#include <set>
+
 #if defined(ICE_USE_SECURE_TRANSPORT)
 #   include <Security/Security.h>
 #   include <Security/SecureTransport.h>
@@ -88,10 +91,24 @@ public:
 
 private:
 
+    std::string verifiedKey(const std::string&, const NativeConnectionInfoPtr&) const;
+    bool isVerified(const std::string&, const NativeConnectionInfoPtr&);
+    void addVerified(const std::string&);
+
     const Ice::CommunicatorPtr _communicator;
     const Ice::LoggerPtr _logger;
     const TrustManagerPtr _trustManager;
 
+    //
+    // Peer certificates which passed the host name and trust manager
+    // verifications, keyed by certificate fingerprint, peer address
+    // and object adapter. The oldest entries are evicted first.
+    //
+    size_t _verifiedCacheSize;
+    std::set<std::string> _verified;
+    std::deque<std::set<std::string>::iterator> _verifiedQueue;
+    IceUtil::Mutex _verifiedMutex;
+
     std::string _password;
     CertificateVerifierPtr _verifier;
     PasswordPromptPtr _prompt;
@@ -15,6 +15,93 @@ using namespace std;
 using namespace IceStorm;
 using namespace IceStormElection;
 
+namespace
+{
+
+class CreateTopicUpdate : public ObserverUpdate
+{
+public:
+
+    CreateTopicUpdate(const LogUpdate& llu, const string& name) :
+        ObserverUpdate("createTopic"), _llu(llu), _name(name)
+    {
+    }
+
+    virtual Ice::AsyncResultPtr send(const ReplicaObserverPrx& observer, const Ice::CallbackPtr& cb)
+    {
+        return observer->begin_createTopic(_llu, _name, cb);
+    }
+
+private:
+
+    const LogUpdate _llu;
+    const string _name;
+};
+
+class DestroyTopicUpdate : public ObserverUpdate
+{
+public:
+
+    DestroyTopicUpdate(const LogUpdate& llu, const string& id) :
+        ObserverUpdate("destroyTopic"), _llu(llu), _id(id)
+    {
+    }
+
+    virtual Ice::AsyncResultPtr send(const ReplicaObserverPrx& observer, const Ice::CallbackPtr& cb)
+    {
+        return observer->begin_destroyTopic(_llu, _id, cb);
+    }
+
+private:
+
+    const LogUpdate _llu;
+    const string _id;
+};
+
+class AddSubscriberUpdate : public ObserverUpdate
+{
+public:
+
+    AddSubscriberUpdate(const LogUpdate& llu, const string& name, const SubscriberRecord& rec) :
+        ObserverUpdate("addSubscriber"), _llu(llu), _name(name), _rec(rec)
+    {
+    }
+
+    virtual Ice::AsyncResultPtr send(const ReplicaObserverPrx& observer, const Ice::CallbackPtr& cb)
+    {
+        return observer->begin_addSubscriber(_llu, _name, _rec, cb);
+    }
+
+private:
+
+    const LogUpdate _llu;
+    const string _name;
+    const SubscriberRecord _rec;
+};
+
+class RemoveSubscriberUpdate : public ObserverUpdate
+{
+public:
+
+    RemoveSubscriberUpdate(const LogUpdate& llu, const string& name, const Ice::IdentitySeq& id) :
+        ObserverUpdate("removeSubscriber"), _llu(llu), _name(name), _id(id)
+    {
+    }
+
+    virtual Ice::AsyncResultPtr send(const ReplicaObserverPrx& observer, const Ice::CallbackPtr& cb)
+    {
+        return observer->begin_removeSubscriber(_llu, _name, _id, cb);
+    }
+
+private:
+
+    const LogUpdate _llu;
+    const string _name;
+    const Ice::IdentitySeq _id;
+};
+
+}
+
 Observers::Observers(const InstancePtr& instance) :
     _traceLevels(instance->traceLevels()),
     _majority(0)
@@ -30,34 +117,58 @@ Observers::setMajority(unsigned int majority)
 bool
 Observers::check()
 {
-    Lock sync(*this);
-    if(_observers.size() >= _majority)
+    //
+    // Observers with updates in progress don't need to be pinged, a
+    // failure of the update reaps them. The idle observers are
+    // pinged in parallel and without holding the lock so that update
+    // completions aren't delayed.
+    //
+    vector<ObserverInfo> idle;
     {
-        vector<ObserverInfo>::iterator p = _observers.begin();
-        while(p != _observers.end())
+        Lock sync(*this);
+        if(_observers.size() < _majority)
         {
-            try
-            {
-                p->observer->ice_ping();
-            }
-            catch(const Ice::Exception& ex)
+            return _majority == 0;
+        }
+        for(vector<ObserverInfo>::const_iterator p = _observers.begin(); p != _observers.end(); ++p)
+        {
+            if(!p->result)
             {
-                if(_traceLevels->replication > 0)
-                {
-                    Ice::Trace out(_traceLevels->logger, _traceLevels->replicationCat);
-                    out << "ice_ping failed: " << ex;
-                }
-                int id = p->id;
-                p = _observers.erase(p);
-
-                // COMPILERFIX: Just using following causes double unlock with C++Builder 2007
-                //IceUtil::Mutex::Lock sync(_reapedMutex);
-                _reapedMutex.lock();
-                _reaped.push_back(id);
-                _reapedMutex.unlock();
-                continue;
+                idle.push_back(ObserverInfo(p->id, p->observer));
             }
-            ++p;
+        }
+    }
+
+    for(vector<ObserverInfo>::iterator p = idle.begin(); p != idle.end(); ++p)
+    {
+        p->result = p->observer->begin_ice_ping();
+    }
+
+    vector<int> failed;
+    for(vector<ObserverInfo>::iterator p = idle.begin(); p != idle.end(); ++p)
+    {
+        try
+        {
+            p->observer->end_ice_ping(p->result);
+        }
+        catch(const Ice::Exception& ex)
+        {
+            trace("ice_ping", ex);
+            failed.push_back(p->id);
+        }
+    }
+
+    Lock sync(*this);
+    for(vector<int>::const_iterator p = failed.begin(); p != failed.end(); ++p)
+    {
+        vector<ObserverInfo>::iterator q = _observers.begin();
+        while(q != _observers.end() && q->id != *p)
+        {
+            ++q;
+        }
+        if(q != _observers.end())
+        {
+            reap(q);
         }
     }
     return _majority == 0 || _observers.size() >= _majority;
@@ -67,7 +178,7 @@ void
 Observers::clear()
 {
     Lock sync(*this);
-    _observers.clear();
+    clearObservers();
 }
 
 void
@@ -86,7 +197,7 @@ Observers::init(const set<GroupNodeInfo>& slaves, const LogUpdate& llu, const To
     }
 
     Lock sync(*this);
-    _observers.clear();
+    clearObservers();
 
     vector<ObserverInfo> observers;
 
@@ -136,81 +247,181 @@ Observers::init(const set<GroupNodeInfo>& slaves, const LogUpdate& llu, const To
 void
 Observers::createTopic(const LogUpdate& llu, const string& name)
 {
-    Lock sync(*this);
-    for(vector<ObserverInfo>::iterator p = _observers.begin(); p != _observers.end(); ++p)
-    {
-        p->result = p->observer->begin_createTopic(llu, name);
-    }
-    wait("createTopic");
+    replicate(new CreateTopicUpdate(llu, name));
 }
 
 void
 Observers::destroyTopic(const LogUpdate& llu, const string& id)
 {
-    Lock sync(*this);
-    for(vector<ObserverInfo>::iterator p = _observers.begin(); p != _observers.end(); ++p)
-    {
-        p->result = p->observer->begin_destroyTopic(llu, id);
-    }
-    wait("destroyTopic");
+    replicate(new DestroyTopicUpdate(llu, id));
 }
 
-
 void
 Observers::addSubscriber(const LogUpdate& llu, const string& name, const SubscriberRecord& rec)
 {
-    Lock sync(*this);
-    for(vector<ObserverInfo>::iterator p = _observers.begin(); p != _observers.end(); ++p)
-    {
-        p->result = p->observer->begin_addSubscriber(llu, name, rec);
-    }
-    wait("addSubscriber");
+    replicate(new AddSubscriberUpdate(llu, name, rec));
 }
 
 void
 Observers::removeSubscriber(const LogUpdate& llu, const string& name, const Ice::IdentitySeq& id)
 {
-    Lock sync(*this);
-    for(vector<ObserverInfo>::iterator p = _observers.begin(); p != _observers.end(); ++p)
-    {
-        p->result = p->observer->begin_removeSubscriber(llu, name, id);
-    }
-    wait("removeSubscriber");
+    replicate(new RemoveSubscriberUpdate(llu, name, id));
 }
 
 void
-Observers::wait(const string& op)
+Observers::completed(const Ice::AsyncResultPtr& result)
 {
+    Lock sync(*this);
     vector<ObserverInfo>::iterator p = _observers.begin();
-    while(p != _observers.end())
+    while(p != _observers.end() && p->result != result)
+    {
+        ++p;
+    }
+    if(p == _observers.end())
+    {
+        return; // The observer was reaped or the observers were cleared.
+    }
+
+    ObserverUpdatePtr update = p->pending.front();
+    try
+    {
+        result->throwLocalException();
+    }
+    catch(const Ice::Exception& ex)
+    {
+        trace(update->op, ex);
+        reap(p);
+        return;
+    }
+
+    p->pending.pop_front();
+    p->result = 0;
+    --update->outstanding;
+    ++update->acknowledged;
+
+    //
+    // Send the next queued update to this observer, updates are sent
+    // one at a time to each observer to preserve their order.
+    //
+    if(!p->pending.empty())
     {
         try
         {
-            p->result->waitForCompleted();
-            p->result->throwLocalException();
+            send(*p);
         }
         catch(const Ice::Exception& ex)
         {
-            if(_traceLevels->replication > 0)
+            trace(p->pending.front()->op, ex);
+            reap(p);
+        }
+    }
+    notifyAll();
+}
+
+void
+Observers::replicate(const ObserverUpdatePtr& update)
+{
+    Lock sync(*this);
+
+    //
+    // Queue the update with each observer. It's sent right away to
+    // the observers which aren't busy with a previous update.
+    //
+    vector<ObserverInfo>::iterator p = _observers.begin();
+    while(p != _observers.end())
+    {
+        p->pending.push_back(update);
+        ++update->outstanding;
+        if(!p->result)
+        {
+            try
             {
-                Ice::Trace out(_traceLevels->logger, _traceLevels->replicationCat);
-                out << op << ": " << ex;
+                send(*p);
+            }
+            catch(const Ice::Exception& ex)
+            {
+                trace(update->op, ex);
+                p = reap(p);
+                continue;
             }
-            int id = p->id;
-            p = _observers.erase(p);
-
-            IceUtil::Mutex::Lock sync(_reapedMutex);
-            _reaped.push_back(id);
-            continue;
         }
         ++p;
     }
+
+    //
+    // Wait for a majority of the observers to acknowledge the update,
+    // or until a majority can no longer be reached.
+    //
+    while(update->acknowledged < _majority && update->acknowledged + update->outstanding >= _majority)
+    {
+        wait();
+    }
+
     // If we now no longer have the majority of observers we raise.
-    if(_observers.size() < _majority)
+    if(update->acknowledged < _majority)
     {
-        // TODO: Trace here?
-        //Ice::Trace out(_traceLevels->logger, _traceLevels->replicationCat);
-        //out << op;
+        if(_traceLevels->replication > 0)
+        {
+            Ice::Trace out(_traceLevels->logger, _traceLevels->replicationCat);
+            out << update->op << ": majority lost (" << update->acknowledged << "/" << _majority
+                << " acknowledgements)";
+        }
         throw Ice::UnknownException(__FILE__, __LINE__);
     }
 }
+
+void
+Observers::send(ObserverInfo& info)
+{
+    assert(!info.result && !info.pending.empty());
+    info.result = info.pending.front()->send(info.observer, Ice::newCallback(this, &Observers::completed));
+}
+
+vector<Observers::ObserverInfo>::iterator
+Observers::reap(vector<ObserverInfo>::iterator p)
+{
+    //
+    // The updates queued with this observer will never be
+    // acknowledged by it.
+    //
+    for(deque<ObserverUpdatePtr>::const_iterator q = p->pending.begin(); q != p->pending.end(); ++q)
+    {
+        --(*q)->outstanding;
+    }
+
+    int id = p->id;
+    p = _observers.erase(p);
+
+    // COMPILERFIX: Just using following causes double unlock with C++Builder 2007
+    //IceUtil::Mutex::Lock sync(_reapedMutex);
+    _reapedMutex.lock();
+    _reaped.push_back(id);
+    _reapedMutex.unlock();
+
+    notifyAll();
+    return p;
+}
+
+void
+Observers::clearObservers()
+{
+    for(vector<ObserverInfo>::const_iterator p = _observers.begin(); p != _observers.end(); ++p)
+    {
+        for(deque<ObserverUpdatePtr>::const_iterator q = p->pending.begin(); q != p->pending.end(); ++q)
+        {
+            --(*q)->outstanding;
+        }
+    }
+    _observers.clear();
+    notifyAll();
+}
+
+void
+Observers::trace(const string& op, const Ice::Exception& ex) const
+{
+    if(_traceLevels->replication > 0)
+    {
+        Ice::Trace out(_traceLevels->logger, _traceLevels->replicationCat);
+        out << op << ": " << ex;
+    }
+}
@@ -15,6 +15,8 @@
 #include <IceStorm/Election.h>
 #include <IceStorm/Replica.h>
 
+#include <deque>
+
 #ifdef __SUNPRO_CC
 #  pragma error_messages(off,hidef)
 #endif
@@ -31,7 +33,29 @@ typedef IceUtil::Handle<TraceLevels> TraceLevelsPtr;
 namespace IceStormElection
 {
 
-class Observers : public IceUtil::Shared, public IceUtil::Mutex
+//
+// An update replicated to the observers. The update is complete once
+// a majority of the observers acknowledged it, the other observers
+// catch up asynchronously.
+//
+class ObserverUpdate : public IceUtil::Shared
+{
+public:
+
+    ObserverUpdate(const std::string& o) :
+        op(o), acknowledged(0), outstanding(0)
+    {
+    }
+
+    virtual Ice::AsyncResultPtr send(const ReplicaObserverPrx&, const Ice::CallbackPtr&) = 0;
+
+    const std::string op;
+    unsigned int acknowledged;
+    unsigned int outstanding;
+};
+typedef IceUtil::Handle<ObserverUpdate> ObserverUpdatePtr;
+
+class Observers : public IceUtil::Shared, public IceUtil::Monitor<IceUtil::Mutex>
 {
 public:
     Observers(const IceStorm::InstancePtr&);
@@ -49,12 +73,10 @@ public:
     void removeSubscriber(const LogUpdate&, const std::string&, const Ice::IdentitySeq&);
     void getReapedSlaves(std::vector<int>&);
 
-private:
+    void completed(const Ice::AsyncResultPtr&);
 
-    void wait(const std::string&);
+private:
 
-    const IceStorm::TraceLevelsPtr _traceLevels;
-    unsigned int _majority;
     struct ObserverInfo
     {
         ObserverInfo(int i, const ReplicaObserverPrx& o, const Ice::AsyncResultPtr& r = 0) :
@@ -62,7 +84,23 @@ private:
         int id;
         ReplicaObserverPrx observer;
         ::Ice::AsyncResultPtr result;
+
+        //
+        // Updates not yet acknowledged by this observer. The front
+        // update is in progress if result is set, the others are
+        // sent in order once it completes.
+        //
+        std::deque<ObserverUpdatePtr> pending;
     };
+
+    void replicate(const ObserverUpdatePtr&);
+    void clearObservers();
+    void send(ObserverInfo&);
+    std::vector<ObserverInfo>::iterator reap(std::vector<ObserverInfo>::iterator);
+    void trace(const std::string&, const Ice::Exception&) const;
+
+    const IceStorm::TraceLevelsPtr _traceLevels;
+    unsigned int _majority;
     std::vector<ObserverInfo> _observers;
     IceUtil::Mutex _reapedMutex;
     std::vector<int> _reaped;
@@ -14,6 +14,7 @@
 #include <IceStorm/Util.h>
 #include <Ice/LoggerUtil.h>
 #include <iterator>
+#include <deque>
 
 using namespace std;
 using namespace IceStorm;
@@ -161,6 +162,40 @@ private:
     const Ice::ObjectPrx _obj;
 };
 
+//
+// An ordered subscriber with a window greater than one. The events are sent
+// as pipelined twoway requests on a single connection, which preserves their
+// order as long as the subscriber dispatches them serially.
+//
+class SubscriberOrdered : public Subscriber
+{
+public:
+
+    SubscriberOrdered(const InstancePtr&, const SubscriberRecord&, const Ice::ObjectPrx&, int, int,
+                      const Ice::ObjectPrx&);
+
+    virtual void flush();
+
+    void connected(const Ice::ConnectionPtr&);
+    void connectFailed(const Ice::Exception&);
+    void eventCompleted(const Ice::AsyncResultPtr&);
+
+private:
+
+    struct SentEvent
+    {
+        Ice::AsyncResultPtr result;
+        EventDataPtr event;
+        bool failed;
+    };
+
+    const Ice::ObjectPrx _obj;
+    Ice::ObjectPrx _fixed; // The proxy bound to the connection the events are sent on.
+    bool _connecting;
+    bool _resent; // True if events were resent since the last successful event.
+    std::deque<SentEvent> _sent; // The outstanding and failed events, in sending order.
+};
+
 class SubscriberLink : public Subscriber
 {
 public:
@@ -466,6 +501,225 @@ SubscriberTwoway::flush()
     }
 }
 
+SubscriberOrdered::SubscriberOrdered(
+    const InstancePtr& instance,
+    const SubscriberRecord& rec,
+    const Ice::ObjectPrx& proxy,
+    int retryCount,
+    int window,
+    const Ice::ObjectPrx& obj) :
+    Subscriber(instance, rec, proxy, retryCount, window),
+    _obj(obj),
+    _connecting(false),
+    _resent(false)
+{
+}
+
+void
+SubscriberOrdered::flush()
+{
+    IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(_lock);
+
+    //
+    // If the subscriber isn't online we're done.
+    //
+    if(_state != SubscriberStateOnline || _events.empty())
+    {
+        return;
+    }
+
+    if(!_fixed)
+    {
+        //
+        // Get the connection to send the events on. The events of a failed
+        // connection are resent on a new connection once all the events sent
+        // on the failed connection completed.
+        //
+        if(!_connecting && _outstanding == 0)
+        {
+            _connecting = true;
+            ++_outstanding;
+            try
+            {
+                _obj->begin_ice_getConnection(
+                    Ice::newCallback_Object_ice_getConnection(this,
+                                                              &SubscriberOrdered::connected,
+                                                              &SubscriberOrdered::connectFailed));
+            }
+            catch(const Ice::Exception& ex)
+            {
+                _connecting = false;
+                error(true, ex);
+            }
+        }
+        return;
+    }
+
+    // Send up to _maxOutstanding pending events.
+    while(_outstanding < _maxOutstanding && !_events.empty())
+    {
+        EventDataPtr e = _events.front();
+        _events.erase(_events.begin());
+        ++_outstanding;
+        if(_observer)
+        {
+            _observer->outstanding(1);
+        }
+
+        //
+        // The _priority context entry would allow the connection to reorder
+        // the requests, it's not forwarded to ordered subscribers.
+        //
+        Ice::Context ctx;
+        const Ice::Context* context = &e->context;
+        if(e->context.find("_priority") != e->context.end())
+        {
+            ctx = e->context;
+            ctx.erase("_priority");
+            context = &ctx;
+        }
+
+        SentEvent sent;
+        sent.event = e;
+        sent.failed = false;
+        _sent.push_back(sent);
+        try
+        {
+            _sent.back().result = _fixed->begin_ice_invoke(e->op, e->mode, e->data, *context,
+                                                           Ice::newCallback(this, &SubscriberOrdered::eventCompleted));
+        }
+        catch(const Ice::Exception& ex)
+        {
+            _sent.pop_back();
+            _fixed = 0;
+            error(true, ex);
+            return;
+        }
+    }
+}
+
+void
+SubscriberOrdered::connected(const Ice::ConnectionPtr& connection)
+{
+    IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(_lock);
+
+    --_outstanding;
+    _connecting = false;
+
+    //
+    // The events are sent with a fixed proxy: requests on a fixed proxy
+    // aren't retried by the Ice run time, which could resend a request after
+    // the requests which followed it. The connection is null if the
+    // subscriber is collocated, in which case the proxy is used directly.
+    //
+    if(connection)
+    {
+        _fixed = connection->createProxy(_obj->ice_getIdentity())->ice_facet(_obj->ice_getFacet());
+        _fixed = _fixed->ice_encodingVersion(_obj->ice_getEncodingVersion());
+    }
+    else
+    {
+        _fixed = _obj;
+    }
+
+    if(_events.empty() && _outstanding == 0 && _shutdown)
+    {
+        _lock.notify();
+    }
+    else
+    {
+        flush();
+    }
+}
+
+void
+SubscriberOrdered::connectFailed(const Ice::Exception& ex)
+{
+    IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(_lock);
+    _connecting = false;
+    error(true, ex);
+}
+
+void
+SubscriberOrdered::eventCompleted(const Ice::AsyncResultPtr& result)
+{
+    IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(_lock);
+
+    deque<SentEvent>::iterator p = _sent.begin();
+    while(p != _sent.end() && p->result != result)
+    {
+        ++p;
+    }
+    assert(p != _sent.end());
+
+    try
+    {
+        result->throwLocalException();
+
+        _sent.erase(p);
+        --_outstanding;
+        assert(_outstanding >= 0 && _outstanding < _maxOutstanding);
+        if(_observer)
+        {
+            _observer->delivered(1);
+        }
+
+        //
+        // A successful response means we're no longer retrying, we're
+        // back active.
+        //
+        _currentRetry = 0;
+        _resent = false;
+    }
+    catch(const Ice::LocalException& ex)
+    {
+        _fixed = 0;
+
+        //
+        // Like the Ice run time, resend the events which weren't sent and
+        // the events which the subscriber didn't dispatch before gracefully
+        // closing the connection. The events sent after a failed event can
+        // only fail as well, the failed events are resent in order once all
+        // the outstanding events completed. The events are resent once, a
+        // second failure is handled as usual.
+        //
+        if(!_resent && (!result->isSent() || dynamic_cast<const Ice::CloseConnectionException*>(&ex)))
+        {
+            p->failed = true;
+            --_outstanding;
+            assert(_outstanding >= 0 && _outstanding < _maxOutstanding);
+        }
+        else
+        {
+            _sent.erase(p);
+            error(true, ex);
+        }
+    }
+
+    if(_outstanding == 0 && !_sent.empty())
+    {
+        if(_state == SubscriberStateOnline)
+        {
+            for(deque<SentEvent>::reverse_iterator q = _sent.rbegin(); q != _sent.rend(); ++q)
+            {
+                assert(q->failed);
+                _events.push_front(q->event);
+            }
+            _resent = true;
+        }
+        _sent.clear();
+    }
+
+    if(_events.empty() && _outstanding == 0 && _shutdown)
+    {
+        _lock.notify();
+    }
+    else
+    {
+        flush();
+    }
+}
+
 namespace
 {
 
@@ -571,6 +825,21 @@ Subscriber::create(
                 throw BadQoS("invalid reliability: " + reliability);
             }
 
+            int window = 1;
+            p = rec.theQoS.find("window");
+            if(p != rec.theQoS.end())
+            {
+                if(reliability != "ordered")
+                {
+                    throw BadQoS("window QoS requires ordered reliability");
+                }
+                window = atoi(p->second.c_str());
+                if(window < 1)
+                {
+                    throw BadQoS("invalid window: " + p->second);
+                }
+            }
+
             //
             // Override the timeout.
             //
@@ -594,7 +863,14 @@ Subscriber::create(
                 {
                     throw BadQoS("ordered reliability requires a twoway proxy");
                 }
-                subscriber = new SubscriberTwoway(instance, rec, proxy, retryCount, 1, newObj);
+                if(window > 1)
+                {
+                    subscriber = new SubscriberOrdered(instance, rec, proxy, retryCount, window, newObj);
+                }
+                else
+                {
+                    subscriber = new SubscriberTwoway(instance, rec, proxy, retryCount, 1, newObj);
+                }
             }
             else if(newObj->ice_isOneway() || newObj->ice_isDatagram())
             {
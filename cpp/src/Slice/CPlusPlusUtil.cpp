@@ -11,6 +11,7 @@
 #include <Slice/Util.h>
 #include <cstring>
 #include <functional>
+#include <algorithm>
 
 #ifndef _WIN32
 #  include <fcntl.h>
@@ -491,6 +492,113 @@ writeMarshalUnmarshalParams(Output& out, const ParamDeclList& params, const Oper
         }
     }
 }
+
+//
+// Returns TypeContextUseWstring if the string data members of the given
+// struct, class or exception are mapped to std::wstring by the metadata
+// of the construct or of its enclosing modules.
+//
+int
+streamTableWstring(const ContainedPtr& c)
+{
+    int use = 0;
+    list<ContainedPtr> scopes;
+    for(ContainedPtr p = c; p; p = ContainedPtr::dynamicCast(p->container()))
+    {
+        scopes.push_front(p);
+    }
+
+    for(list<ContainedPtr>::const_iterator p = scopes.begin(); p != scopes.end(); ++p)
+    {
+        StringList metaData = (*p)->getMetaData();
+        if(find(metaData.begin(), metaData.end(), "cpp:type:wstring") != metaData.end())
+        {
+            use = TypeContextUseWstring;
+        }
+        else if(find(metaData.begin(), metaData.end(), "cpp:type:string") != metaData.end())
+        {
+            use = 0;
+        }
+    }
+    return use;
+}
+
+string
+streamTableEntry(const DataMemberPtr& p, int typeCtx)
+{
+    string type = typeToString(p->type(), p->getMetaData(), typeCtx);
+    BuiltinPtr builtin = BuiltinPtr::dynamicCast(p->type());
+    if(builtin)
+    {
+        switch(builtin->kind())
+        {
+            case Builtin::KindByte:
+            {
+                return "{ StreamTableByte, 0, 0 }";
+            }
+            case Builtin::KindBool:
+            {
+                return "{ StreamTableBool, 0, 0 }";
+            }
+            case Builtin::KindShort:
+            {
+                return "{ StreamTableShort, 0, 0 }";
+            }
+            case Builtin::KindInt:
+            {
+                return "{ StreamTableInt, 0, 0 }";
+            }
+            case Builtin::KindLong:
+            {
+                //
+                // The C++11 mapping uses long long int, which isn't
+                // necessarily the type of Ice::Long.
+                //
+                if(!(typeCtx & TypeContextCpp11))
+                {
+                    return "{ StreamTableLong, 0, 0 }";
+                }
+                break;
+            }
+            case Builtin::KindFloat:
+            {
+                return "{ StreamTableFloat, 0, 0 }";
+            }
+            case Builtin::KindDouble:
+            {
+                return "{ StreamTableDouble, 0, 0 }";
+            }
+            case Builtin::KindString:
+            {
+                if(type == "::std::string")
+                {
+                    return "{ StreamTableString, 0, 0 }";
+                }
+                break;
+            }
+            default:
+            {
+                break;
+            }
+        }
+    }
+
+    string helper = "StreamTableHelper<" + toTemplateArg(type) + ">";
+    return "{ StreamTableHelper, &" + helper + "::write, &" + helper + "::read }";
+}
+
+void
+writeStreamTableMembers(Output& out, const string& holder, const DataMemberList& dataMembers)
+{
+    for(DataMemberList::const_iterator q = dataMembers.begin(); q != dataMembers.end(); ++q)
+    {
+        if(q != dataMembers.begin())
+        {
+            out << ",";
+        }
+        out << nl << "&" << holder << fixKwd((*q)->name());
+    }
+}
 }
 
 Slice::FeatureProfile Slice::featureProfile = Slice::Ice;
@@ -1466,7 +1574,8 @@ Slice::writeStreamHelpers(Output& out,
                           DataMemberList dataMembers,
                           bool hasBaseDataMembers,
                           bool checkClassMetaData,
-                          bool cpp11)
+                          bool cpp11,
+                          bool streamTables)
 {
     // If c is a C++11 class/exception whose base class contains data members (recursively), then we need to generate
     // an StreamWriter even if its implementation is empty. This is becuase our default marsaling uses ice_tuple() which
@@ -1508,13 +1617,45 @@ Slice::writeStreamHelpers(Output& out,
     string fullName = classMetaData ? fixKwd(scoped + "Ptr") : fixKwd(scoped);
     string holder = classMetaData ? "v->" : "v.";
 
+    //
+    // With stream tables, the required data members are marshaled by
+    // Ice::writeTable and Ice::readTable using the StreamTable
+    // specialization generated below. The entries are constant
+    // initialized so the table doesn't require any dynamic
+    // initialization.
+    //
+    bool useTable = streamTables && !requiredMembers.empty();
+    string tableName = "StreamTable" + string(cpp11 ? "<" : "< ") + fullName + ">";
+    if(useTable)
+    {
+        int typeCtx = streamTableWstring(c) | (cpp11 ? TypeContextCpp11 : 0);
+
+        out << nl << "template<>";
+        out << nl << "struct " << tableName;
+        out << sb;
+        out << nl << "static const size_t size = " << requiredMembers.size() << ";";
+        out << sp;
+        out << nl << "static const StreamTableEntry* entries()";
+        out << sb;
+        out << nl << "static const StreamTableEntry e[] =";
+        out << sb;
+        for(DataMemberList::const_iterator q = requiredMembers.begin(); q != requiredMembers.end(); ++q)
+        {
+            out << nl << streamTableEntry(*q, typeCtx) << ",";
+        }
+        out << eb << ";";
+        out << nl << "return e;";
+        out << eb;
+        out << eb << ";" << nl;
+    }
+
     //
     // Generate StreamWriter
     //
     // Only generate StreamWriter specializations if we are generating for C++98 or
     // we are generating for C++11 with optional data members and no base class data members
     //
-    if(!cpp11 || !optionalMembers.empty() || hasBaseDataMembers)
+    if(!cpp11 || !optionalMembers.empty() || hasBaseDataMembers || useTable)
     {
         out << nl << "template<typename S>";
         out << nl << "struct StreamWriter" << (cpp11 ? "<" : "< ") << fullName << ", S>";
@@ -1522,7 +1663,26 @@ Slice::writeStreamHelpers(Output& out,
         out << nl << "static void write(S* __os, const " << fullName << "& v)";
         out << sb;
 
-        if(cpp11)
+        if(useTable)
+        {
+            out << nl << "const void* __m[] =";
+            out << sb;
+            writeStreamTableMembers(out, holder, requiredMembers);
+            out << eb << ";";
+            out << nl << "writeTable(__os, __m, " << tableName << "::entries(), " << tableName << "::size);";
+            if(cpp11)
+            {
+                writeMarshalUnmarshalAllInHolder(out, holder, optionalMembers, true, true);
+            }
+            else
+            {
+                for(DataMemberList::const_iterator q = optionalMembers.begin(); q != optionalMembers.end(); ++q)
+                {
+                    writeMarshalUnmarshalDataMemberInHolder(out, holder, *q, true);
+                }
+            }
+        }
+        else if(cpp11)
         {
             writeMarshalUnmarshalAllInHolder(out, holder, requiredMembers, false, true);
             writeMarshalUnmarshalAllInHolder(out, holder, optionalMembers, true, true);
@@ -1553,7 +1713,26 @@ Slice::writeStreamHelpers(Output& out,
     out << nl << "static void read(S* __is, " << fullName << "& v)";
     out << sb;
 
-    if(cpp11)
+    if(useTable)
+    {
+        out << nl << "void* const __m[] =";
+        out << sb;
+        writeStreamTableMembers(out, holder, requiredMembers);
+        out << eb << ";";
+        out << nl << "readTable(__is, __m, " << tableName << "::entries(), " << tableName << "::size);";
+        if(cpp11)
+        {
+            writeMarshalUnmarshalAllInHolder(out, holder, optionalMembers, true, false);
+        }
+        else
+        {
+            for(DataMemberList::const_iterator q = optionalMembers.begin(); q != optionalMembers.end(); ++q)
+            {
+                writeMarshalUnmarshalDataMemberInHolder(out, holder, *q, false);
+            }
+        }
+    }
+    else if(cpp11)
     {
         writeMarshalUnmarshalAllInHolder(out, holder, requiredMembers, false, false);
         writeMarshalUnmarshalAllInHolder(out, holder, optionalMembers, true, false);
@@ -1649,6 +1828,7 @@ Slice::findMetaData(const StringList& metaData, int typeCtx)
             // cpp:view-type: is returned
             // If the form is cpp:range[:<...>], cpp:array or cpp:class,
             // the return value is % followed by the string after cpp:.
+            // If the form is cpp:file, ::Ice::FileBytes is returned.
             //
             // The priority of the metadata is as follows:
             // 1: array, range (C++98 only), view-type for "view" parameters
@@ -1676,6 +1856,10 @@ Slice::findMetaData(const StringList& metaData, int typeCtx)
                     return str.substr(pos + 1);
                 }
             }
+            else if(str == "cpp:file")
+            {
+                return "::Ice::FileBytes";
+            }
             else if(typeCtx & (TypeContextInParam | TypeContextAMIPrivateEnd))
             {
                 string ss = str.substr(prefix.size());
@@ -31,6 +31,17 @@ using namespace IceUtilInternal;
 namespace
 {
 
+//
+// The entries of a FlatMap are sorted once they are unmarshaled, which
+// moves the values. Class instances are patched after the entries are
+// read, so dictionaries with class values can't be mapped to FlatMap.
+//
+bool
+isFlatDictionary(const DictionaryPtr& p)
+{
+    return p->hasMetaData("cpp:flat") && !p->valueType()->usesClasses();
+}
+
 bool
 isConstexprType(const TypePtr& type)
 {
@@ -628,7 +639,7 @@ condString(bool ok, const string& str)
 Slice::Gen::Gen(const string& base, const string& headerExtension, const string& sourceExtension,
                 const vector<string>& extraHeaders, const string& include,
                 const vector<string>& includePaths, const string& dllExport, const string& dir,
-                bool implCpp98, bool implCpp11, bool checksum, bool ice) :
+                bool implCpp98, bool implCpp11, bool checksum, bool ice, bool streamTables) :
     _base(base),
     _headerExtension(headerExtension),
     _implHeaderExtension(headerExtension),
@@ -641,7 +652,8 @@ Slice::Gen::Gen(const string& base, const string& headerExtension, const string&
     _implCpp98(implCpp98),
     _implCpp11(implCpp11),
     _checksum(checksum),
-    _ice(ice)
+    _ice(ice),
+    _streamTables(streamTables)
 {
     for(vector<string>::iterator p = _includePaths.begin(); p != _includePaths.end(); ++p)
     {
@@ -835,6 +847,20 @@ Slice::Gen::generate(const UnitPtr& p)
     H << "\n#include <Ice/Exception.h>";
     H << "\n#include <Ice/LocalObject.h>";
     H << "\n#include <Ice/StreamHelpers.h>";
+    if(p->hasContentsWithMetaData("cpp:flat") || p->hasContentsWithMetaData("cpp98:flat") ||
+       p->hasContentsWithMetaData("cpp11:flat"))
+    {
+        H << "\n#include <Ice/FlatMap.h>";
+    }
+    if(p->hasContentsWithMetaData("cpp:file") || p->hasContentsWithMetaData("cpp98:file") ||
+       p->hasContentsWithMetaData("cpp11:file"))
+    {
+        H << "\n#include <Ice/FileBytes.h>";
+    }
+    if(_streamTables)
+    {
+        H << "\n#include <Ice/StreamTable.h>";
+    }
     H << "\n#include <Ice/Comparable.h>";
 
     if(p->hasNonLocalClassDefs())
@@ -970,7 +996,7 @@ Slice::Gen::generate(const UnitPtr& p)
         Cpp11ProxyVisitor proxyVisitor(H, C, _dllExport);
         p->visit(&proxyVisitor, false);
 
-        Cpp11StreamVisitor streamVisitor(H, C, _dllExport);
+        Cpp11StreamVisitor streamVisitor(H, C, _dllExport, _streamTables);
         p->visit(&streamVisitor, false);
 
         if(_implCpp11)
@@ -1042,7 +1068,7 @@ Slice::Gen::generate(const UnitPtr& p)
         ObjectVisitor objectVisitor(H, C, _dllExport);
         p->visit(&objectVisitor, false);
 
-        StreamVisitor streamVisitor(H, C, _dllExport);
+        StreamVisitor streamVisitor(H, C, _dllExport, _streamTables);
         p->visit(&streamVisitor, false);
 
         //
@@ -1703,7 +1729,12 @@ Slice::Gen::TypesVisitor::visitDictionary(const DictionaryPtr& p)
         }
         string vs = typeToString(valueType, p->valueMetaData(), _useWstring);
 
-        H << sp << nl << "typedef ::std::map<" << ks << ", " << vs << "> " << name << ';';
+        //
+        // std::unordered_map isn't available to C++98, cpp:unordered
+        // dictionaries are mapped to std::map.
+        //
+        string mapType = isFlatDictionary(p) ? "::Ice::FlatMap" : "::std::map";
+        H << sp << nl << "typedef " << mapType << "<" << ks << ", " << vs << "> " << name << ';';
     }
     else
     {
@@ -4555,10 +4586,11 @@ Slice::Gen::AsyncImplVisitor::visitOperation(const OperationPtr& p)
     C << eb;
 }
 
-Slice::Gen::StreamVisitor::StreamVisitor(Output& h, Output& c, const string& dllExport) :
+Slice::Gen::StreamVisitor::StreamVisitor(Output& h, Output& c, const string& dllExport, bool streamTables) :
     H(h),
     C(c),
-    _dllExport(dllExport)
+    _dllExport(dllExport),
+    _streamTables(streamTables)
 {
 }
 
@@ -4606,7 +4638,7 @@ Slice::Gen::StreamVisitor::visitClassDefStart(const ClassDefPtr& c)
 {
     if(!c->isLocal())
     {
-        writeStreamHelpers(H, c, c->dataMembers(), c->hasBaseDataMembers(), true, false);
+        writeStreamHelpers(H, c, c->dataMembers(), c->hasBaseDataMembers(), true, false, _streamTables);
     }
     return false;
 }
@@ -4623,7 +4655,7 @@ Slice::Gen::StreamVisitor::visitExceptionStart(const ExceptionPtr& p)
         H << nl << "static const StreamHelperCategory helper = StreamHelperCategoryUserException;";
         H << eb << ";" << nl;
 
-        writeStreamHelpers(H, p, p->dataMembers(), p->hasBaseDataMembers(), true, false);
+        writeStreamHelpers(H, p, p->dataMembers(), p->hasBaseDataMembers(), true, false, _streamTables);
     }
     return false;
 }
@@ -4662,7 +4694,7 @@ Slice::Gen::StreamVisitor::visitStructStart(const StructPtr& p)
         }
         H << eb << ";" << nl;
 
-        writeStreamHelpers(H, p, p->dataMembers(), false, true, false);
+        writeStreamHelpers(H, p, p->dataMembers(), false, true, false, _streamTables);
     }
     return false;
 }
@@ -4948,11 +4980,32 @@ Slice::Gen::MetaDataVisitor::validate(const SyntaxTreeBasePtr& cont, const Strin
                     {
                         continue;
                     }
+                    BuiltinPtr builtin = BuiltinPtr::dynamicCast(SequencePtr::dynamicCast(cont)->type());
+                    if(ss == "file" && builtin && builtin->kind() == Builtin::KindByte)
+                    {
+                        continue;
+                    }
                 }
                 if(DictionaryPtr::dynamicCast(cont) && (ss.find("type:") == 0 || ss.find("view-type:") == 0))
                 {
                     continue;
                 }
+                if(DictionaryPtr::dynamicCast(cont) && ss == "flat" &&
+                   !DictionaryPtr::dynamicCast(cont)->valueType()->usesClasses())
+                {
+                    continue;
+                }
+                if(!cpp98 && DictionaryPtr::dynamicCast(cont) && ss == "unordered")
+                {
+                    //
+                    // The key must have a std::hash specialization.
+                    //
+                    BuiltinPtr key = BuiltinPtr::dynamicCast(DictionaryPtr::dynamicCast(cont)->keyType());
+                    if(key)
+                    {
+                        continue;
+                    }
+                }
                 if(!cpp11 && StructPtr::dynamicCast(cont) && (ss == "class" || ss == "comparable"))
                 {
                     continue;
@@ -5139,9 +5192,11 @@ Slice::Gen::NormalizeMetaDataVisitor::normalize(const StringList& metaData)
         "class",
         "comparable",
         "const",
+        "flat",
         "ice_print",
         "range",
         "type:",
+        "unordered",
         "unscoped",
         "view-type:",
         "virtual",
@@ -5822,7 +5877,16 @@ Slice::Gen::Cpp11TypesVisitor::visitDictionary(const DictionaryPtr& p)
         string ks = typeToString(keyType, p->keyMetaData(), typeCtx | TypeContextCpp11);
         string vs = typeToString(valueType, p->valueMetaData(), typeCtx | TypeContextCpp11);
 
-        H << sp << nl << "using " << name << " = ::std::map<" << ks << ", " << vs << ">;";
+        string mapType = "::std::map";
+        if(isFlatDictionary(p))
+        {
+            mapType = "::Ice::FlatMap";
+        }
+        else if(p->hasMetaData("cpp:unordered"))
+        {
+            mapType = "::std::unordered_map";
+        }
+        H << sp << nl << "using " << name << " = " << mapType << "<" << ks << ", " << vs << ">;";
     }
     else
     {
@@ -7620,10 +7684,11 @@ Slice::Gen::Cpp11ObjectVisitor::emitOneShotConstructor(const ClassDefPtr& p)
     }
 }
 
-Slice::Gen::Cpp11StreamVisitor::Cpp11StreamVisitor(Output& h, Output& c, const string& dllExport) :
+Slice::Gen::Cpp11StreamVisitor::Cpp11StreamVisitor(Output& h, Output& c, const string& dllExport, bool streamTables) :
     H(h),
     C(c),
-    _dllExport(dllExport)
+    _dllExport(dllExport),
+    _streamTables(streamTables)
 {
 }
 
@@ -7689,7 +7754,7 @@ Slice::Gen::Cpp11StreamVisitor::visitStructStart(const StructPtr& p)
     H << nl << "static const bool fixedLength = " << (p->isVariableLength() ? "false" : "true") << ";";
     H << eb << ";" << nl;
 
-    writeStreamHelpers(H, p, p->dataMembers(), false, false, true);
+    writeStreamHelpers(H, p, p->dataMembers(), false, false, true, _streamTables);
 
     return false;
 }
@@ -7699,7 +7764,7 @@ Slice::Gen::Cpp11StreamVisitor::visitClassDefStart(const ClassDefPtr& c)
 {
     if(!c->isLocal() && !c->isInterface())
     {
-        writeStreamHelpers(H,c, c->dataMembers(), c->hasBaseDataMembers(), true, true);
+        writeStreamHelpers(H,c, c->dataMembers(), c->hasBaseDataMembers(), true, true, _streamTables);
     }
     return false;
 }
@@ -7709,7 +7774,7 @@ Slice::Gen::Cpp11StreamVisitor::visitExceptionEnd(const ExceptionPtr& p)
 {
     if(!p->isLocal())
     {
-        writeStreamHelpers(H,p, p->dataMembers(), p->hasBaseDataMembers(), true, true);
+        writeStreamHelpers(H,p, p->dataMembers(), p->hasBaseDataMembers(), true, true, _streamTables);
     }
 }
 
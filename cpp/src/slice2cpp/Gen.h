@@ -31,6 +31,7 @@ public:
         bool,
         bool,
         bool,
+        bool,
         bool);
     ~Gen();
 
@@ -71,6 +72,7 @@ private:
     bool _implCpp11;
     bool _checksum;
     bool _ice;
+    bool _streamTables;
 
     class TypesVisitor : private ::IceUtil::noncopyable, public ParserVisitor
     {
@@ -327,7 +329,7 @@ private:
     {
     public:
 
-        StreamVisitor(::IceUtilInternal::Output&, ::IceUtilInternal::Output&, const std::string&);
+        StreamVisitor(::IceUtilInternal::Output&, ::IceUtilInternal::Output&, const std::string&, bool);
 
         virtual bool visitModuleStart(const ModulePtr&);
         virtual void visitModuleEnd(const ModulePtr&);
@@ -341,6 +343,7 @@ private:
         ::IceUtilInternal::Output& H;
         ::IceUtilInternal::Output& C;
         std::string _dllExport;
+        bool _streamTables;
     };
     //
     // C++11 Visitors
@@ -547,7 +550,7 @@ private:
     {
     public:
 
-        Cpp11StreamVisitor(::IceUtilInternal::Output&, ::IceUtilInternal::Output&, const std::string&);
+        Cpp11StreamVisitor(::IceUtilInternal::Output&, ::IceUtilInternal::Output&, const std::string&, bool);
 
         virtual bool visitModuleStart(const ModulePtr&);
         virtual void visitModuleEnd(const ModulePtr&);
@@ -561,6 +564,7 @@ private:
         ::IceUtilInternal::Output& H;
         ::IceUtilInternal::Output& C;
         std::string _dllExport;
+        bool _streamTables;
     };
 
 
@@ -82,6 +82,7 @@ usage(const string& n)
         "--ice                    Allow reserved Ice prefix in Slice identifiers.\n"
         "--underscore             Allow underscores in Slice identifiers.\n"
         "--checksum               Generate checksums for Slice definitions.\n"
+        "--stream-tables          Marshal data members with stream tables.\n"
         ;
 }
 
@@ -111,6 +112,7 @@ compile(const vector<string>& argv)
     opts.addOpt("", "ice");
     opts.addOpt("", "underscore");
     opts.addOpt("", "checksum");
+    opts.addOpt("", "stream-tables");
 
     bool validate = find(argv.begin(), argv.end(), "--validate") != argv.end();
     vector<string> args;
@@ -191,6 +193,8 @@ compile(const vector<string>& argv)
 
     bool checksum = opts.isSet("checksum");
 
+    bool streamTables = opts.isSet("stream-tables");
+
     if(args.empty())
     {
         getErrorStream() << argv[0] << ": error: no input file" << endl;
@@ -327,7 +331,7 @@ compile(const vector<string>& argv)
                     try
                     {
                         Gen gen(icecpp->getBaseName(), headerExtension, sourceExtension, extraHeaders, include,
-                                includePaths, dllExport, output, implCpp98, implCpp11, checksum, ice);
+                                includePaths, dllExport, output, implCpp98, implCpp11, checksum, ice, streamTables);
                         gen.generate(u);
                     }
                     catch(const Slice::FileException& ex)
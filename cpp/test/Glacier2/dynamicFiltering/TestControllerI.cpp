@@ -53,11 +53,57 @@ TestControllerI::TestControllerI()
     id.name = "barC";
     current.objectIdFiltersAccept.push_back(id);
     _configurations.push_back(current);
+
+    current = TestConfiguration();
+    current.description = "Category filter removal";
+    current.cases.push_back(TestCase("foo/barD:default -p 12012", false));
+    current.cases.push_back(TestCase("\"a cat with spaces/fooD\":default -p 12012", true));
+    current.cases.push_back(TestCase("fooD @ bar", true));
+    current.categoryFiltersRemove.push_back("foo");
+    _configurations.push_back(current);
+
+    //
+    // The configured filters are updated with the Properties admin
+    // facet, the existing session must keep the filters added and
+    // removed with its session control.
+    //
+    current = TestConfiguration();
+    current.description = "Category filter properties update";
+    current.cases.push_back(TestCase("baz/fooE:default -p 12012", true));
+    current.cases.push_back(TestCase("foo/barE:default -p 12012", false));
+    current.cases.push_back(TestCase("bar/fooE:default -p 12012", false));
+    current.cases.push_back(TestCase("\"a cat with spaces/fooE\":default -p 12012", true));
+    current.filterProperties["Glacier2.Filter.Category.Accept"] = "baz foo";
+    _configurations.push_back(current);
+
+    current = TestConfiguration();
+    current.description = "Adapter id and object id filter properties update";
+    current.cases.push_back(TestCase("baz/fooF:default -p 12012", false));
+    current.cases.push_back(TestCase("bazF @ baz", true));
+    current.cases.push_back(TestCase("fooF @ bar", true));
+    current.cases.push_back(TestCase("bar/fooF:default -p 12012", true));
+    current.cases.push_back(TestCase("foo/barC:default -p 12012", true));
+    current.cases.push_back(TestCase("\"a cat with spaces/fooF\":default -p 12012", true));
+    current.filterProperties["Glacier2.Filter.Category.Accept"] = "";
+    current.filterProperties["Glacier2.Filter.AdapterId.Accept"] = "baz";
+    current.filterProperties["Glacier2.Filter.Identity.Accept"] = "bar/fooF";
+    _configurations.push_back(current);
+
+    current = TestConfiguration();
+    current.description = "Filter properties removal";
+    current.cases.push_back(TestCase("bazG @ baz", false));
+    current.cases.push_back(TestCase("bar/fooF:default -p 12012", false));
+    current.cases.push_back(TestCase("fooG @ bar", true));
+    current.cases.push_back(TestCase("foo/barC:default -p 12012", true));
+    current.cases.push_back(TestCase("\"a cat with spaces/fooG\":default -p 12012", true));
+    current.filterProperties["Glacier2.Filter.AdapterId.Accept"] = "";
+    current.filterProperties["Glacier2.Filter.Identity.Accept"] = "";
+    _configurations.push_back(current);
 };
 
 void
 TestControllerI::step(const Glacier2::SessionPrx& currentSession, const TestToken& currentState, TestToken& newState,
-                      const Ice::Current&)
+                      const Ice::Current& current)
 {
     switch(currentState.code)
     {
@@ -129,6 +175,13 @@ TestControllerI::step(const Glacier2::SessionPrx& currentSession, const TestToke
 
             if(reconfigure)
             {
+                if(!config.filterProperties.empty())
+                {
+                    Ice::PropertiesAdminPrx admin = Ice::PropertiesAdminPrx::uncheckedCast(
+                        current.adapter->getCommunicator()->stringToProxy("Glacier2/admin -f Properties:tcp -p 12348"));
+                    admin->setProperties(config.filterProperties);
+                }
+
                 Glacier2::StringSetPrx categories = session.sessionControl->categories();
                 categories->add(config.categoryFiltersAccept);
 
@@ -137,6 +190,8 @@ TestControllerI::step(const Glacier2::SessionPrx& currentSession, const TestToke
                         
                 Glacier2::IdentitySetPrx ids = session.sessionControl->identities();
                 ids->add(config.objectIdFiltersAccept);
+
+                categories->remove(config.categoryFiltersRemove);
                 session.configured = true;
             }
             break;
@@ -13,6 +13,7 @@
 #include <IceUtil/Shared.h>
 #include <IceUtil/Mutex.h>
 #include <Glacier2/Session.h>
+#include <Ice/PropertiesAdmin.h>
 #include <Test.h>
 #include <vector>
 #include <string>
@@ -64,6 +65,13 @@ struct TestConfiguration
     std::vector<std::string> categoryFiltersAccept;
     std::vector<std::string> adapterIdFiltersAccept;
     std::vector<Ice::Identity> objectIdFiltersAccept;
+    std::vector<std::string> categoryFiltersRemove;
+
+    //
+    // The Glacier2.Filter properties updated with the router's
+    // Properties admin facet.
+    //
+    Ice::PropertyDict filterProperties;
 };
 
 //
@@ -0,0 +1,42 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+
+#include <Ice/Ice.h>
+#include <BackendI.h>
+
+using namespace std;
+using namespace Ice;
+
+void
+BackendI::hit(const string& session, const Current&)
+{
+    IceUtil::Mutex::Lock sync(*this);
+    _hits.push_back(session);
+}
+
+StringSeq
+BackendI::getHits(const Current&)
+{
+    IceUtil::Mutex::Lock sync(*this);
+    return _hits;
+}
+
+void
+BackendI::reset(const Current&)
+{
+    IceUtil::Mutex::Lock sync(*this);
+    _hits.clear();
+}
+
+void
+BackendI::shutdown(const Current& current)
+{
+    current.adapter->getCommunicator()->shutdown();
+}
@@ -0,0 +1,31 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+
+#ifndef BACKEND_I_H
+#define BACKEND_I_H
+
+#include <IceUtil/Mutex.h>
+#include <Test.h>
+
+class BackendI : public Test::Backend, private IceUtil::Mutex
+{
+public:
+
+    virtual void hit(const std::string&, const Ice::Current&);
+    virtual Ice::StringSeq getHits(const Ice::Current&);
+    virtual void reset(const Ice::Current&);
+    virtual void shutdown(const Ice::Current&);
+
+private:
+
+    Ice::StringSeq _hits;
+};
+
+#endif
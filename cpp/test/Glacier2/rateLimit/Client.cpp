@@ -0,0 +1,314 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+
+#include <IceUtil/IceUtil.h>
+#include <Ice/Application.h>
+#include <Glacier2/Router.h>
+#include <Glacier2/Metrics.h>
+#include <TestCommon.h>
+#include <Test.h>
+#include <algorithm>
+
+using namespace std;
+using namespace Ice;
+using namespace Test;
+
+namespace
+{
+
+BackendPrx
+createSession(const CommunicatorPtr& communicator, const string& userId)
+{
+    ObjectPrx routerBase = communicator->stringToProxy("Glacier2/router:default -p 12347");
+    Glacier2::RouterPrx router = Glacier2::RouterPrx::checkedCast(routerBase);
+    test(router);
+    communicator->setDefaultRouter(router);
+    router->createSession(userId, "abc123");
+    return BackendPrx::uncheckedCast(communicator->stringToProxy("backend:tcp -p 12010"));
+}
+
+Ice::StringSeq::size_type
+waitForHits(const BackendPrx& backend, Ice::StringSeq::size_type count)
+{
+    Ice::StringSeq::size_type size = backend->getHits().size();
+    for(int i = 0; i < 1000 && size < count; ++i)
+    {
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(10));
+        size = backend->getHits().size();
+    }
+    return size;
+}
+
+IceMX::SessionMetricsPtr
+getSessionMetrics(const IceMX::MetricsAdminPrx& metrics, const string& id)
+{
+    Ice::Long timestamp;
+    IceMX::MetricsView view = metrics->getMetricsView("View", timestamp);
+    IceMX::MetricsMap& sessions = view["Session"];
+    for(IceMX::MetricsMap::const_iterator p = sessions.begin(); p != sessions.end(); ++p)
+    {
+        if((*p)->id == id)
+        {
+            return IceMX::SessionMetricsPtr::dynamicCast(*p);
+        }
+    }
+    test(false);
+    return 0;
+}
+
+}
+
+class RateLimitClient : public Application
+{
+public:
+
+    virtual int run(int, char*[]);
+};
+
+int
+main(int argc, char* argv[])
+{
+#ifdef ICE_STATIC_LIBS
+    Ice::registerIceSSL();
+#endif
+
+    Ice::InitializationData initData;
+    initData.properties = Ice::createProperties(argc, argv);
+    initData.properties->setProperty("Ice.Warn.Connections", "0");
+
+    RateLimitClient app;
+    return app.main(argc, argv, initData);
+}
+
+int
+RateLimitClient::run(int argc, char* argv[])
+{
+    bool weight = argc > 1 && string(argv[1]) == "--weight";
+    bool maxQueued = argc > 1 && string(argv[1]) == "--maxQueued";
+
+    //
+    // Each session is created from its own communicator to get a
+    // connection, and a request queue, per session.
+    //
+    Ice::InitializationData initData;
+    initData.properties = communicator()->getProperties()->clone();
+    Ice::CommunicatorPtr communicatorB = Ice::initialize(initData);
+
+    cout << "creating sessions... " << flush;
+    BackendPrx backendA = createSession(communicator(), "userA");
+    BackendPrx backendB = createSession(communicatorB, "userB");
+    BackendPrx onewayA = backendA->ice_oneway();
+    BackendPrx direct = backendA->ice_router(0);
+    IceMX::MetricsAdminPrx metrics = IceMX::MetricsAdminPrx::uncheckedCast(
+        communicator()->stringToProxy("Glacier2/admin -f Metrics:tcp -h 127.0.0.1 -p 12348")->ice_router(0));
+    direct->reset();
+    cout << "ok" << endl;
+
+    if(maxQueued)
+    {
+        //
+        // The router forwards 10 requests per second for each session
+        // with bursts of up to 5 requests, and queues at most 10
+        // requests per session.
+        //
+        cout << "testing request queue limit... " << flush;
+        {
+            vector<Ice::AsyncResultPtr> results;
+            for(int i = 0; i < 50; ++i)
+            {
+                results.push_back(backendA->begin_hit("A"));
+            }
+
+            int forwarded = 0;
+            int rejected = 0;
+            for(vector<Ice::AsyncResultPtr>::const_iterator p = results.begin(); p != results.end(); ++p)
+            {
+                try
+                {
+                    backendA->end_hit(*p);
+                    ++forwarded;
+                }
+                catch(const Ice::UnknownLocalException&)
+                {
+                    ++rejected;
+                }
+            }
+            test(forwarded + rejected == 50);
+            test(forwarded >= 10 && forwarded <= 30);
+            test(waitForHits(direct, forwarded) == static_cast<Ice::StringSeq::size_type>(forwarded));
+
+            //
+            // The session can be used again once its queue is drained.
+            //
+            backendA->hit("A");
+            test(direct->getHits().size() == static_cast<Ice::StringSeq::size_type>(forwarded + 1));
+        }
+        cout << "ok" << endl;
+
+        cout << "shutting down router... " << flush;
+        Ice::ProcessPrx process = Ice::ProcessPrx::checkedCast(
+            communicator()->stringToProxy("Glacier2/admin -f Process:tcp -h 127.0.0.1 -p 12348")->ice_router(0));
+        process->shutdown();
+        cout << "ok" << endl;
+    }
+    else if(!weight)
+    {
+        //
+        // The router forwards 10 requests per second for each session
+        // with bursts of up to 5 requests.
+        //
+        cout << "testing token bucket... " << flush;
+        {
+            IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+            for(int i = 0; i < 25; ++i)
+            {
+                onewayA->hit("A");
+            }
+
+            //
+            // The burst is forwarded at once, the remaining requests
+            // wait for the bucket to refill.
+            //
+            test(waitForHits(direct, 5) >= 5);
+            test(direct->getHits().size() < 25);
+
+            //
+            // The requests of another session aren't delayed by the
+            // requests of the throttled session.
+            //
+            backendB->hit("B");
+            Ice::StringSeq hits = direct->getHits();
+            test(find(hits.begin(), hits.end(), "B") != hits.end());
+            test(hits.size() < 26);
+
+            test(waitForHits(direct, 26) == 26);
+            test(IceUtil::Time::now(IceUtil::Time::Monotonic) - start >= IceUtil::Time::milliSeconds(1500));
+        }
+        cout << "ok" << endl;
+
+        cout << "testing throttled metrics... " << flush;
+        int throttled;
+        {
+            IceMX::SessionMetricsPtr m = getSessionMetrics(metrics, "userA");
+            test(m->queuedClient == 25);
+            test(m->forwardedClient == 25);
+            test(m->throttledClient > 0 && m->throttledClient <= 20);
+            throttled = m->throttledClient;
+
+            m = getSessionMetrics(metrics, "userB");
+            test(m->forwardedClient == 1);
+            test(m->throttledClient == 0);
+        }
+        cout << "ok" << endl;
+
+        cout << "testing token bucket refill... " << flush;
+        {
+            //
+            // The bucket refills up to the burst size while the session
+            // is idle.
+            //
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(1000));
+            direct->reset();
+            for(int i = 0; i < 10; ++i)
+            {
+                onewayA->hit("A");
+            }
+            test(waitForHits(direct, 5) >= 5);
+            test(direct->getHits().size() < 10);
+            test(waitForHits(direct, 10) == 10);
+
+            IceMX::SessionMetricsPtr m = getSessionMetrics(metrics, "userA");
+            test(m->forwardedClient == 35);
+            test(m->throttledClient > throttled && m->throttledClient <= throttled + 5);
+        }
+        cout << "ok" << endl;
+
+        cout << "testing shutdown with throttled requests... " << flush;
+        {
+            //
+            // Shutdown the router while twoway and oneway requests are
+            // waiting for the rate limit, the twoway requests must
+            // complete and the router must exit.
+            //
+            vector<Ice::AsyncResultPtr> results;
+            for(int i = 0; i < 10; ++i)
+            {
+                results.push_back(backendA->begin_hit("A"));
+            }
+            for(int i = 0; i < 20; ++i)
+            {
+                onewayA->hit("A");
+            }
+
+            Ice::ProcessPrx process = Ice::ProcessPrx::checkedCast(
+                communicator()->stringToProxy("Glacier2/admin -f Process:tcp -h 127.0.0.1 -p 12348")->ice_router(0));
+            process->shutdown();
+
+            for(vector<Ice::AsyncResultPtr>::const_iterator p = results.begin(); p != results.end(); ++p)
+            {
+                try
+                {
+                    backendA->end_hit(*p);
+                }
+                catch(const Ice::LocalException&)
+                {
+                }
+            }
+        }
+        cout << "ok" << endl;
+    }
+    else
+    {
+        //
+        // The router forwards at most 2 requests of a session before
+        // flushing the other sessions and sleeps 200ms between each
+        // flush.
+        //
+        cout << "testing weight... " << flush;
+        {
+            IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+            for(int i = 0; i < 10; ++i)
+            {
+                onewayA->hit("A");
+            }
+            backendB->hit("B");
+
+            test(waitForHits(direct, 11) == 11);
+            test(IceUtil::Time::now(IceUtil::Time::Monotonic) - start >= IceUtil::Time::milliSeconds(600));
+
+            //
+            // The request of the second session is forwarded with the
+            // first requests of the other session instead of waiting
+            // for all of them.
+            //
+            Ice::StringSeq hits = direct->getHits();
+            test(find(hits.begin(), hits.end(), "B") - hits.begin() < 5);
+
+            IceMX::SessionMetricsPtr m = getSessionMetrics(metrics, "userA");
+            test(m->forwardedClient == 10);
+            test(m->throttledClient == 0);
+        }
+        cout << "ok" << endl;
+
+        cout << "shutting down router... " << flush;
+        Ice::ProcessPrx process = Ice::ProcessPrx::checkedCast(
+            communicator()->stringToProxy("Glacier2/admin -f Process:tcp -h 127.0.0.1 -p 12348")->ice_router(0));
+        process->shutdown();
+        cout << "ok" << endl;
+    }
+
+    communicatorB->destroy();
+
+    cout << "shutting down server... " << flush;
+    direct->shutdown();
+    cout << "ok" << endl;
+
+    return EXIT_SUCCESS;
+}
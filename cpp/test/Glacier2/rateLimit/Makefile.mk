@@ -0,0 +1,16 @@
+# **********************************************************************
+#
+# Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+#
+# This copy of Ice is licensed to you under the terms described in the
+# ICE_LICENSE file included in this distribution.
+#
+# **********************************************************************
+
+$(test)_dependencies = Glacier2 Ice TestCommon
+
+$(test)_client_sources = Client.cpp Test.ice
+
+$(test)_server_sources = Server.cpp BackendI.cpp Test.ice
+
+tests += $(test)
@@ -0,0 +1,68 @@
+#!/usr/bin/env python
+# **********************************************************************
+#
+# Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+#
+# This copy of Ice is licensed to you under the terms described in the
+# ICE_LICENSE file included in this distribution.
+#
+# **********************************************************************
+
+
+import os, sys
+
+path = [ ".", "..", "../..", "../../..", "../../../.." ]
+head = os.path.dirname(sys.argv[0])
+if len(head) > 0:
+    path = [os.path.join(head, p) for p in path]
+path = [os.path.abspath(p) for p in path if os.path.exists(os.path.join(p, "scripts", "TestUtil.py")) ]
+if len(path) == 0:
+    raise RuntimeError("can't find toplevel directory!")
+sys.path.append(os.path.join(path[0], "scripts"))
+import TestUtil
+
+router = TestUtil.getGlacier2Router()
+
+if TestUtil.appverifier:
+    TestUtil.setAppVerifierSettings([router])
+
+def startRouter(message, config):
+    args = ' --Ice.Warn.Dispatch=0' + \
+           ' --Ice.Warn.Connections=0' + \
+           ' --Glacier2.Client.Endpoints="default -p 12347"' + \
+           ' --Ice.Admin.Endpoints="tcp -h 127.0.0.1 -p 12348"' + \
+           ' --Ice.Admin.InstanceName="Glacier2"' + \
+           ' --IceMX.Metrics.View.Map.Session.GroupBy=id' + \
+           ' --Glacier2.PermissionsVerifier=Glacier2/NullPermissionsVerifier' + \
+           ' --Glacier2.Client.Buffered=1' + \
+           config
+
+    sys.stdout.write("starting router with %s... " % message)
+    sys.stdout.flush()
+    starterProc = TestUtil.startServer(router, args, count=2)
+    print("ok")
+    return starterProc
+
+name = os.path.join("Glacier2", "rateLimit")
+
+#
+# The rate limit is set for the sessions created with the permissions
+# verifier, the burst for all the sessions.
+#
+starterProc = startRouter("rate limit", ' --Glacier2.Client.Password.RateLimit=10' + \
+                                        ' --Glacier2.Client.RateLimit.Burst=5')
+TestUtil.clientServerTest(name)
+starterProc.waitTestSuccess()
+
+starterProc = startRouter("weight", ' --Glacier2.Client.Weight=2 --Glacier2.Client.SleepTime=200')
+TestUtil.clientServerTest(name, additionalClientOptions = " --weight")
+starterProc.waitTestSuccess()
+
+starterProc = startRouter("request queue limit", ' --Glacier2.Client.RateLimit=10' + \
+                                                 ' --Glacier2.Client.RateLimit.Burst=5' + \
+                                                 ' --Glacier2.Client.MaxQueued=10')
+TestUtil.clientServerTest(name, additionalClientOptions = " --maxQueued")
+starterProc.waitTestSuccess()
+
+if TestUtil.appverifier:
+    TestUtil.appVerifierAfterTestEnd([router])
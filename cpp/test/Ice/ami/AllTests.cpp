@@ -12,6 +12,10 @@
 #include <TestCommon.h>
 #include <Test.h>
 
+#ifdef ICE_CPP11_MAPPING
+#   include <thread>
+#endif
+
 using namespace std;
 
 namespace
@@ -881,6 +885,194 @@ private:
 typedef IceUtil::Handle<Thrower> ThrowerPtr;
 #endif
 
+class HeartbeatCounter
+#ifndef ICE_CPP11_MAPPING
+    : public Ice::HeartbeatCallback
+#endif
+{
+public:
+
+    HeartbeatCounter() :
+        _count(0)
+    {
+    }
+
+    virtual void
+    heartbeat(const Ice::ConnectionPtr&)
+    {
+        IceUtil::Mutex::Lock sync(_mutex);
+        ++_count;
+    }
+
+    int
+    count()
+    {
+        IceUtil::Mutex::Lock sync(_mutex);
+        return _count;
+    }
+
+private:
+
+    IceUtil::Mutex _mutex;
+    int _count;
+};
+ICE_DEFINE_PTR(HeartbeatCounterPtr, HeartbeatCounter);
+
+#ifndef ICE_CPP11_MAPPING
+class AsyncInvoker : public IceUtil::Thread
+{
+public:
+
+    AsyncInvoker(const Test::TestIntfPrx& proxy) :
+        _proxy(proxy)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        vector<Ice::AsyncResultPtr> results;
+        for(int i = 0; i < 200; ++i)
+        {
+            results.push_back(_proxy->begin_opWithResult());
+        }
+        for(vector<Ice::AsyncResultPtr>::const_iterator p = results.begin(); p != results.end(); ++p)
+        {
+            test(_proxy->end_opWithResult(*p) == 15);
+        }
+    }
+
+private:
+
+    const Test::TestIntfPrx _proxy;
+};
+#endif
+
+//
+// With Ice.ThreadPool.Client.CallerRuns, synchronous invocations read
+// their reply from the calling thread. The server sends heartbeats
+// every 500ms with this configuration (see run.py).
+//
+void
+callerRunsTests(const Test::TestIntfPrxPtr& p, const Test::TestIntfControllerPrxPtr& testController)
+{
+    cout << "testing caller runs with concurrent asynchronous invocations... " << flush;
+    {
+        //
+        // The replies of the asynchronous invocations are read either by
+        // the thread pool or by a thread waiting for its own reply.
+        //
+#ifdef ICE_CPP11_MAPPING
+        thread invoker([p]()
+            {
+                vector<future<int>> results;
+                for(int i = 0; i < 200; ++i)
+                {
+                    results.push_back(p->opWithResultAsync());
+                }
+                for(auto& r : results)
+                {
+                    test(r.get() == 15);
+                }
+            });
+        for(int i = 0; i < 200; ++i)
+        {
+            test(p->opWithResult() == 15);
+        }
+        invoker.join();
+#else
+        IceUtil::ThreadPtr invoker = new AsyncInvoker(p);
+        IceUtil::ThreadControl control = invoker->start();
+        for(int i = 0; i < 200; ++i)
+        {
+            test(p->opWithResult() == 15);
+        }
+        control.join();
+#endif
+    }
+    cout << "ok" << endl;
+
+    cout << "testing caller runs with heartbeats... " << flush;
+    {
+        //
+        // Without a heartbeat callback the heartbeats are read by the
+        // calling thread, with a callback they are handed to the thread
+        // pool.
+        //
+        IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        while(IceUtil::Time::now(IceUtil::Time::Monotonic) - start < IceUtil::Time::milliSeconds(1500))
+        {
+            p->op();
+        }
+
+        HeartbeatCounterPtr counter = ICE_MAKE_SHARED(HeartbeatCounter);
+#ifdef ICE_CPP11_MAPPING
+        p->ice_getConnection()->setHeartbeatCallback(
+            [counter](const Ice::ConnectionPtr& connection)
+            {
+                counter->heartbeat(connection);
+            });
+#else
+        p->ice_getConnection()->setHeartbeatCallback(counter);
+#endif
+        start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        while(counter->count() < 2)
+        {
+            test(IceUtil::Time::now(IceUtil::Time::Monotonic) - start < IceUtil::Time::seconds(10));
+            p->op();
+        }
+        p->ice_getConnection()->setHeartbeatCallback(ICE_NULLPTR);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing caller runs with invocation timeouts... " << flush;
+    {
+        //
+        // The calling thread stops polling the connection once the
+        // invocation times out, the late reply is read by the thread
+        // pool and ignored.
+        //
+        testController->holdAdapter();
+        try
+        {
+            p->ice_invocationTimeout(100)->op();
+            test(false);
+        }
+        catch(const Ice::InvocationTimeoutException&)
+        {
+        }
+        catch(...)
+        {
+            testController->resumeAdapter();
+            throw;
+        }
+        testController->resumeAdapter();
+        test(p->opWithResult() == 15);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing caller runs with connection closure... " << flush;
+    {
+        //
+        // The connection is closed by the server while the calling
+        // thread polls it.
+        //
+        Ice::ConnectionPtr connection = p->ice_getConnection();
+        try
+        {
+            p->close(true);
+            test(false);
+        }
+        catch(const Ice::ConnectionLostException&)
+        {
+        }
+        test(p->ice_getConnection() != connection);
+        test(p->opWithResult() == 15);
+    }
+    cout << "ok" << endl;
+}
+
+
 }
 
 void
@@ -2235,6 +2427,12 @@ allTests(const Ice::CommunicatorPtr& communicator, bool collocated)
 
     }
 
+    if(p->ice_getConnection() &&
+       communicator->getProperties()->getPropertyAsInt("Ice.ThreadPool.Client.CallerRuns") > 0)
+    {
+        callerRunsTests(p, testController);
+    }
+
     p->shutdown();
 
 #else
@@ -3777,6 +3975,12 @@ allTests(const Ice::CommunicatorPtr& communicator, bool collocated)
         cout << "ok" << endl;
     }
 
+    if(p->ice_getConnection() &&
+       communicator->getProperties()->getPropertyAsInt("Ice.ThreadPool.Client.CallerRuns") > 0)
+    {
+        callerRunsTests(p, testController);
+    }
+
     p->shutdown();
 #endif
 }
@@ -21,5 +21,10 @@ sys.path.append(os.path.join(path[0], "scripts"))
 import TestUtil
 
 TestUtil.queueClientServerTest()
+TestUtil.queueClientServerTest(configName = "callerRuns", localOnly = True,
+                               message = "Running test with caller runs client thread pool.",
+                               additionalClientOptions = "--Ice.ThreadPool.Client.CallerRuns=1",
+                               additionalServerOptions = "--Ice.ACM.Server.Timeout=1 --Ice.ACM.Server.Heartbeat=3 "
+                                                         "--Ice.ACM.Server.Close=0")
 TestUtil.queueCollocatedTest()
 TestUtil.runQueuedTests()
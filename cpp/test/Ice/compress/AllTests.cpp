@@ -0,0 +1,225 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <IceUtil/Thread.h>
+#include <TestCommon.h>
+#include <Test.h>
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+//
+// Counts the compressed replies from the protocol traces.
+//
+class LoggerI : public Ice::Logger,
+                private IceUtil::Mutex
+#ifdef ICE_CPP11_MAPPING
+              , public std::enable_shared_from_this<LoggerI>
+#endif
+{
+public:
+
+    LoggerI() : _compressedReplies(0)
+    {
+    }
+
+    int
+    compressedReplies()
+    {
+        Lock sync(*this);
+        return _compressedReplies;
+    }
+
+    virtual void
+    print(const std::string& message)
+    {
+        cout << message << endl;
+    }
+
+    virtual void
+    trace(const std::string& category, const std::string& message)
+    {
+        if(category == "Protocol" && message.find("received reply") == 0 &&
+           message.find("compression status = 2") != string::npos)
+        {
+            Lock sync(*this);
+            ++_compressedReplies;
+        }
+    }
+
+    virtual void
+    warning(const std::string& message)
+    {
+        cout << "warning: " << message << endl;
+    }
+
+    virtual void
+    error(const std::string& message)
+    {
+        cout << "error: " << message << endl;
+    }
+
+    virtual string
+    getPrefix()
+    {
+        return "";
+    }
+
+    virtual Ice::LoggerPtr
+    cloneWithPrefix(const std::string&)
+    {
+        return ICE_SHARED_FROM_THIS;
+    }
+
+private:
+
+    int _compressedReplies;
+};
+ICE_DEFINE_PTR(LoggerIPtr, LoggerI);
+
+//
+// Blocks the client thread pool thread which dispatches the first
+// reply until released, the server queues the following replies once
+// the socket buffers are full.
+//
+class Callback : public IceUtil::Monitor<IceUtil::Mutex>
+#ifndef ICE_CPP11_MAPPING
+               , public IceUtil::Shared
+#endif
+{
+public:
+
+    Callback() : _hold(true), _count(0)
+    {
+    }
+
+    void
+    response(const ByteSeq&)
+    {
+        Lock sync(*this);
+        while(_hold)
+        {
+            wait();
+        }
+        ++_count;
+        notifyAll();
+    }
+
+    void
+    exception(const Ice::Exception&)
+    {
+        test(false);
+    }
+
+    void
+    release()
+    {
+        Lock sync(*this);
+        _hold = false;
+        notifyAll();
+    }
+
+    void
+    waitForResponses(int count)
+    {
+        Lock sync(*this);
+        while(_count < count)
+        {
+            wait();
+        }
+    }
+
+private:
+
+    bool _hold;
+    int _count;
+};
+ICE_DEFINE_PTR(CallbackPtr, Callback);
+
+const int requests = 20;
+
+void
+sendQueued(const TestIntfPrxPtr& proxy, const ByteSeq& seq)
+{
+    CallbackPtr cb = ICE_MAKE_SHARED(Callback);
+    for(int i = 0; i < requests; ++i)
+    {
+#ifdef ICE_CPP11_MAPPING
+        proxy->echoAsync(seq,
+                         [cb](const ByteSeq& s)
+                         {
+                             cb->response(s);
+                         },
+                         [](exception_ptr)
+                         {
+                             test(false);
+                         });
+#else
+        proxy->begin_echo(seq, newCallback_TestIntf_echo(cb, &Callback::response, &Callback::exception));
+#endif
+    }
+    IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(500));
+    cb->release();
+    cb->waitForResponses(requests);
+}
+
+}
+
+TestIntfPrxPtr
+allTests(const Ice::CommunicatorPtr& communicator)
+{
+    //
+    // Use a separate communicator with the logger which counts the
+    // compressed replies.
+    //
+    Ice::InitializationData initData;
+    initData.properties = communicator->getProperties()->clone();
+    initData.properties->setProperty("Ice.Trace.Protocol", "1");
+    LoggerIPtr logger = ICE_MAKE_SHARED(LoggerI);
+    initData.logger = logger;
+    Ice::CommunicatorHolder ich = Ice::initialize(initData);
+
+    string ref = "test:" + getTestEndpoint(communicator, 0);
+    TestIntfPrxPtr proxy = ICE_CHECKED_CAST(TestIntfPrx, ich.communicator()->stringToProxy(ref));
+    test(proxy);
+
+    //
+    // Both proxies use the same connection, the proxy with
+    // compression enabled shows the server that the client supports
+    // compression.
+    //
+    Ice::ConnectionPtr connection = proxy->ice_getConnection();
+    TestIntfPrxPtr uncompressed = ICE_UNCHECKED_CAST(TestIntfPrx,
+                                                     connection->createProxy(Ice::stringToIdentity("test")));
+    TestIntfPrxPtr compressed = uncompressed->ice_compress(true);
+
+    ByteSeq seq(64 * 1024, 0);
+
+    cout << "testing automatic compression with a peer which doesn't use compression... " << flush;
+    {
+        sendQueued(uncompressed, seq);
+        test(logger->compressedReplies() == 0);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing automatic compression with a peer which uses compression... " << flush;
+    {
+        compressed->ice_ping();
+        test(logger->compressedReplies() == 0);
+        sendQueued(uncompressed, seq);
+        test(logger->compressedReplies() > 0);
+    }
+    cout << "ok" << endl;
+
+    return ICE_CHECKED_CAST(TestIntfPrx, communicator->stringToProxy(ref));
+}
@@ -0,0 +1,25 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestI.h>
+
+using namespace std;
+
+Test::ByteSeq
+TestIntfI::echo(ICE_IN(Test::ByteSeq) seq, const Ice::Current&)
+{
+    return seq;
+}
+
+void
+TestIntfI::shutdown(const Ice::Current& current)
+{
+    current.adapter->getCommunicator()->shutdown();
+}
@@ -0,0 +1,231 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <algorithm>
+#include <sstream>
+#include <TestCommon.h>
+#include <Test.h>
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+const int payloadSize = 100 * 1024;
+
+//
+// Records the connection memory usage reported by the network traces
+// which are written each time data is sent or received.
+//
+class LoggerI : public Ice::Logger, private IceUtil::Mutex
+{
+public:
+
+    virtual void
+    print(const string& message)
+    {
+        cout << message << endl;
+    }
+
+    virtual void
+    trace(const string& category, const string& message)
+    {
+        if(category != "Network")
+        {
+            return;
+        }
+
+        string::size_type pos = message.find("memory usage = ");
+        if(pos == string::npos)
+        {
+            return;
+        }
+
+        istringstream is(message.substr(pos + 15));
+        size_t usage = 0;
+        is >> usage;
+
+        Lock sync(*this);
+        if(message.find("sent ") == 0)
+        {
+            _sent.push_back(usage);
+        }
+        else if(message.find("received ") == 0)
+        {
+            _received.push_back(usage);
+        }
+    }
+
+    virtual void
+    warning(const string& message)
+    {
+        cout << "warning: " << message << endl;
+    }
+
+    virtual void
+    error(const string& message)
+    {
+        cout << "error: " << message << endl;
+    }
+
+    virtual string
+    getPrefix()
+    {
+        return "";
+    }
+
+    virtual Ice::LoggerPtr
+    cloneWithPrefix(const string&)
+    {
+        return this;
+    }
+
+    void
+    clear()
+    {
+        Lock sync(*this);
+        _sent.clear();
+        _received.clear();
+    }
+
+    size_t
+    maxSent()
+    {
+        Lock sync(*this);
+        return _sent.empty() ? 0 : *max_element(_sent.begin(), _sent.end());
+    }
+
+    size_t
+    maxReceived()
+    {
+        Lock sync(*this);
+        return _received.empty() ? 0 : *max_element(_received.begin(), _received.end());
+    }
+
+    size_t
+    firstSent()
+    {
+        Lock sync(*this);
+        test(!_sent.empty());
+        return _sent.front();
+    }
+
+private:
+
+    vector<size_t> _sent;
+    vector<size_t> _received;
+};
+typedef IceUtil::Handle<LoggerI> LoggerIPtr;
+
+}
+
+void
+allTests(const Ice::CommunicatorPtr& communicator)
+{
+    //
+    // Use a communicator with network tracing enabled, the connection
+    // memory usage is reported with the level 3 network traces.
+    //
+    LoggerIPtr logger = new LoggerI();
+    Ice::InitializationData initData;
+    initData.properties = communicator->getProperties()->clone();
+    initData.properties->setProperty("Ice.Trace.Network", "3");
+    initData.logger = logger;
+    Ice::CommunicatorHolder ich = Ice::initialize(initData);
+
+    string sref = "test:" + getTestEndpoint(communicator, 0);
+    TestIntfPrx p = TestIntfPrx::uncheckedCast(ich->stringToProxy(sref));
+    sref = "testController:" + getTestEndpoint(communicator, 1);
+    TestIntfControllerPrx controller = TestIntfControllerPrx::uncheckedCast(communicator->stringToProxy(sref));
+
+    Ice::ByteSeq seq(payloadSize, 0);
+
+    cout << "testing memory usage of read buffer... " << flush;
+    {
+        p->ice_ping();
+        logger->clear();
+
+        test(p->getPayload(payloadSize * 10).size() == static_cast<size_t>(payloadSize * 10));
+        test(logger->maxReceived() >= static_cast<size_t>(payloadSize * 10));
+
+        //
+        // The read buffer is released once the reply is dispatched.
+        //
+        logger->clear();
+        p->ice_ping();
+        test(logger->firstSent() < static_cast<size_t>(payloadSize));
+    }
+    cout << "ok" << endl;
+
+    cout << "testing memory usage of queued requests... " << flush;
+    {
+        logger->clear();
+        controller->holdAdapter();
+
+        //
+        // Send requests until they no longer can be sent synchronously,
+        // the following requests are queued by the connection.
+        //
+        vector<Ice::AsyncResultPtr> results;
+        while(true)
+        {
+            Ice::AsyncResultPtr r = p->begin_opWithPayload(seq);
+            results.push_back(r);
+            if(!r->sentSynchronously())
+            {
+                break;
+            }
+        }
+        for(int i = 0; i < 5; ++i)
+        {
+            results.push_back(p->begin_opWithPayload(seq));
+        }
+
+        controller->resumeAdapter();
+        for(vector<Ice::AsyncResultPtr>::const_iterator q = results.begin(); q != results.end(); ++q)
+        {
+            p->end_opWithPayload(*q);
+        }
+        test(logger->maxSent() >= static_cast<size_t>(payloadSize * 5));
+
+        //
+        // The queued requests are released once sent.
+        //
+        logger->clear();
+        p->ice_ping();
+        test(logger->firstSent() < static_cast<size_t>(payloadSize));
+    }
+    cout << "ok" << endl;
+
+    cout << "testing memory usage of batch requests... " << flush;
+    {
+        Ice::ConnectionPtr connection = p->ice_getConnection();
+        TestIntfPrx batch =
+            TestIntfPrx::uncheckedCast(connection->createProxy(p->ice_getIdentity())->ice_batchOneway());
+        for(int i = 0; i < 3; ++i)
+        {
+            batch->opWithPayload(seq);
+        }
+
+        logger->clear();
+        p->ice_ping();
+        test(logger->firstSent() >= static_cast<size_t>(payloadSize * 3));
+
+        connection->flushBatchRequests();
+
+        logger->clear();
+        p->ice_ping();
+        test(logger->firstSent() < static_cast<size_t>(payloadSize));
+    }
+    cout << "ok" << endl;
+
+    p->shutdown();
+}
@@ -0,0 +1,46 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestI.h>
+
+using namespace std;
+
+void
+TestIntfI::opWithPayload(const Ice::ByteSeq&, const Ice::Current&)
+{
+}
+
+Ice::ByteSeq
+TestIntfI::getPayload(Ice::Int size, const Ice::Current&)
+{
+    return Ice::ByteSeq(static_cast<size_t>(size));
+}
+
+void
+TestIntfI::shutdown(const Ice::Current& current)
+{
+    current.adapter->getCommunicator()->shutdown();
+}
+
+TestIntfControllerI::TestIntfControllerI(const Ice::ObjectAdapterPtr& adapter) : _adapter(adapter)
+{
+}
+
+void
+TestIntfControllerI::holdAdapter(const Ice::Current&)
+{
+    _adapter->hold();
+}
+
+void
+TestIntfControllerI::resumeAdapter(const Ice::Current&)
+{
+    _adapter->activate();
+}
@@ -0,0 +1,38 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef TESTI_H
+#define TESTI_H
+
+#include <Test.h>
+
+class TestIntfI : public Test::TestIntf
+{
+public:
+
+    virtual void opWithPayload(const Ice::ByteSeq&, const Ice::Current&);
+    virtual Ice::ByteSeq getPayload(Ice::Int, const Ice::Current&);
+    virtual void shutdown(const Ice::Current&);
+};
+
+class TestIntfControllerI : public Test::TestIntfController
+{
+public:
+
+    TestIntfControllerI(const Ice::ObjectAdapterPtr&);
+
+    virtual void holdAdapter(const Ice::Current&);
+    virtual void resumeAdapter(const Ice::Current&);
+
+private:
+
+    const Ice::ObjectAdapterPtr _adapter;
+};
+
+#endif
@@ -0,0 +1,275 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+
+#include <Ice/Ice.h>
+#include <IceUtil/FileUtil.h>
+#include <TestCommon.h>
+#include <Test.h>
+
+#include <fcntl.h>
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+//
+// Counts the writes of file ranges with sendfile from the network
+// traces.
+//
+class LoggerI : public Ice::Logger,
+                private IceUtil::Mutex
+#ifdef ICE_CPP11_MAPPING
+              , public std::enable_shared_from_this<LoggerI>
+#endif
+{
+public:
+
+    LoggerI() : _fileWrites(0)
+    {
+    }
+
+    int
+    fileWrites()
+    {
+        Lock sync(*this);
+        return _fileWrites;
+    }
+
+    virtual void
+    print(const std::string& message)
+    {
+        cout << message << endl;
+    }
+
+    virtual void
+    trace(const std::string& category, const std::string& message)
+    {
+        if(category == "Network" && message.find("file bytes via") != string::npos)
+        {
+            Lock sync(*this);
+            ++_fileWrites;
+        }
+    }
+
+    virtual void
+    warning(const std::string& message)
+    {
+        cout << "warning: " << message << endl;
+    }
+
+    virtual void
+    error(const std::string& message)
+    {
+        cout << "error: " << message << endl;
+    }
+
+    virtual string
+    getPrefix()
+    {
+        return "";
+    }
+
+    virtual Ice::LoggerPtr
+    cloneWithPrefix(const std::string&)
+    {
+        return ICE_SHARED_FROM_THIS;
+    }
+
+private:
+
+    int _fileWrites;
+};
+ICE_DEFINE_PTR(LoggerIPtr, LoggerI);
+
+const string fileName = "fileBytes.dat";
+const Ice::Long fileSize = 256 * 1024;
+
+ByteSeq
+fileContent(Ice::Long offset, Ice::Long length)
+{
+    ByteSeq seq;
+    for(Ice::Long i = offset; i < offset + length; ++i)
+    {
+        seq.push_back(static_cast<Ice::Byte>(i % 251));
+    }
+    return seq;
+}
+
+}
+
+TestIntfPrxPtr
+allTests(const Ice::CommunicatorPtr& communicator, bool collocated)
+{
+    {
+        FILE* file = IceUtilInternal::fopen(fileName, "wb");
+        test(file);
+        ByteSeq content = fileContent(0, fileSize);
+        test(fwrite(&content[0], 1, content.size(), file) == content.size());
+        fclose(file);
+    }
+#ifdef _WIN32
+    int fd = IceUtilInternal::open(fileName, O_RDONLY | O_BINARY);
+#else
+    int fd = IceUtilInternal::open(fileName, O_RDONLY);
+#endif
+    test(fd >= 0);
+
+    string ref = "test:" + getTestEndpoint(communicator, 0);
+    TestIntfPrxPtr proxy = ICE_CHECKED_CAST(TestIntfPrx, communicator->stringToProxy(ref));
+    test(proxy);
+
+    //
+    // The explicitly compressed requests read the file into the
+    // message buffer.
+    //
+    vector<TestIntfPrxPtr> proxies;
+    proxies.push_back(proxy);
+    proxies.push_back(proxy->ice_compress(true));
+
+    cout << "testing file range as the last parameter... " << flush;
+    for(vector<TestIntfPrxPtr>::const_iterator p = proxies.begin(); p != proxies.end(); ++p)
+    {
+        test((*p)->echo(Ice::FileBytes(fd, 0, fileSize)) == fileContent(0, fileSize));
+        test((*p)->echo(Ice::FileBytes(fd, 1000, 100000)) == fileContent(1000, 100000));
+        test((*p)->echo(Ice::FileBytes(fd, 1000, 0)).empty());
+        test((*p)->echo(Ice::FileBytes(fileContent(10, 10))) == fileContent(10, 10));
+
+        IceUtil::Optional<ByteSeq> seq = (*p)->echoOptional(Ice::FileBytes(fd, 5, 70000));
+        test(seq && *seq == fileContent(5, 70000));
+        test(!(*p)->echoOptional(IceUtil::None));
+    }
+    cout << "ok" << endl;
+
+    cout << "testing file range followed by other data... " << flush;
+    for(vector<TestIntfPrxPtr>::const_iterator p = proxies.begin(); p != proxies.end(); ++p)
+    {
+        FileStruct s;
+        s.data = Ice::FileBytes(fd, 3, 50000);
+        s.tail = 42;
+        FileStruct r = (*p)->echoStruct(s);
+        test(r.data.fd < 0 && r.data.bytes == fileContent(3, 50000) && r.tail == 42);
+
+        FileClassPtr c = (*p)->echoClass(ICE_MAKE_SHARED(FileClass, Ice::FileBytes(fd, 7, 60000)));
+        test(c && c->data.bytes == fileContent(7, 60000));
+
+        IceUtil::Optional<FileStruct> o = (*p)->echoOptionalStruct(s);
+        test(o && o->data.bytes == fileContent(3, 50000) && o->tail == 42);
+        test(!(*p)->echoOptionalStruct(IceUtil::None));
+    }
+    cout << "ok" << endl;
+
+    cout << "testing file range returned by the servant... " << flush;
+    proxy->open(fileName);
+    for(vector<TestIntfPrxPtr>::const_iterator p = proxies.begin(); p != proxies.end(); ++p)
+    {
+        Ice::FileBytes data = (*p)->read(0, fileSize);
+        test(data.fd < 0 && data.bytes == fileContent(0, fileSize));
+        test((*p)->read(100, 0).bytes.empty());
+
+        FileStruct s = (*p)->readStruct(200, 30000, 42);
+        test(s.data.bytes == fileContent(200, 30000) && s.tail == 42);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing file shorter than the range... " << flush;
+    {
+        try
+        {
+            proxy->echo(Ice::FileBytes(fd, fileSize - 10, 100));
+            test(false);
+        }
+        catch(const Ice::FileException&)
+        {
+        }
+
+        try
+        {
+            FileStruct s;
+            s.data = Ice::FileBytes(fd, fileSize - 10, 100);
+            s.tail = 42;
+            proxy->echoStruct(s);
+            test(false);
+        }
+        catch(const Ice::FileException&)
+        {
+        }
+
+        //
+        // The server closes the connection if it can't send the reply,
+        // the collocated invocation gets the exception.
+        //
+        try
+        {
+            proxy->read(fileSize - 10, 100);
+            test(false);
+        }
+        catch(const Ice::FileException&)
+        {
+            test(collocated);
+        }
+        catch(const Ice::ConnectionLostException&)
+        {
+            test(!collocated);
+        }
+
+        test(proxy->echo(Ice::FileBytes(fd, 0, 100)) == fileContent(0, 100));
+    }
+    proxy->close();
+    cout << "ok" << endl;
+
+    if(!collocated)
+    {
+        cout << "testing sendfile... " << flush;
+
+        //
+        // Use a separate communicator with the logger which counts
+        // the file ranges sent after the message buffer. They're only
+        // sent with sendfile over TCP on Linux, and not if the message
+        // is compressed.
+        //
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.Trace.Network", "3");
+        LoggerIPtr logger = ICE_MAKE_SHARED(LoggerI);
+        initData.logger = logger;
+        Ice::CommunicatorHolder ich = Ice::initialize(initData);
+
+        TestIntfPrxPtr traced = ICE_UNCHECKED_CAST(TestIntfPrx, ich.communicator()->stringToProxy(ref));
+        traced->ice_ping();
+
+        bool sendfile = false;
+#if defined(__linux__)
+        sendfile = initData.properties->getPropertyWithDefault("Ice.Default.Protocol", "tcp") == "tcp" &&
+            initData.properties->getPropertyAsInt("Ice.Override.Compress") == 0;
+#endif
+
+        test(traced->echo(Ice::FileBytes(fd, 0, fileSize)) == fileContent(0, fileSize));
+        int fileWrites = logger->fileWrites();
+        test(sendfile ? fileWrites > 0 : fileWrites == 0);
+
+        FileStruct s;
+        s.data = Ice::FileBytes(fd, 0, fileSize);
+        s.tail = 42;
+        traced->echoStruct(s);
+        traced->echoClass(ICE_MAKE_SHARED(FileClass, Ice::FileBytes(fd, 0, fileSize)));
+        traced->echoOptionalStruct(s);
+        traced->ice_compress(true)->echo(Ice::FileBytes(fd, 0, fileSize));
+        test(logger->fileWrites() == fileWrites);
+
+        cout << "ok" << endl;
+    }
+
+    IceUtilInternal::close(fd);
+    IceUtilInternal::remove(fileName);
+
+    return proxy;
+}
@@ -0,0 +1,110 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+
+#include <Ice/Ice.h>
+#include <IceUtil/FileUtil.h>
+#include <TestCommon.h>
+#include <TestI.h>
+
+#include <fcntl.h>
+
+using namespace std;
+
+TestIntfI::TestIntfI() :
+    _fd(-1)
+{
+}
+
+TestIntfI::~TestIntfI()
+{
+    if(_fd >= 0)
+    {
+        IceUtilInternal::close(_fd);
+    }
+}
+
+Test::ByteSeq
+TestIntfI::echo(ICE_IN(Ice::FileBytes) data, const Ice::Current&)
+{
+    test(data.fd < 0);
+    return data.bytes;
+}
+
+IceUtil::Optional<Test::ByteSeq>
+TestIntfI::echoOptional(ICE_IN(IceUtil::Optional<Ice::FileBytes>) data, const Ice::Current&)
+{
+    if(!data)
+    {
+        return IceUtil::None;
+    }
+    return data->bytes;
+}
+
+Test::FileStruct
+TestIntfI::echoStruct(ICE_IN(Test::FileStruct) s, const Ice::Current&)
+{
+    return s;
+}
+
+Test::FileClassPtr
+TestIntfI::echoClass(ICE_IN(Test::FileClassPtr) c, const Ice::Current&)
+{
+    return c;
+}
+
+IceUtil::Optional<Test::FileStruct>
+TestIntfI::echoOptionalStruct(ICE_IN(IceUtil::Optional<Test::FileStruct>) s, const Ice::Current&)
+{
+    return s;
+}
+
+void
+TestIntfI::open(ICE_IN(string) path, const Ice::Current&)
+{
+    Lock sync(*this);
+    test(_fd < 0);
+#ifdef _WIN32
+    _fd = IceUtilInternal::open(path, O_RDONLY | O_BINARY);
+#else
+    _fd = IceUtilInternal::open(path, O_RDONLY);
+#endif
+    test(_fd >= 0);
+}
+
+Ice::FileBytes
+TestIntfI::read(Ice::Long offset, Ice::Long length, const Ice::Current&)
+{
+    Lock sync(*this);
+    return Ice::FileBytes(_fd, offset, length);
+}
+
+Test::FileStruct
+TestIntfI::readStruct(Ice::Long offset, Ice::Long length, Ice::Int tail, const Ice::Current&)
+{
+    Lock sync(*this);
+    Test::FileStruct s;
+    s.data = Ice::FileBytes(_fd, offset, length);
+    s.tail = tail;
+    return s;
+}
+
+void
+TestIntfI::close(const Ice::Current&)
+{
+    Lock sync(*this);
+    IceUtilInternal::close(_fd);
+    _fd = -1;
+}
+
+void
+TestIntfI::shutdown(const Ice::Current& current)
+{
+    current.adapter->getCommunicator()->shutdown();
+}
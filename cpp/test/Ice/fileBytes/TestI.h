@@ -0,0 +1,49 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+
+#ifndef TEST_I_H
+#define TEST_I_H
+
+#include <Test.h>
+#include <IceUtil/Mutex.h>
+
+class TestIntfI : public virtual Test::TestIntf, private IceUtil::Mutex
+{
+public:
+
+    TestIntfI();
+    virtual ~TestIntfI();
+
+    virtual Test::ByteSeq echo(ICE_IN(Ice::FileBytes), const Ice::Current&);
+    virtual IceUtil::Optional<Test::ByteSeq> echoOptional(ICE_IN(IceUtil::Optional<Ice::FileBytes>),
+                                                          const Ice::Current&);
+
+    virtual Test::FileStruct echoStruct(ICE_IN(Test::FileStruct), const Ice::Current&);
+    virtual Test::FileClassPtr echoClass(ICE_IN(Test::FileClassPtr), const Ice::Current&);
+    virtual IceUtil::Optional<Test::FileStruct> echoOptionalStruct(ICE_IN(IceUtil::Optional<Test::FileStruct>),
+                                                                   const Ice::Current&);
+
+    virtual void open(ICE_IN(std::string), const Ice::Current&);
+    virtual Ice::FileBytes read(Ice::Long, Ice::Long, const Ice::Current&);
+    virtual Test::FileStruct readStruct(Ice::Long, Ice::Long, Ice::Int, const Ice::Current&);
+    virtual void close(const Ice::Current&);
+
+    virtual void shutdown(const Ice::Current&);
+
+private:
+
+    //
+    // The descriptor stays open until close() so that the ranges
+    // returned by read() can be marshaled after the servant returns.
+    //
+    int _fd;
+};
+
+#endif
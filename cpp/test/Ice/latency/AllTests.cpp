@@ -0,0 +1,183 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestCommon.h>
+#include <Test.h>
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+#ifndef ICE_CPP11_MAPPING
+class GetAdapterNameCB : public IceUtil::Shared, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    void
+    response(const string& name)
+    {
+        Lock sync(*this);
+        assert(!name.empty());
+        _name = name;
+        notify();
+    }
+
+    void
+    exception(const Ice::Exception&)
+    {
+        test(false);
+    }
+
+    string
+    getResult()
+    {
+        Lock sync(*this);
+        while(_name.empty())
+        {
+            wait();
+        }
+        return _name;
+    }
+
+private:
+
+    string _name;
+};
+typedef IceUtil::Handle<GetAdapterNameCB> GetAdapterNameCBPtr;
+#endif
+
+string
+getAdapterNameWithAMI(const TestIntfPrxPtr& proxy)
+{
+#ifdef ICE_CPP11_MAPPING
+    promise<string> p;
+    proxy->getAdapterNameAsync(
+        [&p](string name)
+        {
+            p.set_value(name);
+        },
+        [&p](exception_ptr ex)
+        {
+            p.set_exception(ex);
+        });
+    return p.get_future().get();
+#else
+    GetAdapterNameCBPtr cb = new GetAdapterNameCB();
+    proxy->begin_getAdapterName(
+        newCallback_TestIntf_getAdapterName(cb, &GetAdapterNameCB::response, &GetAdapterNameCB::exception));
+    return cb->getResult();
+#endif
+}
+
+}
+
+TestIntfPrxPtr
+allTests(const Ice::CommunicatorPtr& communicator)
+{
+    Ice::PropertiesPtr properties = communicator->getProperties();
+    string ref = "test:" + getTestEndpoint(communicator, 0) + ":" + getTestEndpoint(communicator, 1);
+
+    cout << "testing latency endpoint selection property... " << flush;
+    TestIntfPrxPtr proxy;
+    {
+        properties->setProperty("Test.Proxy", ref);
+        properties->setProperty("Test.Proxy.EndpointSelection", "Latency");
+        proxy = ICE_UNCHECKED_CAST(TestIntfPrx, communicator->propertyToProxy("Test.Proxy"));
+        test(proxy);
+
+        //
+        // Latency isn't an enumerator of Ice::EndpointSelectionType, the
+        // proxy reports the Random selection type.
+        //
+        test(proxy->ice_getEndpointSelection() == Ice::Random);
+        Ice::PropertyDict proxyProps = communicator->proxyToProperty(proxy, "Test");
+        test(proxyProps["Test.EndpointSelection"] == "Latency");
+
+        TestIntfPrxPtr random = ICE_UNCHECKED_CAST(TestIntfPrx, communicator->stringToProxy(ref));
+        test(Ice::targetNotEqualTo(proxy, random));
+        test(Ice::targetLess(random, proxy));
+
+        //
+        // Setting the endpoint selection type with the proxy API clears
+        // the Latency selection type.
+        //
+        TestIntfPrxPtr ordered = proxy->ice_endpointSelection(Ice::Ordered);
+        proxyProps = communicator->proxyToProperty(ordered, "Test");
+        test(proxyProps["Test.EndpointSelection"] == "Ordered");
+        test(Ice::targetEqualTo(proxy->ice_endpointSelection(Ice::Random), random));
+
+        properties->setProperty("Test.Proxy.EndpointSelection", "Fastest");
+        try
+        {
+            communicator->propertyToProxy("Test.Proxy");
+            test(false);
+        }
+        catch(const Ice::EndpointSelectionTypeParseException&)
+        {
+        }
+        properties->setProperty("Test.Proxy.EndpointSelection", "Latency");
+    }
+    cout << "ok" << endl;
+
+    cout << "testing latency endpoint selection... " << flush;
+    {
+        //
+        // The invocations select their endpoint again every 32 replies
+        // of an endpoint. Endpoints without statistics are tried first,
+        // so after at most two selections both endpoints are measured
+        // and the invocations use the fast endpoint. The cached
+        // connection is cleared once the reply is dispatched, so the
+        // next invocation might still use the previous endpoint.
+        //
+        for(int i = 0; i < 100; ++i)
+        {
+            test(!proxy->getAdapterName().empty());
+        }
+
+        int fast = 0;
+        for(int i = 0; i < 64; ++i)
+        {
+            if(proxy->getAdapterName() == "Fast")
+            {
+                ++fast;
+            }
+        }
+        test(fast == 64);
+
+        //
+        // The statistics are shared by the proxies of the communicator.
+        //
+        TestIntfPrxPtr other = ICE_UNCHECKED_CAST(TestIntfPrx, proxy->ice_connectionId("other"));
+        for(int i = 0; i < 10; ++i)
+        {
+            test(other->getAdapterName() == "Fast");
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing latency endpoint selection with AMI... " << flush;
+    {
+        //
+        // The replies are reported to the latency statistics once the
+        // connection is unlocked, the response callbacks must still be
+        // called.
+        //
+        TestIntfPrxPtr other = ICE_UNCHECKED_CAST(TestIntfPrx, proxy->ice_connectionId("ami"));
+        for(int i = 0; i < 64; ++i)
+        {
+            test(getAdapterNameWithAMI(other) == "Fast");
+        }
+    }
+    cout << "ok" << endl;
+
+    return proxy;
+}
@@ -0,0 +1,56 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestCommon.h>
+#include <TestI.h>
+
+DEFINE_TEST("server")
+
+using namespace std;
+
+int
+run(int, char**, const Ice::CommunicatorPtr& communicator)
+{
+    //
+    // The servant of the Slow adapter answers after 50ms.
+    //
+    communicator->getProperties()->setProperty("Fast.Endpoints", getTestEndpoint(communicator, 0));
+    Ice::ObjectAdapterPtr fast = communicator->createObjectAdapter("Fast");
+    fast->add(ICE_MAKE_SHARED(TestI, 0), Ice::stringToIdentity("test"));
+    fast->activate();
+
+    communicator->getProperties()->setProperty("Slow.Endpoints", getTestEndpoint(communicator, 1));
+    Ice::ObjectAdapterPtr slow = communicator->createObjectAdapter("Slow");
+    slow->add(ICE_MAKE_SHARED(TestI, 50), Ice::stringToIdentity("test"));
+    slow->activate();
+
+    TEST_READY
+    communicator->waitForShutdown();
+    return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char* argv[])
+{
+#ifdef ICE_STATIC_LIBS
+    Ice::registerIceSSL();
+#endif
+
+    try
+    {
+        Ice::CommunicatorHolder ich = Ice::initialize(argc, argv);
+        return run(argc, argv, ich.communicator());
+    }
+    catch(const Ice::Exception& ex)
+    {
+        cerr << ex << endl;
+        return EXIT_FAILURE;
+    }
+}
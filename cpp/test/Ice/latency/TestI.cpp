@@ -0,0 +1,34 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <IceUtil/Thread.h>
+#include <TestI.h>
+
+using namespace std;
+
+TestI::TestI(int delay) : _delay(delay)
+{
+}
+
+string
+TestI::getAdapterName(const Ice::Current& current)
+{
+    if(_delay > 0)
+    {
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(_delay));
+    }
+    return current.adapter->getName();
+}
+
+void
+TestI::shutdown(const Ice::Current& current)
+{
+    current.adapter->getCommunicator()->shutdown();
+}
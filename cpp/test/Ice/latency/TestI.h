@@ -0,0 +1,29 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef TEST_I_H
+#define TEST_I_H
+
+#include <Test.h>
+
+class TestI : public Test::TestIntf
+{
+public:
+
+    TestI(int);
+
+    virtual std::string getAdapterName(const Ice::Current&);
+    virtual void shutdown(const Ice::Current&);
+
+private:
+
+    const int _delay;
+};
+
+#endif
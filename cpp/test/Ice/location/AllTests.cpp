@@ -13,6 +13,8 @@
 #include <TestCommon.h>
 #include <Test.h>
 #include <list>
+#include <fstream>
+#include <cstdio>
 
 using namespace std;
 using namespace Test;
@@ -627,6 +629,70 @@ allTests(const Ice::CommunicatorPtr& communicator, const string& ref)
     }
     cout << "ok" << endl;
 
+    cout << "testing locator cache file... " << flush;
+    {
+        const string file = "locator.cache";
+        remove(file.c_str());
+
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.LocatorCacheFile", file);
+
+        registry->setAdapterDirectProxy("TestAdapter6", locator->findAdapterById("TestAdapter"));
+        Ice::CommunicatorPtr ic = Ice::initialize(initData);
+        int count = locator->getRequestCount();
+        ic->stringToProxy("test@TestAdapter6")->ice_ping();
+        test(++count == locator->getRequestCount());
+        ic->destroy(); // Writes the cache file.
+
+        //
+        // A communicator using the same cache file starts with the
+        // entries of the file, the invocation succeeds with the cached
+        // endpoints even though the adapter is no longer registered.
+        //
+        registry->setAdapterDirectProxy("TestAdapter6", 0);
+        ic = Ice::initialize(initData);
+        ic->stringToProxy("test@TestAdapter6")->ice_ping();
+        ic->destroy();
+
+        //
+        // A corrupted or stale cache file is ignored.
+        //
+        {
+            ofstream out(file.c_str(), ios::binary | ios::trunc);
+            out << "corrupted locator cache file";
+        }
+        ic = Ice::initialize(initData);
+        try
+        {
+            ic->stringToProxy("test@TestAdapter6")->ice_ping();
+            test(false);
+        }
+        catch(const Ice::NotRegisteredException&)
+        {
+        }
+        ic->destroy();
+
+        {
+            const char version[] = { 2, 0, 0, 0, 0 }; // Unknown file version with no records.
+            ofstream out(file.c_str(), ios::binary | ios::trunc);
+            out.write(version, sizeof(version));
+        }
+        ic = Ice::initialize(initData);
+        try
+        {
+            ic->stringToProxy("test@TestAdapter6")->ice_ping();
+            test(false);
+        }
+        catch(const Ice::NotRegisteredException&)
+        {
+        }
+        ic->destroy();
+
+        remove(file.c_str());
+    }
+    cout << "ok" << endl;
+
     cout << "testing proxy from server after shutdown... " << flush;
     hello = obj->getReplicatedHello();
     obj->shutdown();
@@ -24,5 +24,11 @@ TestUtil.queueClientServerTest(additionalClientOptions = "--Ice.Warn.AMICallback
 TestUtil.queueClientServerTest(configName = "amd", localOnly = True, message = "Running test with AMD server.",
                                additionalClientOptions = "--Ice.Warn.AMICallback=0",
                                server = TestUtil.getTestExecutable("serveramd"))
+TestUtil.queueClientServerTest(configName = "callerRuns", localOnly = True,
+                               message = "Running test with caller runs client thread pool.",
+                               additionalClientOptions = "--Ice.Warn.AMICallback=0 "
+                                                         "--Ice.ThreadPool.Client.CallerRuns=1",
+                               additionalServerOptions = "--Ice.ACM.Server.Timeout=1 --Ice.ACM.Server.Heartbeat=3 "
+                                                         "--Ice.ACM.Server.Close=0")
 TestUtil.queueCollocatedTest()
 TestUtil.runQueuedTests()
@@ -88,6 +88,101 @@ public:
 };
 typedef IceUtil::Handle<CallbackFail> CallbackFailPtr;
 
+class LoggerI : public Ice::Logger,
+                private IceUtil::Mutex
+#ifdef ICE_CPP11_MAPPING
+              , public std::enable_shared_from_this<LoggerI>
+#endif
+{
+public:
+
+    LoggerI(const string& address) : _address(address), _attempts(0), _opened(0), _closed(0)
+    {
+    }
+
+    int
+    attempts()
+    {
+        Lock sync(*this);
+        return _attempts;
+    }
+
+    int
+    opened()
+    {
+        Lock sync(*this);
+        return _opened;
+    }
+
+    int
+    closed()
+    {
+        Lock sync(*this);
+        return _closed;
+    }
+
+    virtual void
+    print(const string& message)
+    {
+        cout << message << endl;
+    }
+
+    virtual void
+    trace(const string& category, const string& message)
+    {
+        if(category != "Network")
+        {
+            return;
+        }
+
+        Lock sync(*this);
+        if(message.find("trying to establish") != string::npos && message.find(_address) != string::npos)
+        {
+            ++_attempts;
+        }
+        else if(message.find("opened circuit breaker") != string::npos)
+        {
+            ++_opened;
+        }
+        else if(message.find("closed circuit breaker") != string::npos)
+        {
+            ++_closed;
+        }
+    }
+
+    virtual void
+    warning(const string& message)
+    {
+        cout << "warning: " << message << endl;
+    }
+
+    virtual void
+    error(const string& message)
+    {
+        cout << "error: " << message << endl;
+    }
+
+    virtual string
+    getPrefix()
+    {
+        return "";
+    }
+
+    virtual Ice::LoggerPtr
+    cloneWithPrefix(const string&)
+    {
+        return ICE_SHARED_FROM_THIS;
+    }
+
+private:
+
+    const string _address;
+    int _attempts;
+    int _opened;
+    int _closed;
+};
+ICE_DEFINE_PTR(LoggerIPtr, LoggerI);
+
 RetryPrxPtr
 allTests(const Ice::CommunicatorPtr& communicator, const Ice::CommunicatorPtr& communicator2, const string& ref)
 {
@@ -339,5 +434,175 @@ allTests(const Ice::CommunicatorPtr& communicator, const Ice::CommunicatorPtr& c
     }
     cout << "ok" << endl;
 
+    if(retry1->ice_getConnection())
+    {
+        cout << "testing retry budget... " << flush;
+        {
+            //
+            // Each completed invocation deposits half a retry, the
+            // balance starts with and is capped at a reserve of 2
+            // retries.
+            //
+            Ice::InitializationData initData;
+            initData.properties = communicator->getProperties()->clone();
+            initData.properties->setProperty("Ice.RetryIntervals", "0 0 0 0 0");
+            initData.properties->setProperty("Ice.RetryBudget", "50");
+            initData.properties->setProperty("Ice.RetryBudget.Reserve", "2");
+            initData.observer = getObserver();
+            Ice::CommunicatorPtr comm = Ice::initialize(initData);
+            RetryPrxPtr retry = ICE_UNCHECKED_CAST(RetryPrx, comm->stringToProxy(retry1->ice_toString()));
+
+            try
+            {
+                retry->opIdempotent(4);
+                test(false);
+            }
+            catch(const Ice::LocalException&)
+            {
+            }
+            testRetryCount(2);
+            retry->opIdempotent(-1); // Reset the counter, the balance is now half a retry.
+
+            try
+            {
+                retry->opIdempotent(1);
+                test(false);
+            }
+            catch(const Ice::LocalException&)
+            {
+            }
+            testRetryCount(0);
+            retry->opIdempotent(-1); // The balance is now one retry.
+
+            test(retry->opIdempotent(1) == 1);
+            testRetryCount(1);
+
+            for(int i = 0; i < 10; ++i)
+            {
+                retry->opIdempotent(-1);
+            }
+            try
+            {
+                retry->opIdempotent(4);
+                test(false);
+            }
+            catch(const Ice::LocalException&)
+            {
+            }
+            testRetryCount(2);
+            retry->opIdempotent(-1);
+
+            comm->destroy();
+            testInvocationCount(-1);
+            testFailureCount(-1);
+        }
+        cout << "ok" << endl;
+
+        cout << "testing retry jitter... " << flush;
+        {
+            //
+            // Each retry waits between 100ms and 200ms instead of 200ms.
+            //
+            Ice::InitializationData initData;
+            initData.properties = communicator->getProperties()->clone();
+            initData.properties->setProperty("Ice.RetryIntervals", "200 200 200 200 200 200 200 200 200 200");
+            initData.properties->setProperty("Ice.RetryJitter", "1");
+            initData.observer = getObserver();
+            Ice::CommunicatorPtr comm = Ice::initialize(initData);
+            RetryPrxPtr retry = ICE_UNCHECKED_CAST(RetryPrx, comm->stringToProxy(retry1->ice_toString()));
+            retry->ice_ping();
+
+            IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+            test(retry->opIdempotent(10) == 10);
+            IceUtil::Time elapsed = IceUtil::Time::now(IceUtil::Time::Monotonic) - start;
+            testRetryCount(10);
+            test(elapsed >= IceUtil::Time::milliSeconds(1000));
+            test(elapsed < IceUtil::Time::milliSeconds(1900));
+
+            comm->destroy();
+            testInvocationCount(-1);
+            testFailureCount(-1);
+        }
+        cout << "ok" << endl;
+
+        cout << "testing circuit breakers... " << flush;
+        {
+            string deadEndpoint = getTestEndpoint(communicator, 9, "tcp");
+            Ice::EndpointSeq endpoints = communicator->stringToProxy("dummy:" + deadEndpoint)->ice_getEndpoints();
+            Ice::IPEndpointInfoPtr ipInfo = ICE_DYNAMIC_CAST(Ice::IPEndpointInfo, endpoints[0]->getInfo());
+            test(ipInfo);
+            ostringstream os;
+            os << ":" << ipInfo->port;
+
+            //
+            // The circuit of an endpoint opens after 2 connection
+            // failures and is probed again after a second.
+            //
+            Ice::InitializationData initData;
+            initData.properties = communicator->getProperties()->clone();
+            initData.properties->setProperty("Ice.CircuitBreaker.Threshold", "2");
+            initData.properties->setProperty("Ice.CircuitBreaker.Timeout", "1");
+            initData.properties->setProperty("Ice.Default.EndpointSelection", "Ordered");
+            initData.properties->setProperty("Ice.RetryIntervals", "-1");
+            initData.properties->setProperty("Ice.Trace.Network", "2");
+            LoggerIPtr logger = ICE_MAKE_SHARED(LoggerI, os.str());
+            initData.logger = logger;
+            Ice::CommunicatorPtr comm = Ice::initialize(initData);
+
+            //
+            // The proxy doesn't cache its connection, each invocation
+            // gets a connection from the connection factory and the
+            // connections are closed to force new connection attempts.
+            //
+            Ice::ObjectPrxPtr prx = comm->stringToProxy("retry:" + deadEndpoint + ":" +
+                                                        getTestEndpoint(communicator, 0));
+            prx = prx->ice_connectionCached(false);
+
+            prx->ice_getConnection()->close(false);
+            test(logger->attempts() == 1 && logger->opened() == 0);
+            prx->ice_getConnection()->close(false);
+            test(logger->attempts() == 2 && logger->opened() == 1);
+
+            //
+            // The circuit is open, the endpoint is skipped.
+            //
+            prx->ice_getConnection()->close(false);
+            prx->ice_ping();
+            test(logger->attempts() == 2);
+
+            //
+            // Once the timeout expires, a single connection attempt
+            // probes the endpoint and the circuit stays open if it
+            // fails.
+            //
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(1200));
+            prx->ice_getConnection()->close(false);
+            test(logger->attempts() == 3);
+            prx->ice_getConnection()->close(false);
+            test(logger->attempts() == 3 && logger->closed() == 0);
+
+            //
+            // A successful probe closes the circuit.
+            //
+            Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapterWithEndpoints("CircuitBreaker",
+                                                                                          deadEndpoint);
+            adapter->activate();
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(1200));
+            Ice::ConnectionPtr connection = prx->ice_getConnection();
+            test(logger->attempts() == 4 && logger->closed() == 1);
+            Ice::IPConnectionInfoPtr connectionInfo =
+                ICE_DYNAMIC_CAST(Ice::IPConnectionInfo, connection->getInfo());
+            test(connectionInfo && connectionInfo->remotePort == ipInfo->port);
+            connection->close(false);
+            adapter->destroy();
+
+            comm->destroy();
+            testInvocationCount(-1);
+            testFailureCount(-1);
+            testRetryCount(-1);
+        }
+        cout << "ok" << endl;
+    }
+
     return retry1;
 }
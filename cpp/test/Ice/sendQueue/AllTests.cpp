@@ -0,0 +1,256 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+
+#include <Ice/Ice.h>
+#include <IceUtil/Monitor.h>
+#include <sstream>
+#include <TestCommon.h>
+#include <Test.h>
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+const int payloadSize = 1024 * 1024;
+
+//
+// Records the replies received by the client, the first reply blocks
+// the client thread pool until the callback is released.
+//
+class CallbackI : public IceUtil::Shared, private IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    CallbackI() :
+        _blocked(false),
+        _released(false)
+    {
+    }
+
+    void
+    blocked(Ice::Int)
+    {
+        Lock sync(*this);
+        _blocked = true;
+        notifyAll();
+        while(!_released)
+        {
+            wait();
+        }
+    }
+
+    void
+    payload(const Ice::ByteSeq& seq)
+    {
+        test(seq.size() == static_cast<size_t>(payloadSize));
+        Lock sync(*this);
+        _received.push_back(-1);
+        notifyAll();
+    }
+
+    void
+    echo(Ice::Int seq)
+    {
+        Lock sync(*this);
+        _received.push_back(seq);
+        notifyAll();
+    }
+
+    void
+    exception(const Ice::Exception& ex)
+    {
+        cerr << ex << endl;
+        test(false);
+    }
+
+    void
+    waitBlocked()
+    {
+        Lock sync(*this);
+        while(!_blocked)
+        {
+            wait();
+        }
+    }
+
+    void
+    release()
+    {
+        Lock sync(*this);
+        _released = true;
+        notifyAll();
+    }
+
+    Ice::IntSeq
+    waitReceived(size_t count)
+    {
+        Lock sync(*this);
+        while(_received.size() < count)
+        {
+            wait();
+        }
+        return _received;
+    }
+
+private:
+
+    bool _blocked;
+    bool _released;
+    Ice::IntSeq _received;
+};
+typedef IceUtil::Handle<CallbackI> CallbackIPtr;
+
+//
+// Sends requests with a large payload until the send blocks, the last
+// request is still being sent when this returns.
+//
+void
+sendUntilBlocked(const TestIntfPrx& p, const Ice::ByteSeq& payload, Ice::IntSeq& expected)
+{
+    while(true)
+    {
+        Ice::Int seq = static_cast<Ice::Int>(expected.size());
+        Ice::AsyncResultPtr r = p->begin_opWithPayload(seq, payload);
+        expected.push_back(seq);
+        if(!r->sentSynchronously())
+        {
+            break;
+        }
+    }
+}
+
+}
+
+void
+allTests(const Ice::CommunicatorPtr& communicator)
+{
+    string sref = "test:" + getTestEndpoint(communicator, 0);
+    TestIntfPrx p = TestIntfPrx::uncheckedCast(communicator->stringToProxy(sref));
+    sref = "testController:" + getTestEndpoint(communicator, 1);
+    TestIntfControllerPrx controller = TestIntfControllerPrx::uncheckedCast(communicator->stringToProxy(sref));
+
+    Ice::ByteSeq payload(payloadSize, 0);
+
+    cout << "testing order of queued requests... " << flush;
+    {
+        Ice::ConnectionPtr connection = p->ice_getConnection();
+        TestIntfPrx oneway = TestIntfPrx::uncheckedCast(p->ice_oneway());
+        TestIntfPrx batch =
+            TestIntfPrx::uncheckedCast(connection->createProxy(p->ice_getIdentity())->ice_batchOneway());
+
+        controller->holdAdapter();
+
+        Ice::IntSeq expected;
+        sendUntilBlocked(oneway, payload, expected);
+
+        //
+        // The oneway and batch requests are queued behind the request
+        // being sent and must be dispatched in the order they were sent.
+        //
+        for(int i = 0; i < 10; ++i)
+        {
+            Ice::Int seq = static_cast<Ice::Int>(expected.size());
+            test(!oneway->begin_record(seq)->sentSynchronously());
+            expected.push_back(seq);
+        }
+        for(int i = 0; i < 10; ++i)
+        {
+            Ice::Int seq = static_cast<Ice::Int>(expected.size());
+            batch->record(seq);
+            expected.push_back(seq);
+        }
+        test(!connection->begin_flushBatchRequests()->sentSynchronously());
+        for(int i = 0; i < 10; ++i)
+        {
+            Ice::Int seq = static_cast<Ice::Int>(expected.size());
+            test(!oneway->begin_record(seq)->sentSynchronously());
+            expected.push_back(seq);
+        }
+
+        controller->resumeAdapter();
+        test(p->getRecorded() == expected);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing priority of queued requests... " << flush;
+    {
+        TestIntfPrx oneway = TestIntfPrx::uncheckedCast(p->ice_oneway());
+
+        controller->holdAdapter();
+
+        Ice::IntSeq expected;
+        sendUntilBlocked(oneway, payload, expected);
+
+        //
+        // The queued requests are sent by decreasing priority and in the
+        // order they were queued for a given priority. The request being
+        // sent, which has the default priority, isn't preempted.
+        //
+        const int priorities[] = { 0, 1, 5, 1, 0, 5, 3, 0, 3, 5 };
+        const int count = static_cast<int>(sizeof(priorities) / sizeof(int));
+        Ice::IntSeq queued;
+        for(int priority = 5; priority >= 0; --priority)
+        {
+            for(int i = 0; i < count; ++i)
+            {
+                if(priorities[i] == priority)
+                {
+                    queued.push_back(static_cast<Ice::Int>(expected.size()) + i);
+                }
+            }
+        }
+
+        for(int i = 0; i < count; ++i)
+        {
+            Ice::Context ctx;
+            ostringstream os;
+            os << priorities[i];
+            ctx["_priority"] = os.str();
+            test(!oneway->begin_record(static_cast<Ice::Int>(expected.size()) + i, ctx)->sentSynchronously());
+        }
+        expected.insert(expected.end(), queued.begin(), queued.end());
+
+        controller->resumeAdapter();
+        test(p->getRecorded() == expected);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing order of coalesced replies... " << flush;
+    {
+        CallbackIPtr cb = new CallbackI();
+
+        //
+        // Block the client thread pool, the client no longer reads the
+        // replies and the server blocks sending the large reply. The
+        // following replies are queued by the server and coalesced into
+        // a single write once the large reply is sent.
+        //
+        p->begin_echo(-2, newCallback_TestIntf_echo(cb, &CallbackI::blocked, &CallbackI::exception));
+        cb->waitBlocked();
+
+        p->begin_getPayload(payloadSize, newCallback_TestIntf_getPayload(cb, &CallbackI::payload,
+                                                                         &CallbackI::exception));
+        Ice::IntSeq expected;
+        expected.push_back(-1);
+        for(int i = 0; i < 20; ++i)
+        {
+            p->begin_echo(i, newCallback_TestIntf_echo(cb, &CallbackI::echo, &CallbackI::exception));
+            expected.push_back(i);
+        }
+
+        cb->release();
+        test(cb->waitReceived(expected.size()) == expected);
+    }
+    cout << "ok" << endl;
+
+    p->shutdown();
+}
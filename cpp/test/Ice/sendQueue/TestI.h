@@ -0,0 +1,46 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+
+#ifndef TESTI_H
+#define TESTI_H
+
+#include <Test.h>
+
+class TestIntfI : public Test::TestIntf, private IceUtil::Mutex
+{
+public:
+
+    virtual void opWithPayload(Ice::Int, const Ice::ByteSeq&, const Ice::Current&);
+    virtual void record(Ice::Int, const Ice::Current&);
+    virtual Ice::IntSeq getRecorded(const Ice::Current&);
+    virtual Ice::Int echo(Ice::Int, const Ice::Current&);
+    virtual Ice::ByteSeq getPayload(Ice::Int, const Ice::Current&);
+    virtual void shutdown(const Ice::Current&);
+
+private:
+
+    Ice::IntSeq _recorded;
+};
+
+class TestIntfControllerI : public Test::TestIntfController
+{
+public:
+
+    TestIntfControllerI(const Ice::ObjectAdapterPtr&);
+
+    virtual void holdAdapter(const Ice::Current&);
+    virtual void resumeAdapter(const Ice::Current&);
+
+private:
+
+    const Ice::ObjectAdapterPtr _adapter;
+};
+
+#endif
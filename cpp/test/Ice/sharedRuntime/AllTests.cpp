@@ -0,0 +1,365 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+
+#include <Ice/Ice.h>
+#include <IceUtil/Thread.h>
+#include <TestCommon.h>
+#include <TestI.h>
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+Ice::InitializationData
+createInitData(const Ice::CommunicatorPtr& communicator, const ThreadCounterPtr& counter)
+{
+    Ice::InitializationData initData;
+    initData.properties = communicator->getProperties()->clone();
+#ifdef ICE_CPP11_MAPPING
+    initData.threadStart = [counter] { counter->start(); };
+    initData.threadStop = [counter] { counter->stop(); };
+#else
+    initData.threadHook = counter;
+#endif
+    return initData;
+}
+
+Ice::CommunicatorPtr
+createCommunicator(const Ice::CommunicatorPtr& communicator, const Ice::RuntimePtr& runtime)
+{
+    Ice::InitializationData initData;
+    initData.properties = communicator->getProperties()->clone();
+    initData.runtime = runtime;
+    return Ice::initialize(initData);
+}
+
+TestIntfPrxPtr
+createServant(const Ice::CommunicatorPtr& communicator, const string& name, const string& endpoints)
+{
+    Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapterWithEndpoints(name, endpoints);
+    TestIntfPrxPtr proxy = ICE_UNCHECKED_CAST(TestIntfPrx, adapter->add(ICE_MAKE_SHARED(TestIntfI, name),
+                                                                          Ice::stringToIdentity("test")));
+    adapter->activate();
+    return proxy;
+}
+
+#ifndef ICE_CPP11_MAPPING
+class DispatcherI : public Ice::Dispatcher
+{
+public:
+
+    virtual void
+    dispatch(const Ice::DispatcherCallPtr& call, const Ice::ConnectionPtr&)
+    {
+        call->run();
+    }
+};
+#endif
+
+//
+// Blocks the thread which calls the response callback until released.
+//
+class BlockingCallback : public IceUtil::Monitor<IceUtil::Mutex>
+#ifndef ICE_CPP11_MAPPING
+                       , public IceUtil::Shared
+#endif
+{
+public:
+
+    BlockingCallback() : _called(false), _hold(true), _completed(false)
+    {
+    }
+
+    void
+    response(const string&)
+    {
+        Lock sync(*this);
+        _called = true;
+        notifyAll();
+        while(_hold)
+        {
+            wait();
+        }
+        _completed = true;
+    }
+
+    void
+    exception(const Ice::Exception&)
+    {
+        test(false);
+    }
+
+    void
+    waitForCall()
+    {
+        Lock sync(*this);
+        while(!_called)
+        {
+            wait();
+        }
+    }
+
+    void
+    release()
+    {
+        Lock sync(*this);
+        _hold = false;
+        notifyAll();
+    }
+
+    bool
+    completed()
+    {
+        Lock sync(*this);
+        return _completed;
+    }
+
+private:
+
+    bool _called;
+    bool _hold;
+    bool _completed;
+};
+ICE_DEFINE_PTR(BlockingCallbackPtr, BlockingCallback);
+
+class DestroyThread : public IceUtil::Thread
+{
+public:
+
+    DestroyThread(const Ice::CommunicatorPtr& communicator, const BlockingCallbackPtr& callback) :
+        _communicator(communicator),
+        _callback(callback),
+        _callbackCompleted(false)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        _communicator->destroy();
+        _callbackCompleted = _callback->completed();
+    }
+
+    bool
+    callbackCompleted() const
+    {
+        return _callbackCompleted;
+    }
+
+private:
+
+    const Ice::CommunicatorPtr _communicator;
+    const BlockingCallbackPtr _callback;
+    bool _callbackCompleted;
+};
+typedef IceUtil::Handle<DestroyThread> DestroyThreadPtr;
+
+}
+
+void
+allTests(const Ice::CommunicatorPtr& communicator)
+{
+    ThreadCounterPtr runtimeCounter = ICE_MAKE_SHARED(ThreadCounter);
+    Ice::RuntimePtr runtime = Ice::createRuntime(createInitData(communicator, runtimeCounter));
+
+    Ice::CommunicatorPtr communicator1 = createCommunicator(communicator, runtime);
+    Ice::CommunicatorPtr communicator2 = createCommunicator(communicator, runtime);
+
+    TestIntfPrxPtr proxy1 = createServant(communicator1, "Adapter1", getTestEndpoint(communicator, 0));
+    TestIntfPrxPtr proxy2 = createServant(communicator2, "Adapter2", getTestEndpoint(communicator, 1));
+
+    //
+    // The proxies of each communicator to the servant of the other.
+    //
+    TestIntfPrxPtr proxy1To2 = ICE_UNCHECKED_CAST(TestIntfPrx, communicator1->stringToProxy(
+                                                      communicator2->proxyToString(proxy2)));
+    TestIntfPrxPtr proxy2To1 = ICE_UNCHECKED_CAST(TestIntfPrx, communicator2->stringToProxy(
+                                                      communicator1->proxyToString(proxy1)));
+
+    cout << "testing communicators sharing a runtime... " << flush;
+    {
+        test(proxy1To2->getName() == "Adapter2");
+        test(proxy2To1->getName() == "Adapter1");
+
+        //
+        // Nested invocations from the dispatch of the other communicator.
+        //
+        test(proxy1To2->getNameFrom(proxy2To1) == "Adapter1");
+        test(proxy2To1->getNameFrom(proxy1To2) == "Adapter2");
+
+#ifdef ICE_CPP11_MAPPING
+        vector<future<string>> results;
+        for(int i = 0; i < 20; ++i)
+        {
+            results.push_back(proxy1To2->getNameAsync());
+            results.push_back(proxy2To1->getNameAsync());
+        }
+        for(vector<future<string>>::size_type i = 0; i < results.size(); ++i)
+        {
+            test(results[i].get() == (i % 2 ? "Adapter1" : "Adapter2"));
+        }
+#else
+        vector<Ice::AsyncResultPtr> results;
+        for(int i = 0; i < 20; ++i)
+        {
+            results.push_back(proxy1To2->begin_getName());
+            results.push_back(proxy2To1->begin_getName());
+        }
+        for(vector<Ice::AsyncResultPtr>::size_type i = 0; i < results.size(); ++i)
+        {
+            test((i % 2 ? proxy2To1 : proxy1To2)->end_getName(results[i]) == (i % 2 ? "Adapter1" : "Adapter2"));
+        }
+#endif
+
+        //
+        // The thread pools, timer and endpoint host resolver are the
+        // runtime's.
+        //
+        test(runtimeCounter->count() > 0);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing configuration of a communicator sharing a runtime... " << flush;
+    {
+        //
+        // The threads are configured by the runtime.
+        //
+        ThreadCounterPtr counter = ICE_MAKE_SHARED(ThreadCounter);
+        Ice::InitializationData initData = createInitData(communicator, counter);
+        initData.runtime = runtime;
+        try
+        {
+            Ice::initialize(initData);
+            test(false);
+        }
+        catch(const Ice::InitializationException&)
+        {
+        }
+
+        initData = Ice::InitializationData();
+        initData.properties = communicator->getProperties()->clone();
+        initData.runtime = runtime;
+#ifdef ICE_CPP11_MAPPING
+        initData.dispatcher = [](function<void()> call, const shared_ptr<Ice::Connection>&)
+            {
+                call();
+            };
+#else
+        initData.dispatcher = new DispatcherI();
+#endif
+        try
+        {
+            Ice::initialize(initData);
+            test(false);
+        }
+        catch(const Ice::InitializationException&)
+        {
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing destroy of a communicator with pending callbacks... " << flush;
+    {
+        //
+        // The response of a collocated AMD invocation is dispatched
+        // with the shared client thread pool. Destroying the
+        // communicator waits for the callback to return.
+        //
+        Ice::CommunicatorPtr communicator3 = createCommunicator(communicator, runtime);
+        TestIntfPrxPtr proxy3 = createServant(communicator3, "Adapter3", "default");
+
+        BlockingCallbackPtr callback = ICE_MAKE_SHARED(BlockingCallback);
+#ifdef ICE_CPP11_MAPPING
+        proxy3->getNameAmdAsync([callback](const string& name)
+                                {
+                                    callback->response(name);
+                                },
+                                [](exception_ptr)
+                                {
+                                    test(false);
+                                });
+#else
+        proxy3->begin_getNameAmd(newCallback_TestIntf_getNameAmd(callback, &BlockingCallback::response,
+                                                                 &BlockingCallback::exception));
+#endif
+        callback->waitForCall();
+
+        DestroyThreadPtr thread = new DestroyThread(communicator3, callback);
+        IceUtil::ThreadControl threadControl = thread->start();
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(200));
+        callback->release();
+        threadControl.join();
+        test(thread->callbackCompleted());
+    }
+    cout << "ok" << endl;
+
+    cout << "testing destroy of a communicator sharing a runtime... " << flush;
+    {
+        communicator1->destroy();
+        test(runtimeCounter->count() > 0);
+
+        try
+        {
+            proxy2To1->getName();
+            test(false);
+        }
+        catch(const Ice::ConnectionRefusedException&)
+        {
+        }
+
+        //
+        // The other communicators of the runtime keep working, and new
+        // ones can be created.
+        //
+        test(proxy2->getName() == "Adapter2");
+
+        Ice::CommunicatorPtr communicator3 = createCommunicator(communicator, runtime);
+        TestIntfPrxPtr proxy3To2 = ICE_UNCHECKED_CAST(TestIntfPrx, communicator3->stringToProxy(
+                                                          communicator2->proxyToString(proxy2)));
+        test(proxy3To2->getName() == "Adapter2");
+        communicator3->destroy();
+
+        test(proxy2->getName() == "Adapter2");
+
+        communicator2->destroy();
+        test(runtimeCounter->count() > 0);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing destroy of a runtime... " << flush;
+    {
+        runtime->destroy();
+        test(runtimeCounter->count() == 0);
+
+        try
+        {
+            createCommunicator(communicator, runtime);
+            test(false);
+        }
+        catch(const Ice::CommunicatorDestroyedException&)
+        {
+        }
+
+        Ice::InitializationData initData;
+        initData.runtime = Ice::createRuntime();
+        try
+        {
+            Ice::createRuntime(initData);
+            test(false);
+        }
+        catch(const Ice::InitializationException&)
+        {
+        }
+        initData.runtime->destroy();
+    }
+    cout << "ok" << endl;
+}
@@ -0,0 +1,85 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+
+#include <Ice/Ice.h>
+#include <TestI.h>
+
+using namespace std;
+
+ThreadCounter::ThreadCounter() :
+    _count(0),
+    _started(0)
+{
+}
+
+void
+ThreadCounter::start()
+{
+    Lock sync(*this);
+    ++_count;
+    ++_started;
+}
+
+void
+ThreadCounter::stop()
+{
+    Lock sync(*this);
+    --_count;
+}
+
+int
+ThreadCounter::count()
+{
+    Lock sync(*this);
+    return _count;
+}
+
+int
+ThreadCounter::started()
+{
+    Lock sync(*this);
+    return _started;
+}
+
+TestIntfI::TestIntfI(const string& name) :
+    _name(name)
+{
+}
+
+string
+TestIntfI::getName(const Ice::Current&)
+{
+    return _name;
+}
+
+string
+TestIntfI::getNameFrom(ICE_IN(Test::TestIntfPrxPtr) proxy, const Ice::Current&)
+{
+    //
+    // The nested invocation waits for its reply, read by the shared
+    // client thread pool, from a thread of the shared server thread
+    // pool.
+    //
+    return proxy->getName();
+}
+
+#ifdef ICE_CPP11_MAPPING
+void
+TestIntfI::getNameAmdAsync(function<void(const string&)> response, function<void(exception_ptr)>, const Ice::Current&)
+{
+    response(_name);
+}
+#else
+void
+TestIntfI::getNameAmd_async(const Test::AMD_TestIntf_getNameAmdPtr& cb, const Ice::Current&)
+{
+    cb->ice_response(_name);
+}
+#endif
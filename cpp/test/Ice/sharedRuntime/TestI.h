@@ -0,0 +1,62 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+
+#ifndef TEST_I_H
+#define TEST_I_H
+
+#include <Test.h>
+#include <IceUtil/Mutex.h>
+
+//
+// Counts the threads started with a thread hook.
+//
+class ThreadCounter : public IceUtil::Mutex
+#ifndef ICE_CPP11_MAPPING
+                    , public Ice::ThreadNotification
+#endif
+{
+public:
+
+    ThreadCounter();
+
+    virtual void start();
+    virtual void stop();
+
+    int count();
+    int started();
+
+private:
+
+    int _count;
+    int _started;
+};
+ICE_DEFINE_PTR(ThreadCounterPtr, ThreadCounter);
+
+class TestIntfI : public Test::TestIntf
+{
+public:
+
+    TestIntfI(const std::string&);
+
+    virtual std::string getName(const Ice::Current&);
+    virtual std::string getNameFrom(ICE_IN(Test::TestIntfPrxPtr), const Ice::Current&);
+#ifdef ICE_CPP11_MAPPING
+    virtual void getNameAmdAsync(std::function<void(const std::string&)>, std::function<void(std::exception_ptr)>,
+                                 const Ice::Current&);
+#else
+    virtual void getNameAmd_async(const Test::AMD_TestIntf_getNameAmdPtr&, const Ice::Current&);
+#endif
+
+private:
+
+    const std::string _name;
+};
+
+#endif
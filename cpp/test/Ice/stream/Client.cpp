@@ -1104,6 +1104,45 @@ run(int, char**, const Ice::CommunicatorPtr& communicator)
         test(dict2 == dict);
     }
 
+    {
+        //
+        // Entries received out of order, as sent by a hash map, are sorted.
+        //
+        Ice::OutputStream out(communicator);
+        out.writeSize(4);
+        out.write(string("key3"));
+        out.write(string("value3"));
+        out.write(string("key1"));
+        out.write(string("value1"));
+        out.write(string("key4"));
+        out.write(string("value4"));
+        out.write(string("key2"));
+        out.write(string("value2"));
+        out.finished(data);
+        Ice::InputStream in(communicator, data);
+        StringStringFD dict;
+        in.read(dict);
+        test(dict.size() == 4);
+        StringStringFD::const_iterator p = dict.begin();
+        test(p->first == "key1" && p->second == "value1");
+        ++p;
+        test(p->first == "key2" && p->second == "value2");
+        ++p;
+        test(p->first == "key3" && p->second == "value3");
+        ++p;
+        test(p->first == "key4" && p->second == "value4");
+        test(dict.find("key3")->second == "value3");
+        test(dict.find("key5") == dict.end());
+
+        Ice::OutputStream out2(communicator);
+        out2.write(dict);
+        out2.finished(data);
+        Ice::InputStream in2(communicator, data);
+        StringStringFD dict2;
+        in2.read(dict2);
+        test(dict2 == dict);
+    }
+
     {
         StringMyClassD dict;
         dict["key1"] = ICE_MAKE_SHARED(MyClass);
@@ -0,0 +1,299 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+
+#include <Ice/Ice.h>
+#include <TestCommon.h>
+#include <Test.h>
+
+DEFINE_TEST("client")
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+AllTypes
+createAllTypes()
+{
+    AllTypes v;
+    v.bo = true;
+    v.by = 1;
+    v.sh = 2;
+    v.i = 3;
+    v.l = 4;
+    v.f = 5.0f;
+    v.d = 6.0;
+    v.str = "hello";
+    v.c = ICE_ENUM(Color, green);
+    v.p.x = 7;
+    v.p.y = 8;
+    for(int i = 0; i < 3; ++i)
+    {
+        Point p;
+        p.x = i;
+        p.y = -i;
+        v.points.push_back(p);
+    }
+    v.strings.push_back("a");
+    v.strings.push_back("b");
+    v.dict["one"] = 1;
+    v.dict["two"] = 2;
+    return v;
+}
+
+}
+
+int
+run(int, char**, const Ice::CommunicatorPtr& communicator)
+{
+    vector<Ice::Byte> data;
+
+    cout << "testing structs... " << flush;
+    {
+        Point p;
+        p.x = 1;
+        p.y = 2;
+        Ice::OutputStream out(communicator);
+        out.write(p);
+        out.finished(data);
+        Ice::InputStream in(communicator, data);
+        Point p2;
+        in.read(p2);
+        test(p2 == p);
+    }
+
+    {
+        AllTypes v = createAllTypes();
+        Ice::OutputStream out(communicator);
+        out.write(v);
+        out.finished(data);
+        Ice::InputStream in(communicator, data);
+        AllTypes v2;
+        in.read(v2);
+        test(v2 == v);
+    }
+
+    {
+        WideStruct v;
+        v.ws = L"wide";
+        v.i = 9;
+        Ice::OutputStream out(communicator);
+        out.write(v);
+        out.finished(data);
+        Ice::InputStream in(communicator, data);
+        WideStruct v2;
+        in.read(v2);
+        test(v2.ws == v.ws);
+        test(v2.i == v.i);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing struct encoding... " << flush;
+    {
+        //
+        // The members described by the stream table must be encoded
+        // exactly like the members marshaled one by one.
+        //
+        AllTypes v = createAllTypes();
+        Ice::OutputStream out(communicator);
+        out.write(v);
+        out.finished(data);
+
+        vector<Ice::Byte> expected;
+        Ice::OutputStream out2(communicator);
+        out2.write(v.bo);
+        out2.write(v.by);
+        out2.write(v.sh);
+        out2.write(v.i);
+        out2.write(v.l);
+        out2.write(v.f);
+        out2.write(v.d);
+        out2.write(v.str);
+        out2.write(v.c);
+        out2.write(v.p.x);
+        out2.write(v.p.y);
+        out2.write(v.points);
+        out2.write(v.strings);
+        out2.write(v.dict);
+        out2.finished(expected);
+        test(data == expected);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing classes... " << flush;
+    {
+        NodePtr n1 = ICE_MAKE_SHARED(Node);
+        n1->id = 1;
+        n1->name = "first";
+        n1->pos.x = 10;
+        n1->pos.y = 11;
+        n1->weight = 100;
+        n1->label = string("label");
+        Point offset;
+        offset.x = 3;
+        offset.y = 4;
+        n1->offset = offset;
+
+        NodePtr n2 = ICE_MAKE_SHARED(Node);
+        n2->id = 2;
+        n2->name = "second";
+        n2->weight = 200;
+        n1->next = n2;
+
+        Ice::OutputStream out(communicator);
+        out.write(n1);
+        out.writePendingValues();
+        out.finished(data);
+        Ice::InputStream in(communicator, data);
+        NodePtr r1;
+        in.read(r1);
+        in.readPendingValues();
+
+        test(r1->id == 1);
+        test(r1->name == "first");
+        test(r1->pos == n1->pos);
+        test(r1->weight == 100);
+        test(r1->next);
+        test(r1->next->id == 2);
+        test(r1->next->name == "second");
+        test(r1->next->weight == 200);
+        test(!r1->next->next);
+        test(!r1->next->label);
+        test(!r1->next->offset);
+        if(in.getEncoding() == Ice::Encoding_1_0)
+        {
+            test(!r1->label);
+            test(!r1->offset);
+        }
+        else
+        {
+            test(r1->label == n1->label);
+            test(r1->offset == n1->offset);
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing optionals... " << flush;
+    {
+        OptionalClassPtr o = ICE_MAKE_SHARED(OptionalClass);
+        o->flag = true;
+        Ice::OutputStream out(communicator);
+        out.write(o);
+        out.writePendingValues();
+        out.finished(data);
+        Ice::InputStream in(communicator, data);
+        OptionalClassPtr o2;
+        in.read(o2);
+        in.readPendingValues();
+        test(o2->flag);
+        test(!o2->i);
+        test(!o2->s);
+        test(!o2->p);
+        test(!o2->seq);
+        test(!o2->c);
+    }
+
+    {
+        OptionalClassPtr o = ICE_MAKE_SHARED(OptionalClass);
+        o->flag = false;
+        o->i = 5;
+        o->s = string("optional");
+        Point p;
+        p.x = 1;
+        p.y = 2;
+        o->p = p;
+        Ice::StringSeq seq;
+        seq.push_back("x");
+        o->seq = seq;
+        o->c = ICE_ENUM(Color, blue);
+        Ice::OutputStream out(communicator);
+        out.write(o);
+        out.writePendingValues();
+        out.finished(data);
+        Ice::InputStream in(communicator, data);
+        OptionalClassPtr o2;
+        in.read(o2);
+        in.readPendingValues();
+        test(!o2->flag);
+        if(in.getEncoding() == Ice::Encoding_1_0)
+        {
+            test(!o2->i);
+            test(!o2->s);
+            test(!o2->p);
+            test(!o2->seq);
+            test(!o2->c);
+        }
+        else
+        {
+            test(o2->i == o->i);
+            test(o2->s == o->s);
+            test(o2->p == o->p);
+            test(o2->seq == o->seq);
+            test(o2->c == o->c);
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing exceptions... " << flush;
+    {
+        DerivedError ex;
+        ex.code = 42;
+        ex.reason = "failure";
+        ex.p.x = 5;
+        ex.p.y = 6;
+        ex.detail = 7;
+        Ice::OutputStream out(communicator);
+        out.write(ex);
+        out.finished(data);
+        Ice::InputStream in(communicator, data);
+        try
+        {
+            in.throwException();
+            test(false);
+        }
+        catch(const DerivedError& ex2)
+        {
+            test(ex2.code == 42);
+            test(ex2.reason == "failure");
+            test(ex2.p == ex.p);
+            if(in.getEncoding() == Ice::Encoding_1_0)
+            {
+                test(!ex2.detail);
+            }
+            else
+            {
+                test(ex2.detail == ex.detail);
+            }
+        }
+    }
+    cout << "ok" << endl;
+
+    return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char* argv[])
+{
+#ifdef ICE_STATIC_LIBS
+    Ice::registerIceSSL();
+#endif
+
+    try
+    {
+        Ice::CommunicatorHolder ich = Ice::initialize(argc, argv);
+        return run(argc, argv, ich.communicator());
+    }
+    catch(const Ice::Exception& ex)
+    {
+        cerr << ex << endl;
+        return EXIT_FAILURE;
+    }
+}
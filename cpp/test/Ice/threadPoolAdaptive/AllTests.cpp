@@ -0,0 +1,125 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <IceUtil/Thread.h>
+#include <TestCommon.h>
+#include <Test.h>
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+//
+// Sends concurrent requests to the server for 2 seconds and returns
+// the peak number of server threads.
+//
+int
+load(const TestIntfPrxPtr& proxy)
+{
+    int peakCount = 0;
+    IceUtil::Time end = IceUtil::Time::now(IceUtil::Time::Monotonic) + IceUtil::Time::seconds(2);
+    while(IceUtil::Time::now(IceUtil::Time::Monotonic) < end)
+    {
+#ifdef ICE_CPP11_MAPPING
+        vector<future<void>> results;
+        for(int i = 0; i < 6; ++i)
+        {
+            results.push_back(proxy->sleepAsync(50));
+        }
+        peakCount = max(peakCount, proxy->getThreadCount());
+        for(vector<future<void>>::iterator p = results.begin(); p != results.end(); ++p)
+        {
+            p->get();
+        }
+#else
+        vector<Ice::AsyncResultPtr> results;
+        for(int i = 0; i < 6; ++i)
+        {
+            results.push_back(proxy->begin_sleep(50));
+        }
+        peakCount = max(peakCount, static_cast<int>(proxy->getThreadCount()));
+        for(vector<Ice::AsyncResultPtr>::const_iterator p = results.begin(); p != results.end(); ++p)
+        {
+            proxy->end_sleep(*p);
+        }
+#endif
+    }
+    return peakCount;
+}
+
+}
+
+TestIntfPrxPtr
+allTests(const Ice::CommunicatorPtr& communicator)
+{
+    string ref = "test:" + getTestEndpoint(communicator, 0);
+    TestIntfPrxPtr proxy = ICE_CHECKED_CAST(TestIntfPrx, communicator->stringToProxy(ref));
+    test(proxy);
+
+    //
+    // The server thread pool starts with Size=2 threads, the other
+    // threads of the server don't change during the test.
+    //
+    const int baseCount = proxy->getThreadCount();
+    const int sizeMax = 10;
+
+    cout << "testing adaptive thread pool growth... " << flush;
+    int peakCount;
+    {
+        peakCount = load(proxy);
+        test(peakCount > baseCount);
+        test(peakCount <= baseCount - 2 + sizeMax);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing adaptive thread pool shrinking... " << flush;
+    {
+        //
+        // With a light serial load, the target size decreases by one
+        // thread per sampling interval and the surplus threads exit.
+        // The pool must never shrink below its size, even if several
+        // surplus threads time out together.
+        //
+        IceUtil::Time end = IceUtil::Time::now(IceUtil::Time::Monotonic) + IceUtil::Time::seconds(30);
+        int count = proxy->getThreadCount();
+        while(count > baseCount && IceUtil::Time::now(IceUtil::Time::Monotonic) < end)
+        {
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(20));
+            count = proxy->getThreadCount();
+            test(count >= baseCount);
+        }
+        test(count == baseCount);
+
+        //
+        // Let several sampling intervals pass without any load and
+        // check again that the pool kept its size.
+        //
+        IceUtil::ThreadControl::sleep(IceUtil::Time::seconds(2));
+        test(proxy->getThreadCount() == baseCount);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing adaptive thread pool shrinking while idle... " << flush;
+    {
+        //
+        // The idle followers adjust the target size when the pool no
+        // longer dispatches, the pool shrinks without any request.
+        //
+        peakCount = load(proxy);
+        test(peakCount > baseCount);
+        IceUtil::ThreadControl::sleep(IceUtil::Time::seconds(10));
+        test(proxy->getThreadCount() == baseCount);
+    }
+    cout << "ok" << endl;
+
+    return proxy;
+}
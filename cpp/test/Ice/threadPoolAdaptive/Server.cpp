@@ -0,0 +1,67 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestCommon.h>
+#include <TestI.h>
+
+DEFINE_TEST("server")
+
+using namespace std;
+
+int
+run(int, char**, const Ice::CommunicatorPtr& communicator, const ThreadCounterPtr& counter)
+{
+    communicator->getProperties()->setProperty("TestAdapter.Endpoints", getTestEndpoint(communicator, 0));
+    Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("TestAdapter");
+    adapter->add(ICE_MAKE_SHARED(TestIntfI, counter), Ice::stringToIdentity("test"));
+    adapter->activate();
+    TEST_READY
+    communicator->waitForShutdown();
+    return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char* argv[])
+{
+#ifdef ICE_STATIC_LIBS
+    Ice::registerIceSSL();
+#endif
+
+    try
+    {
+        Ice::InitializationData initData;
+        initData.properties = Ice::createProperties(argc, argv);
+
+        //
+        // The server thread pool is only resized by the adaptive
+        // controller, the idle threads aren't reaped.
+        //
+        initData.properties->setProperty("Ice.ThreadPool.Server.Adaptive", "1");
+        initData.properties->setProperty("Ice.ThreadPool.Server.Size", "2");
+        initData.properties->setProperty("Ice.ThreadPool.Server.SizeMax", "10");
+        initData.properties->setProperty("Ice.ThreadPool.Server.ThreadIdleTime", "0");
+
+        ThreadCounterPtr counter = ICE_MAKE_SHARED(ThreadCounter);
+#ifdef ICE_CPP11_MAPPING
+        initData.threadStart = [counter] { counter->start(); };
+        initData.threadStop = [counter] { counter->stop(); };
+#else
+        initData.threadHook = counter;
+#endif
+
+        Ice::CommunicatorHolder ich = Ice::initialize(argc, argv, initData);
+        return run(argc, argv, ich.communicator(), counter);
+    }
+    catch(const Ice::Exception& ex)
+    {
+        cerr << ex << endl;
+        return EXIT_FAILURE;
+    }
+}
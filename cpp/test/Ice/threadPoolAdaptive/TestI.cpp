@@ -0,0 +1,61 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <IceUtil/Thread.h>
+#include <TestI.h>
+
+using namespace std;
+
+ThreadCounter::ThreadCounter() : _count(0)
+{
+}
+
+void
+ThreadCounter::start()
+{
+    Lock sync(*this);
+    ++_count;
+}
+
+void
+ThreadCounter::stop()
+{
+    Lock sync(*this);
+    --_count;
+}
+
+int
+ThreadCounter::count()
+{
+    Lock sync(*this);
+    return _count;
+}
+
+TestIntfI::TestIntfI(const ThreadCounterPtr& counter) : _counter(counter)
+{
+}
+
+void
+TestIntfI::sleep(Ice::Int ms, const Ice::Current&)
+{
+    IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(ms));
+}
+
+Ice::Int
+TestIntfI::getThreadCount(const Ice::Current&)
+{
+    return _counter->count();
+}
+
+void
+TestIntfI::shutdown(const Ice::Current& current)
+{
+    current.adapter->getCommunicator()->shutdown();
+}
@@ -0,0 +1,54 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef TEST_I_H
+#define TEST_I_H
+
+#include <Test.h>
+#include <IceUtil/Mutex.h>
+
+//
+// Counts the threads of the server communicator with the thread hook.
+//
+class ThreadCounter : public IceUtil::Mutex
+#ifndef ICE_CPP11_MAPPING
+                    , public Ice::ThreadNotification
+#endif
+{
+public:
+
+    ThreadCounter();
+
+    virtual void start();
+    virtual void stop();
+
+    int count();
+
+private:
+
+    int _count;
+};
+ICE_DEFINE_PTR(ThreadCounterPtr, ThreadCounter);
+
+class TestIntfI : public Test::TestIntf
+{
+public:
+
+    TestIntfI(const ThreadCounterPtr&);
+
+    virtual void sleep(Ice::Int, const Ice::Current&);
+    virtual Ice::Int getThreadCount(const Ice::Current&);
+    virtual void shutdown(const Ice::Current&);
+
+private:
+
+    const ThreadCounterPtr _counter;
+};
+
+#endif
@@ -28,3 +28,5 @@ config2 = os.path.join(os.getcwd(), "config.icebox2")
 TestUtil.addAdditionalBinDirectories([os.path.join(os.getcwd(), TestUtil.getTestDirectory("testservice"))])
 TestUtil.clientServerTest(additionalServerOptions= '--Ice.Config="%s"' % config, server = icebox)
 TestUtil.clientServerTest(additionalServerOptions= '--Ice.Config="%s"' % config2, server = icebox)
+TestUtil.clientServerTest(additionalServerOptions= '--Ice.Config="%s" --IceBox.UseSharedRuntime=1' % config,
+                          server = icebox)
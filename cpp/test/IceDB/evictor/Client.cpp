@@ -0,0 +1,407 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <IceUtil/StringUtil.h>
+#include <IceDB/Evictor.h>
+#include <TestCommon.h>
+#include <Test.h>
+
+DEFINE_TEST("client")
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+class AccountI : public Account, public IceUtil::Mutex
+{
+public:
+
+    AccountI(int balance) : _balance(balance)
+    {
+    }
+
+    virtual int
+    getBalance(const Ice::Current&)
+    {
+        Lock sync(*this);
+        return _balance;
+    }
+
+    virtual void
+    deposit(int amount, const Ice::Current&)
+    {
+        Lock sync(*this);
+        _balance += amount;
+    }
+
+private:
+
+    int _balance;
+};
+typedef IceUtil::Handle<AccountI> AccountIPtr;
+
+//
+// In-memory store which records the servants loaded and saved by the
+// evictor.
+//
+class MemoryStore : public IceDB::ServantStore, public IceUtil::Mutex
+{
+public:
+
+    MemoryStore() : _failSaves(false)
+    {
+    }
+
+    virtual Ice::ObjectPtr
+    load(const Ice::Identity& id)
+    {
+        Lock sync(*this);
+        _loaded.push_back(id.name);
+        map<string, int>::const_iterator p = _balances.find(id.name);
+        if(p == _balances.end())
+        {
+            return 0;
+        }
+        return new AccountI(p->second);
+    }
+
+    virtual void
+    save(const IceDB::ServantSeq& servants)
+    {
+        Lock sync(*this);
+        if(_failSaves)
+        {
+            throw IceUtil::IllegalArgumentException(__FILE__, __LINE__, "save failure");
+        }
+
+        Ice::StringSeq batch;
+        for(IceDB::ServantSeq::const_iterator p = servants.begin(); p != servants.end(); ++p)
+        {
+            _balances[p->first.name] = AccountIPtr::dynamicCast(p->second)->getBalance();
+            batch.push_back(p->first.name);
+        }
+        sort(batch.begin(), batch.end());
+        _saved.push_back(batch);
+    }
+
+    void
+    add(const string& name, int balance)
+    {
+        Lock sync(*this);
+        _balances[name] = balance;
+    }
+
+    int
+    balance(const string& name)
+    {
+        Lock sync(*this);
+        return _balances[name];
+    }
+
+    void
+    failSaves(bool fail)
+    {
+        Lock sync(*this);
+        _failSaves = fail;
+    }
+
+    Ice::StringSeq
+    takeLoaded()
+    {
+        Lock sync(*this);
+        Ice::StringSeq loaded;
+        loaded.swap(_loaded);
+        return loaded;
+    }
+
+    vector<Ice::StringSeq>
+    takeSaved()
+    {
+        Lock sync(*this);
+        vector<Ice::StringSeq> saved;
+        saved.swap(_saved);
+        return saved;
+    }
+
+private:
+
+    map<string, int> _balances;
+    bool _failSaves;
+    Ice::StringSeq _loaded;
+    vector<Ice::StringSeq> _saved;
+};
+typedef IceUtil::Handle<MemoryStore> MemoryStorePtr;
+
+class AccountStore : public IceDB::LMDBServantStore<AccountState>
+{
+public:
+
+    AccountStore(const Ice::CommunicatorPtr& communicator, const string& path) :
+        IceDB::LMDBServantStore<AccountState>(communicator, path, "accounts")
+    {
+    }
+
+protected:
+
+    virtual Ice::ObjectPtr
+    createServant(const Ice::Identity&, const AccountState& state)
+    {
+        return new AccountI(state.balance);
+    }
+
+    virtual AccountState
+    getState(const Ice::ObjectPtr& servant)
+    {
+        AccountState state;
+        state.balance = AccountIPtr::dynamicCast(servant)->getBalance();
+        return state;
+    }
+};
+typedef IceUtil::Handle<AccountStore> AccountStorePtr;
+
+Ice::StringSeq
+names(const string& str)
+{
+    Ice::StringSeq seq;
+    IceUtilInternal::splitString(str, " ", seq);
+    return seq;
+}
+
+AccountPrx
+account(const Ice::ObjectAdapterPtr& adapter, const string& category, const string& name)
+{
+    Ice::Identity id;
+    id.category = category;
+    id.name = name;
+    return AccountPrx::uncheckedCast(adapter->createProxy(id));
+}
+
+}
+
+int
+run(int, char**, const Ice::CommunicatorPtr& communicator)
+{
+    communicator->getProperties()->setProperty("TestAdapter.Endpoints", "default -p 12010");
+    Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("TestAdapter");
+    adapter->activate();
+
+    MemoryStorePtr store = new MemoryStore();
+    store->add("a", 0);
+    store->add("b", 10);
+    store->add("c", 20);
+    store->add("d", 30);
+
+    //
+    // The evictor keeps two servants in memory and only saves the
+    // modified servants on eviction or flush.
+    //
+    IceDB::EvictorPtr evictor = new IceDB::Evictor(store, 2, 10);
+    adapter->addServantLocator(evictor, "account");
+    AccountPrx a = account(adapter, "account", "a");
+    AccountPrx b = account(adapter, "account", "b");
+    AccountPrx c = account(adapter, "account", "c");
+    AccountPrx d = account(adapter, "account", "d");
+
+    cout << "testing eviction order... " << flush;
+    {
+        test(a->getBalance() == 0);
+        test(b->getBalance() == 10);
+        test(a->getBalance() == 0);
+        test(store->takeLoaded() == names("a b"));
+        test(evictor->hits() == 1 && evictor->misses() == 2);
+
+        //
+        // b is the least recently used servant, it's evicted first.
+        //
+        test(c->getBalance() == 20);
+        test(a->getBalance() == 0);
+        test(store->takeLoaded() == names("c"));
+
+        test(b->getBalance() == 10); // Evicts c
+        test(c->getBalance() == 20); // Evicts a
+        test(b->getBalance() == 10);
+        test(store->takeLoaded() == names("b c"));
+        test(evictor->hits() == 3 && evictor->misses() == 5);
+
+        try
+        {
+            account(adapter, "account", "unknown")->ice_ping();
+            test(false);
+        }
+        catch(const Ice::ObjectNotExistException&)
+        {
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing write-back of modified servants... " << flush;
+    {
+        store->takeLoaded();
+
+        //
+        // Idempotent operations don't modify the servant.
+        //
+        test(c->getBalance() == 20);
+        test(a->getBalance() == 0); // Evicts b
+        test(d->getBalance() == 30); // Evicts c
+        test(store->takeSaved().empty());
+
+        c->deposit(5); // Evicts a
+        test(store->takeSaved().empty());
+        test(store->balance("c") == 20);
+
+        //
+        // c is saved when it's evicted and reloaded with its new state.
+        //
+        test(b->getBalance() == 10); // Evicts d
+        test(a->getBalance() == 0); // Evicts c
+        vector<Ice::StringSeq> saved = store->takeSaved();
+        test(saved.size() == 1 && saved[0] == names("c"));
+        test(store->balance("c") == 25);
+        store->takeLoaded();
+        test(c->getBalance() == 25); // Evicts b
+        test(store->takeLoaded() == names("c"));
+
+        //
+        // Flushing the evictor saves the modified servants without
+        // evicting them.
+        //
+        a->deposit(1);
+        test(store->takeSaved().empty());
+        evictor->flush();
+        saved = store->takeSaved();
+        test(saved.size() == 1 && saved[0] == names("a"));
+        test(store->balance("a") == 1);
+        test(a->getBalance() == 1);
+        test(store->takeLoaded().empty());
+        evictor->flush();
+        test(store->takeSaved().empty());
+    }
+    cout << "ok" << endl;
+
+    cout << "testing batched write-back... " << flush;
+    {
+        store->add("e", 0);
+        store->add("f", 0);
+        store->add("g", 0);
+        IceDB::EvictorPtr batchEvictor = new IceDB::Evictor(store, 10, 2);
+        adapter->addServantLocator(batchEvictor, "batch");
+        account(adapter, "batch", "e")->deposit(1);
+        test(store->takeSaved().empty());
+        account(adapter, "batch", "f")->deposit(1);
+        vector<Ice::StringSeq> saved = store->takeSaved();
+        test(saved.size() == 1 && saved[0] == names("e f"));
+        account(adapter, "batch", "g")->deposit(1);
+        test(store->takeSaved().empty());
+        test(store->balance("e") == 1 && store->balance("f") == 1 && store->balance("g") == 0);
+        adapter->removeServantLocator("batch")->deactivate("batch");
+        saved = store->takeSaved();
+        test(saved.size() == 1 && saved[0] == names("g"));
+    }
+    cout << "ok" << endl;
+
+    cout << "testing write-back failures... " << flush;
+    {
+        //
+        // a is the most recently used servant, c is modified and is
+        // the next servant to be evicted.
+        //
+        c->deposit(1);
+        test(a->getBalance() == 1);
+        store->takeLoaded();
+
+        //
+        // Loading b evicts c which can't be saved: the request fails
+        // and c stays in memory.
+        //
+        store->failSaves(true);
+        try
+        {
+            b->getBalance();
+            test(false);
+        }
+        catch(const Ice::UnknownException&)
+        {
+        }
+        store->failSaves(false);
+        test(store->takeLoaded() == names("b"));
+        test(store->takeSaved().empty());
+        test(store->balance("c") == 25);
+
+        //
+        // The next eviction saves c, and b which failed to load above
+        // can be evicted.
+        //
+        test(d->getBalance() == 30);
+        vector<Ice::StringSeq> saved = store->takeSaved();
+        test(saved.size() == 1 && saved[0] == names("c"));
+        test(store->balance("c") == 26);
+        test(a->getBalance() == 1);
+        test(b->getBalance() == 10);
+        test(store->takeLoaded() == names("d a b"));
+    }
+    cout << "ok" << endl;
+
+    cout << "testing LMDB servant store... " << flush;
+    {
+        string path = communicator->getProperties()->getPropertyWithDefault("Test.DbPath", "db");
+        AccountStorePtr accounts = new AccountStore(communicator, path);
+        IceDB::ServantSeq servants;
+        servants.push_back(make_pair(Ice::stringToIdentity("x"), Ice::ObjectPtr(new AccountI(100))));
+        servants.push_back(make_pair(Ice::stringToIdentity("y"), Ice::ObjectPtr(new AccountI(200))));
+        accounts->save(servants);
+
+        IceDB::EvictorPtr dbEvictor = new IceDB::Evictor(accounts, 1, 10);
+        adapter->addServantLocator(dbEvictor, "");
+        AccountPrx x = AccountPrx::uncheckedCast(adapter->createProxy(Ice::stringToIdentity("x")));
+        AccountPrx y = AccountPrx::uncheckedCast(adapter->createProxy(Ice::stringToIdentity("y")));
+        x->deposit(1);
+        test(AccountIPtr::dynamicCast(accounts->load(Ice::stringToIdentity("x")))->getBalance() == 100);
+        y->deposit(2); // Evicts x
+        test(AccountIPtr::dynamicCast(accounts->load(Ice::stringToIdentity("x")))->getBalance() == 101);
+        test(x->getBalance() == 101);
+        try
+        {
+            AccountPrx::uncheckedCast(adapter->createProxy(Ice::stringToIdentity("z")))->ice_ping();
+            test(false);
+        }
+        catch(const Ice::ObjectNotExistException&)
+        {
+        }
+        test(!accounts->load(Ice::stringToIdentity("z")));
+
+        adapter->removeServantLocator("")->deactivate("");
+        test(AccountIPtr::dynamicCast(accounts->load(Ice::stringToIdentity("y")))->getBalance() == 202);
+    }
+    cout << "ok" << endl;
+
+    return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char* argv[])
+{
+#ifdef ICE_STATIC_LIBS
+    Ice::registerIceSSL();
+#endif
+
+    try
+    {
+        Ice::CommunicatorHolder ich = Ice::initialize(argc, argv);
+        return run(argc, argv, ich.communicator());
+    }
+    catch(const Ice::Exception& ex)
+    {
+        cerr << ex << endl;
+        return EXIT_FAILURE;
+    }
+}
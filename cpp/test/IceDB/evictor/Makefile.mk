@@ -0,0 +1,15 @@
+# **********************************************************************
+#
+# Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+#
+# This copy of Ice is licensed to you under the terms described in the
+# ICE_LICENSE file included in this distribution.
+#
+# **********************************************************************
+
+$(test)_dependencies	= IceDB Ice TestCommon
+$(test)_cppflags	:= -I$(srcdir)
+
+$(test)_client_sources	= Client.cpp Test.ice
+
+tests += $(test)
@@ -683,6 +683,93 @@ allTests(const Ice::CommunicatorPtr& communicator)
     }
     cout << "ok" << endl;
 
+    cout << "testing server metrics views... " << flush;
+    {
+        //
+        // The servers don't configure any metrics view, the view can't
+        // be retrieved from any of them.
+        //
+        Ice::StringSeq unreachable;
+        IceGrid::ServerMetricsView view = admin->getAllServerMetricsViews("View", 5000, unreachable);
+        test(view.empty());
+        Ice::StringSeq ids = admin->getAllServerIds();
+        sort(ids.begin(), ids.end());
+        sort(unreachable.begin(), unreachable.end());
+        test(unreachable == ids);
+
+        //
+        // Deploy servers which configure the view, the view of the
+        // running servers is aggregated and the other servers are
+        // reported as unreachable.
+        //
+        IceGrid::ApplicationInfo info = admin->getApplicationInfo("Test");
+        IceGrid::ApplicationDescriptor metricsApp;
+        metricsApp.name = "MetricsApp";
+        metricsApp.serverTemplates = info.descriptor.serverTemplates;
+        metricsApp.variables = info.descriptor.variables;
+        const int nServers = 3;
+        for(int i = 0; i < nServers; ++i)
+        {
+            ostringstream id;
+            id << "metrics-" << i;
+            IceGrid::ServerInstanceDescriptor server;
+            server._cpp_template = "Server";
+            server.parameterValues["id"] = id.str();
+            server.parameterValues["activation"] = "manual";
+            IceGrid::PropertyDescriptor prop;
+            prop.name = "IceMX.Metrics.View.Map.Dispatch.GroupBy";
+            prop.value = "id";
+            server.propertySet.properties.push_back(prop);
+            metricsApp.nodes["localnode"].serverInstances.push_back(server);
+        }
+        admin->addApplication(metricsApp);
+
+        //
+        // Only the first two servers are started, the last one is
+        // inactive and can't provide its view.
+        //
+        Ice::StringSeq running;
+        running.push_back("metrics-0");
+        running.push_back("metrics-1");
+        for(Ice::StringSeq::const_iterator p = running.begin(); p != running.end(); ++p)
+        {
+            admin->startServer(*p);
+            communicator->stringToProxy(*p)->ice_ping();
+        }
+
+        for(int timeout = 0; timeout <= 5000; timeout += 5000)
+        {
+            unreachable.clear();
+            view = admin->getAllServerMetricsViews("View", timeout, unreachable);
+            test(view.size() == 1 && view.find("Dispatch") != view.end());
+            IceGrid::ServerMetricsMapSeq& maps = view["Dispatch"];
+            test(maps.size() == running.size());
+            Ice::StringSeq viewIds;
+            for(IceGrid::ServerMetricsMapSeq::const_iterator p = maps.begin(); p != maps.end(); ++p)
+            {
+                test(!p->map.empty());
+                viewIds.push_back(p->id);
+            }
+            sort(viewIds.begin(), viewIds.end());
+            test(viewIds == running);
+
+            ids = admin->getAllServerIds();
+            test(unreachable.size() + running.size() == ids.size());
+            test(find(unreachable.begin(), unreachable.end(), "metrics-2") != unreachable.end());
+            for(Ice::StringSeq::const_iterator p = running.begin(); p != running.end(); ++p)
+            {
+                test(find(unreachable.begin(), unreachable.end(), *p) == unreachable.end());
+            }
+        }
+
+        for(Ice::StringSeq::const_iterator p = running.begin(); p != running.end(); ++p)
+        {
+            admin->stopServer(*p);
+        }
+        admin->removeApplication("MetricsApp");
+    }
+    cout << "ok" << endl;
+
     admin->stopServer("node-1");
     admin->stopServer("node-2");
 
@@ -16,6 +16,137 @@
 using namespace std;
 using namespace Test;
 
+namespace
+{
+
+//
+// Records the number of adapters registered by each batch registration
+// from the locator traces.
+//
+class LoggerI : public Ice::Logger, private IceUtil::Mutex
+{
+public:
+
+    virtual void
+    print(const string& message)
+    {
+        cout << message << endl;
+    }
+
+    virtual void
+    trace(const string& category, const string& message)
+    {
+        const string prefix = "updated the endpoints of ";
+        if(category == "Locator" && message.find(prefix) == 0)
+        {
+            istringstream is(message.substr(prefix.size()));
+            int count = 0;
+            is >> count;
+
+            Lock sync(*this);
+            _batches.push_back(count);
+        }
+    }
+
+    virtual void
+    warning(const string& message)
+    {
+        cout << "warning: " << message << endl;
+    }
+
+    virtual void
+    error(const string& message)
+    {
+        cout << "error: " << message << endl;
+    }
+
+    virtual string
+    getPrefix()
+    {
+        return "";
+    }
+
+    virtual Ice::LoggerPtr
+    cloneWithPrefix(const string&)
+    {
+        return this;
+    }
+
+    vector<int>
+    getBatches()
+    {
+        Lock sync(*this);
+        vector<int> batches;
+        batches.swap(_batches);
+        return batches;
+    }
+
+private:
+
+    vector<int> _batches;
+};
+typedef IceUtil::Handle<LoggerI> LoggerIPtr;
+
+class DynamicTestI : public TestIntf
+{
+public:
+
+    virtual void
+    shutdown(const Ice::Current&)
+    {
+    }
+};
+
+//
+// Activates or deactivates an object adapter, which registers its
+// endpoints with the locator registry or clears them.
+//
+class AdapterThread : public IceUtil::Thread
+{
+public:
+
+    AdapterThread(const Ice::ObjectAdapterPtr& adapter, bool activate) :
+        _adapter(adapter),
+        _activate(activate)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        if(_activate)
+        {
+            _adapter->activate();
+        }
+        else
+        {
+            _adapter->deactivate();
+        }
+    }
+
+private:
+
+    const Ice::ObjectAdapterPtr _adapter;
+    const bool _activate;
+};
+
+void
+runAdapterThreads(const vector<Ice::ObjectAdapterPtr>& adapters, bool activate)
+{
+    vector<IceUtil::ThreadControl> threads;
+    for(vector<Ice::ObjectAdapterPtr>::const_iterator p = adapters.begin(); p != adapters.end(); ++p)
+    {
+        IceUtil::ThreadPtr thread = new AdapterThread(*p, activate);
+        threads.push_back(thread->start());
+    }
+    for(vector<IceUtil::ThreadControl>::iterator p = threads.begin(); p != threads.end(); ++p)
+    {
+        p->join();
+    }
+}
+
+}
+
 void
 allTests(const Ice::CommunicatorPtr& communicator)
 {
@@ -144,6 +275,84 @@ allTests(const Ice::CommunicatorPtr& communicator)
         com->destroy();
         cout << "failed (is a firewall enabled?)" << endl;
     }
+    cout << "testing concurrent registration of dynamic adapters... " << flush;
+    {
+        //
+        // The adapters activated or deactivated within the registration
+        // window are registered together with setAdapterDirectProxies.
+        // The master registry writes them with a single database
+        // transaction, use its locator.
+        //
+        Ice::LocatorPrx locator = communicator->getDefaultLocator();
+        locator = locator->ice_endpoints(Ice::EndpointSeq(1, locator->ice_getEndpoints()[0]));
+
+        LoggerIPtr logger = new LoggerI();
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.Default.Locator", communicator->proxyToString(locator));
+        initData.properties->setProperty("Ice.LocatorRegistrationWindow", "1000");
+        initData.properties->setProperty("Ice.Trace.Locator", "1");
+        initData.logger = logger;
+        Ice::CommunicatorPtr dynamicCom = Ice::initialize(initData);
+
+        const int count = 10;
+        vector<string> adapterIds;
+        vector<Ice::ObjectAdapterPtr> adapters;
+        for(int i = 0; i < count; ++i)
+        {
+            ostringstream os;
+            os << "DynamicAdapter" << i;
+            string name = os.str();
+            dynamicCom->getProperties()->setProperty(name + ".AdapterId", name);
+            dynamicCom->getProperties()->setProperty(name + ".Endpoints", "default");
+            if(i % 2)
+            {
+                dynamicCom->getProperties()->setProperty(name + ".ReplicaGroupId", "DynamicReplicaGroup");
+            }
+            Ice::ObjectAdapterPtr adapter = dynamicCom->createObjectAdapter(name);
+            adapter->add(new DynamicTestI(), Ice::stringToIdentity("dynamic"));
+            adapterIds.push_back(name);
+            adapters.push_back(adapter);
+        }
+
+        runAdapterThreads(adapters, true);
+        test(logger->getBatches() == vector<int>(1, count));
+
+        IceGrid::RegistryPrx registry = IceGrid::RegistryPrx::checkedCast(
+            communicator->stringToProxy(locator->ice_getIdentity().category + "/Registry"));
+        test(registry);
+        IceGrid::AdminSessionPrx session = registry->createAdminSession("foo", "bar");
+        IceGrid::AdminPrx admin = session->getAdmin();
+
+        for(vector<string>::const_iterator p = adapterIds.begin(); p != adapterIds.end(); ++p)
+        {
+            communicator->stringToProxy("dynamic @ " + *p)->ice_ping();
+            IceGrid::AdapterInfoSeq infos = admin->getAdapterInfo(*p);
+            test(infos.size() == 1 && infos[0].id == *p && infos[0].proxy);
+        }
+        test(admin->getAdapterInfo("DynamicReplicaGroup").size() == static_cast<size_t>(count / 2));
+        communicator->stringToProxy("dynamic @ DynamicReplicaGroup")->ice_ping();
+
+        runAdapterThreads(adapters, false);
+        test(logger->getBatches() == vector<int>(1, count));
+
+        for(vector<string>::const_iterator p = adapterIds.begin(); p != adapterIds.end(); ++p)
+        {
+            try
+            {
+                admin->getAdapterInfo(*p);
+                test(false);
+            }
+            catch(const IceGrid::AdapterNotExistException&)
+            {
+            }
+        }
+
+        session->destroy();
+        dynamicCom->destroy();
+    }
+    cout << "ok" << endl;
+
     cout << "shutting down server... " << flush;
     obj->shutdown();
     cout << "ok" << endl;
@@ -8,6 +8,7 @@
 // **********************************************************************
 
 #include <IceUtil/Thread.h>
+#include <IceUtil/Monitor.h>
 #include <Ice/Ice.h>
 #include <IceGrid/IceGrid.h>
 #include <TestCommon.h>
@@ -62,6 +63,311 @@ hasProperty(const CommunicatorDescriptorPtr& desc, const string& name, const str
     return false;
 }
 
+class ServerStateObserverI : public NodeObserver, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    virtual void
+    nodeInit(const NodeDynamicInfoSeq& nodes, const Ice::Current&)
+    {
+        for(NodeDynamicInfoSeq::const_iterator p = nodes.begin(); p != nodes.end(); ++p)
+        {
+            for(ServerDynamicInfoSeq::const_iterator q = p->servers.begin(); q != p->servers.end(); ++q)
+            {
+                update(p->info.name, *q);
+            }
+        }
+    }
+
+    virtual void
+    nodeUp(const NodeDynamicInfo& node, const Ice::Current&)
+    {
+        for(ServerDynamicInfoSeq::const_iterator q = node.servers.begin(); q != node.servers.end(); ++q)
+        {
+            update(node.info.name, *q);
+        }
+    }
+
+    virtual void
+    nodeDown(const string&, const Ice::Current&)
+    {
+    }
+
+    virtual void
+    updateServer(const string& node, const ServerDynamicInfo& info, const Ice::Current&)
+    {
+        update(node, info);
+    }
+
+    virtual void
+    updateAdapter(const string&, const AdapterDynamicInfo&, const Ice::Current&)
+    {
+    }
+
+    void
+    reset()
+    {
+        Lock sync(*this);
+        _maxInactive.clear();
+    }
+
+    int
+    maxInactive(const string& node)
+    {
+        Lock sync(*this);
+        return _maxInactive[node];
+    }
+
+    void
+    waitForActive(int count)
+    {
+        Lock sync(*this);
+        IceUtil::Time deadline = IceUtil::Time::now(IceUtil::Time::Monotonic) + IceUtil::Time::seconds(60);
+        while(true)
+        {
+            int active = 0;
+            for(map<string, pair<string, ServerState> >::const_iterator p = _servers.begin(); p != _servers.end(); ++p)
+            {
+                if(p->second.second == Active)
+                {
+                    ++active;
+                }
+            }
+            if(active == count)
+            {
+                return;
+            }
+            IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+            test(now < deadline);
+            timedWait(deadline - now);
+        }
+    }
+
+private:
+
+    void
+    update(const string& node, const ServerDynamicInfo& info)
+    {
+        if(info.id.find("Rolling") != 0)
+        {
+            return;
+        }
+
+        Lock sync(*this);
+        _servers[info.id] = make_pair(node, info.state);
+
+        int inactive = 0;
+        for(map<string, pair<string, ServerState> >::const_iterator p = _servers.begin(); p != _servers.end(); ++p)
+        {
+            if(p->second.first == node && p->second.second != Active)
+            {
+                ++inactive;
+            }
+        }
+        _maxInactive[node] = max(_maxInactive[node], inactive);
+        notifyAll();
+    }
+
+    map<string, pair<string, ServerState> > _servers;
+    map<string, int> _maxInactive;
+};
+typedef IceUtil::Handle<ServerStateObserverI> ServerStateObserverIPtr;
+
+void
+rollingUpdateTests(const Ice::CommunicatorPtr& communicator, const RegistryPrx& registry,
+                   const AdminSessionPrx& session, const AdminPrx& admin)
+{
+    Ice::PropertiesPtr properties = communicator->getProperties();
+
+    //
+    // The registry is started with IceGrid.Registry.RollingUpdate.NodeConcurrency=1
+    // and IceGrid.Registry.RollingUpdate.HealthCheck=1.
+    //
+    cout << "testing rolling update... " << flush;
+
+    ApplicationDescriptor nodeApp;
+    nodeApp.name = "NodeApp";
+
+    ServerDescriptorPtr server = new ServerDescriptor();
+    server->id = "node-${index}";
+    server->exe = properties->getProperty("IceBinDir") + "/icegridnode";
+    server->pwd = ".";
+    server->applicationDistrib = false;
+    server->allocatable = false;
+    server->options.push_back("--nowarn");
+
+    addProperty(server, "IceGrid.Node.Name", "node-${index}");
+    addProperty(server, "IceGrid.Node.Data", properties->getProperty("TestDir") + "/db/node-${index}");
+    addProperty(server, "IceGrid.Node.Endpoints", "default");
+    addProperty(server, "IceGrid.Node.PropertiesOverride", properties->getProperty("NodePropertiesOverride"));
+    addProperty(server, "Ice.Admin.Endpoints", "tcp -h 127.0.0.1");
+
+    nodeApp.serverTemplates["nodeTemplate"].descriptor = server;
+    nodeApp.serverTemplates["nodeTemplate"].parameters.push_back("index");
+
+    ServerInstanceDescriptor instance;
+    instance._cpp_template = "nodeTemplate";
+    instance.parameterValues["index"] = "1";
+    nodeApp.nodes["localnode"].serverInstances.push_back(instance);
+    instance.parameterValues["index"] = "2";
+    nodeApp.nodes["localnode"].serverInstances.push_back(instance);
+
+    admin->addApplication(nodeApp);
+    admin->startServer("node-1");
+    admin->startServer("node-2");
+
+    int retry = 0;
+    while(retry < 20)
+    {
+        try
+        {
+            if(admin->pingNode("node-1") && admin->pingNode("node-2"))
+            {
+                break;
+            }
+        }
+        catch(const NodeNotExistException&)
+        {
+        }
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(500));
+        ++retry;
+    }
+    test(admin->pingNode("node-1"));
+    test(admin->pingNode("node-2"));
+
+    Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("");
+    ServerStateObserverIPtr observer = new ServerStateObserverI();
+    Ice::ObjectPrx obs = adapter->addWithUUID(observer);
+    adapter->activate();
+    registry->ice_getConnection()->setAdapter(adapter);
+    session->setObserversByIdentity(Ice::Identity(), obs->ice_getIdentity(), Ice::Identity(), Ice::Identity(),
+                                    Ice::Identity());
+
+    //
+    // Three servers on node-1 and two servers on node-2, they are all
+    // restarted when the version variable is updated.
+    //
+    ApplicationDescriptor testApp;
+    testApp.name = "RollingApp";
+    testApp.variables["exe"] = properties->getProperty("ServerDir") + "/server";
+    testApp.variables["version"] = "1";
+
+    server = new ServerDescriptor();
+    server->id = "Rolling${index}";
+    server->exe = "${exe}";
+    server->pwd = ".";
+    server->applicationDistrib = false;
+    server->allocatable = false;
+    server->activation = "always";
+    server->activationTimeout = "5";
+    server->deactivationTimeout = "5";
+    addProperty(server, "Ice.Admin.Endpoints", "tcp -h 127.0.0.1");
+    addProperty(server, "Test.Version", "${version}");
+    AdapterDescriptor adapterDesc;
+    adapterDesc.name = "Server";
+    adapterDesc.id = "Rolling${index}Adapter";
+    adapterDesc.registerProcess = false;
+    adapterDesc.serverLifetime = true;
+    server->adapters.push_back(adapterDesc);
+    addProperty(server, "Server.Endpoints", "default");
+
+    testApp.serverTemplates["rollingTemplate"].descriptor = server;
+    testApp.serverTemplates["rollingTemplate"].parameters.push_back("index");
+    for(int i = 1; i <= 5; ++i)
+    {
+        ostringstream os;
+        os << i;
+        instance._cpp_template = "rollingTemplate";
+        instance.parameterValues["index"] = os.str();
+        testApp.nodes[i <= 3 ? "node-1" : "node-2"].serverInstances.push_back(instance);
+    }
+
+    try
+    {
+        admin->addApplication(testApp);
+    }
+    catch(const DeploymentException& ex)
+    {
+        cerr << ex.reason << endl;
+        test(false);
+    }
+    observer->waitForActive(5);
+
+    //
+    // Update all the servers, the servers of a node are restarted one
+    // at a time and each server holds its slot until it's active again.
+    //
+    observer->reset();
+    ApplicationUpdateDescriptor update;
+    update.name = "RollingApp";
+    update.variables["version"] = "2";
+    try
+    {
+        admin->updateApplication(update);
+    }
+    catch(const DeploymentException& ex)
+    {
+        cerr << ex.reason << endl;
+        test(false);
+    }
+    for(int i = 1; i <= 5; ++i)
+    {
+        ostringstream os;
+        os << "Rolling" << i;
+        test(admin->getServerState(os.str()) == Active);
+        test(getProperty(admin->getServerInfo(os.str()).descriptor->propertySet.properties, "Test.Version") == "2");
+    }
+    observer->waitForActive(5);
+    test(observer->maxInactive("node-1") == 1);
+    test(observer->maxInactive("node-2") == 1);
+
+    //
+    // Update the servers with an executable which doesn't exist. The
+    // first server of each node isn't activated again, the update fails
+    // and the application is rolled back.
+    //
+    update = ApplicationUpdateDescriptor();
+    update.name = "RollingApp";
+    update.variables["exe"] = properties->getProperty("ServerDir") + "/unknownexe";
+    update.variables["version"] = "3";
+    try
+    {
+        admin->updateApplication(update);
+        test(false);
+    }
+    catch(const DeploymentException&)
+    {
+    }
+
+    ApplicationInfo info = admin->getApplicationInfo("RollingApp");
+    test(info.descriptor.variables["exe"] == testApp.variables["exe"]);
+    test(info.descriptor.variables["version"] == "2");
+    observer->waitForActive(5);
+    for(int i = 1; i <= 5; ++i)
+    {
+        ostringstream os;
+        os << "Rolling" << i;
+        test(admin->getServerState(os.str()) == Active);
+        test(getProperty(admin->getServerInfo(os.str()).descriptor->propertySet.properties, "Test.Version") == "2");
+    }
+
+    try
+    {
+        admin->removeApplication("RollingApp");
+    }
+    catch(const DeploymentException& ex)
+    {
+        cerr << ex.reason << endl;
+        test(false);
+    }
+
+    admin->stopServer("node-1");
+    admin->stopServer("node-2");
+    admin->removeApplication("NodeApp");
+
+    cout << "ok" << endl;
+}
+
 void
 allTests(const Ice::CommunicatorPtr& communicator)
 {
@@ -77,6 +383,13 @@ allTests(const Ice::CommunicatorPtr& communicator)
 
     Ice::PropertiesPtr properties = communicator->getProperties();
 
+    if(properties->getPropertyAsInt("RollingUpdate") > 0)
+    {
+        rollingUpdateTests(communicator, registry, session, admin);
+        session->destroy();
+        return;
+    }
+
     {
         ApplicationDescriptor testApp;
         testApp.name = "TestApp";
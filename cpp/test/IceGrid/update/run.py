@@ -22,17 +22,13 @@ import TestUtil, IceGridAdmin
 
 name = os.path.join("IceGrid", "update")
 
-node1Dir = os.path.join(os.getcwd(), "db", "node-1")
-if not os.path.exists(node1Dir):
-    os.mkdir(node1Dir)
-else:
-    IceGridAdmin.cleanDbDir(node1Dir)
-
-node2Dir = os.path.join(os.getcwd(), "db", "node-2")
-if not os.path.exists(node2Dir):
-    os.mkdir(node2Dir)
-else:
-    IceGridAdmin.cleanDbDir(node2Dir)
+def cleanNodeDirs():
+    for node in ["node-1", "node-2"]:
+        nodeDir = os.path.join(os.getcwd(), "db", node)
+        if not os.path.exists(nodeDir):
+            os.mkdir(nodeDir)
+        else:
+            IceGridAdmin.cleanDbDir(nodeDir)
 
 bindir = TestUtil.getCppBinDir()
 testdir = os.getcwd()
@@ -42,4 +38,11 @@ nodeOverrideOptions = '--IceBinDir="%s" --TestDir="%s" --ServerDir="%s" ' % (bin
     '--NodePropertiesOverride=\"%s Ice.ServerIdleTime=0 Ice.PrintProcessId=0 Ice.PrintAdapterReady=0\"' % \
     IceGridAdmin.iceGridNodePropertiesOverride()
 
+cleanNodeDirs()
 IceGridAdmin.iceGridTest("", nodeOverrideOptions)
+
+print("testing with rolling updates")
+cleanNodeDirs()
+IceGridAdmin.iceGridTest("", nodeOverrideOptions + " --RollingUpdate=1", "",
+                         "--IceGrid.Registry.RollingUpdate.NodeConcurrency=1 " +
+                         "--IceGrid.Registry.RollingUpdate.HealthCheck=1")
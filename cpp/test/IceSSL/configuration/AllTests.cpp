@@ -382,6 +382,72 @@ private:
 };
 ICE_DEFINE_PTR(CertificateVerifierIPtr, CertificateVerifierI);
 
+//
+// Counts the connections verified with the cached verification of
+// the peer certificate, traced with IceSSL.Trace.Security=2.
+//
+class VerifyCacheLoggerI : public Ice::Logger,
+                           private IceUtil::Mutex
+#ifdef ICE_CPP11_MAPPING
+                         , public std::enable_shared_from_this<VerifyCacheLoggerI>
+#endif
+{
+public:
+
+    VerifyCacheLoggerI() : _cached(0)
+    {
+    }
+
+    virtual void
+    print(const string&)
+    {
+    }
+
+    virtual void
+    trace(const string&, const string& message)
+    {
+        Lock sync(*this);
+        if(message.find("using cached verification") != string::npos)
+        {
+            ++_cached;
+        }
+    }
+
+    virtual void
+    warning(const string&)
+    {
+    }
+
+    virtual void
+    error(const string&)
+    {
+    }
+
+    virtual string
+    getPrefix()
+    {
+        return "";
+    }
+
+    virtual Ice::LoggerPtr
+    cloneWithPrefix(const string&)
+    {
+        return ICE_SHARED_FROM_THIS;
+    }
+
+    int
+    cached()
+    {
+        Lock sync(*this);
+        return _cached;
+    }
+
+private:
+
+    int _cached;
+};
+ICE_DEFINE_PTR(VerifyCacheLoggerIPtr, VerifyCacheLoggerI);
+
 int keychainN = 0;
 
 static PropertiesPtr
@@ -1456,6 +1522,63 @@ allTests(const CommunicatorPtr& communicator, const string& testDir, bool p12)
     cout << "ok" << endl;
 
 
+#if !defined(__APPLE__) || TARGET_OS_IPHONE == 0
+    cout << "testing verification cache... " << flush;
+    {
+        //
+        // The cache holds a single entry, the entry of a certificate
+        // expires when another certificate is verified.
+        //
+        InitializationData initData;
+        initData.properties = createClientProps(defaultProps, defaultDir, defaultHost, p12, "c_rsa_ca1", "cacerts");
+        initData.properties->setProperty("IceSSL.Trace.Security", "2");
+        initData.properties->setProperty("IceSSL.VerifyCacheSize", "1");
+        VerifyCacheLoggerIPtr logger = ICE_MAKE_SHARED(VerifyCacheLoggerI);
+        initData.logger = logger;
+        CommunicatorPtr comm = initialize(initData);
+
+        Test::ServerFactoryPrxPtr fact = ICE_CHECKED_CAST(Test::ServerFactoryPrx, comm->stringToProxy(factoryRef));
+        test(fact);
+        Test::ServerPrxPtr server1 =
+            fact->createServer(createServerProps(defaultProps, defaultDir, defaultHost, p12, "s_rsa_ca1", "cacerts"));
+        Test::ServerPrxPtr server2 =
+            fact->createServer(createServerProps(defaultProps, defaultDir, defaultHost, p12, "s_rsa_ca2", "cacerts"));
+
+        //
+        // A new connection to the same server reuses the cached
+        // verification of its certificate.
+        //
+        server1->ice_ping();
+        test(logger->cached() == 0);
+        server1->ice_getConnection()->close(false);
+        server1->ice_ping();
+        test(logger->cached() == 1);
+
+        //
+        // A server with another certificate isn't verified with the
+        // cached verification of the first certificate.
+        //
+        server2->ice_ping();
+        test(logger->cached() == 1);
+        server2->ice_getConnection()->close(false);
+        server2->ice_ping();
+        test(logger->cached() == 2);
+
+        //
+        // The cached verification of the first certificate expired
+        // when the second certificate was verified.
+        //
+        server1->ice_getConnection()->close(false);
+        server1->ice_ping();
+        test(logger->cached() == 2);
+
+        fact->destroyServer(server1);
+        fact->destroyServer(server2);
+        comm->destroy();
+    }
+    cout << "ok" << endl;
+#endif
+
     cout << "testing protocols... " << flush;
     {
 #ifndef ICE_USE_SECURE_TRANSPORT
@@ -283,6 +283,47 @@ sys.stdout.flush()
 runtest("twoway", icestorm.reference(), pubopt=" --cycle")
 print("ok")
 
+sys.stdout.write("testing updates with a majority of replicas... ")
+sys.stdout.flush()
+icestorm.stopReplica(0)
+
+icestorm.admin("create majority")
+
+for replica in range(1, 3):
+    icestorm.adminForReplica(replica, "create majority", "error: topic `majority' exists")
+
+icestorm.admin("destroy majority")
+
+for replica in range(1, 3):
+    icestorm.adminForReplica(replica, "destroy majority", "error: couldn't find topic `majority'")
+print("ok")
+
+sys.stdout.write("testing updates without a majority of replicas... ")
+sys.stdout.flush()
+icestorm.stopReplica(1)
+
+#
+# The remaining replica can't commit the update without a majority,
+# the update stalls until the invocation times out.
+#
+icestorm.adminWithRef(icestorm.reference(2) + " --Ice.Default.InvocationTimeout=5000", "create nomajority",
+                      "InvocationTimeoutException")
+
+#
+# The updates commit again once the majority is back.
+#
+icestorm.startReplica(1, echo=False)
+
+icestorm.admin("create majority")
+
+for replica in range(1, 3):
+    icestorm.adminForReplica(replica, "create majority", "error: topic `majority' exists")
+
+icestorm.startReplica(0, echo=False)
+
+icestorm.adminForReplica(0, "create majority", "error: topic `majority' exists")
+print("ok")
+
 sys.stdout.write("stopping replicas... ")
 sys.stdout.flush()
 icestorm.stop()
@@ -38,11 +38,12 @@ public:
             cerr << endl << "expected oneway request";
             test(false);
         }
-        else if((_name == "twoway" || _name == "twoway ordered") && current.requestId == 0)
+        else if((_name == "twoway" || _name == "twoway ordered" || _name == "twoway ordered window") &&
+                current.requestId == 0)
         {
             cerr << endl << "expected twoway request";
         }
-        if(_name == "twoway ordered" && i != _last)
+        if((_name == "twoway ordered" || _name == "twoway ordered window") && i != _last)
         {
             cerr << endl << "received unordered event for `" << _name << "': " << i << " " << _last;
             test(false);
@@ -203,6 +204,15 @@ run(int, char* argv[], const CommunicatorPtr& communicator)
         subscriberIdentities.push_back(object->ice_getIdentity());
         topic->subscribeAndGetPublisher(qos, object);
     }
+    {
+        subscribers.push_back(new SingleI(communicator, "twoway ordered window")); // Ordered with a window
+        IceStorm::QoS qos;
+        qos["reliability"] = "ordered";
+        qos["window"] = "10";
+        Ice::ObjectPrx object = adapter->addWithUUID(subscribers.back());
+        subscriberIdentities.push_back(object->ice_getIdentity());
+        topic->subscribeAndGetPublisher(qos, object);
+    }
     {
         // Use a separate adapter to ensure a separate connection is used for the subscriber
         // (otherwise, if multiple UDP subscribers use the same connection we might get high
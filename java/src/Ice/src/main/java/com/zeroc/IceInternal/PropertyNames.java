@@ -59,6 +59,8 @@ public final class PropertyNames
         new Property("Ice\\.Admin\\.Router\\.Context\\.[^\\s]+", false, null),
         new Property("Ice\\.Admin\\.Router", false, null),
         new Property("Ice\\.Admin\\.ProxyOptions", false, null),
+        new Property("Ice\\.Admin\\.ThreadPool\\.Adaptive", false, null),
+        new Property("Ice\\.Admin\\.ThreadPool\\.CallerRuns", false, null),
         new Property("Ice\\.Admin\\.ThreadPool\\.Size", false, null),
         new Property("Ice\\.Admin\\.ThreadPool\\.SizeMax", false, null),
         new Property("Ice\\.Admin\\.ThreadPool\\.SizeWarn", false, null),
@@ -79,8 +81,13 @@ public final class PropertyNames
         new Property("Ice\\.BatchAutoFlush", true, null),
         new Property("Ice\\.BatchAutoFlushSize", false, null),
         new Property("Ice\\.ChangeUser", false, null),
+        new Property("Ice\\.CircuitBreaker\\.Threshold", false, null),
+        new Property("Ice\\.CircuitBreaker\\.Timeout", false, null),
         new Property("Ice\\.ClientAccessPolicyProtocol", false, null),
+        new Property("Ice\\.Compression\\.Adaptive", false, null),
+        new Property("Ice\\.Compression\\.Auto", false, null),
         new Property("Ice\\.Compression\\.Level", false, null),
+        new Property("Ice\\.Compression\\.MaxRatio", false, null),
         new Property("Ice\\.CollectObjects", false, null),
         new Property("Ice\\.Config", false, null),
         new Property("Ice\\.ConsoleListener", false, null),
@@ -124,6 +131,8 @@ public final class PropertyNames
         new Property("Ice\\.InitPlugins", false, null),
         new Property("Ice\\.IPv4", false, null),
         new Property("Ice\\.IPv6", false, null),
+        new Property("Ice\\.LocatorCacheFile", false, null),
+        new Property("Ice\\.LocatorRegistrationWindow", false, null),
         new Property("Ice\\.LogFile", false, null),
         new Property("Ice\\.LogFile\\.SizeMax", false, null),
         new Property("Ice\\.LogStdErr\\.Convert", false, null),
@@ -143,13 +152,18 @@ public final class PropertyNames
         new Property("Ice\\.PrintProcessId", false, null),
         new Property("Ice\\.PrintStackTraces", false, null),
         new Property("Ice\\.ProgramName", false, null),
+        new Property("Ice\\.RetryBudget", false, null),
+        new Property("Ice\\.RetryBudget\\.Reserve", false, null),
         new Property("Ice\\.RetryIntervals", false, null),
+        new Property("Ice\\.RetryJitter", false, null),
         new Property("Ice\\.ServerIdleTime", false, null),
         new Property("Ice\\.SOCKSProxyHost", false, null),
         new Property("Ice\\.SOCKSProxyPort", false, null),
         new Property("Ice\\.StdErr", false, null),
         new Property("Ice\\.StdOut", false, null),
         new Property("Ice\\.SyslogFacility", false, null),
+        new Property("Ice\\.ThreadPool\\.Client\\.Adaptive", false, null),
+        new Property("Ice\\.ThreadPool\\.Client\\.CallerRuns", false, null),
         new Property("Ice\\.ThreadPool\\.Client\\.Size", false, null),
         new Property("Ice\\.ThreadPool\\.Client\\.SizeMax", false, null),
         new Property("Ice\\.ThreadPool\\.Client\\.SizeWarn", false, null),
@@ -157,6 +171,8 @@ public final class PropertyNames
         new Property("Ice\\.ThreadPool\\.Client\\.Serialize", false, null),
         new Property("Ice\\.ThreadPool\\.Client\\.ThreadIdleTime", false, null),
         new Property("Ice\\.ThreadPool\\.Client\\.ThreadPriority", false, null),
+        new Property("Ice\\.ThreadPool\\.Server\\.Adaptive", false, null),
+        new Property("Ice\\.ThreadPool\\.Server\\.CallerRuns", false, null),
         new Property("Ice\\.ThreadPool\\.Server\\.Size", false, null),
         new Property("Ice\\.ThreadPool\\.Server\\.SizeMax", false, null),
         new Property("Ice\\.ThreadPool\\.Server\\.SizeWarn", false, null),
@@ -235,6 +251,8 @@ public final class PropertyNames
         new Property("IceDiscovery\\.Multicast\\.Router\\.Context\\.[^\\s]+", false, null),
         new Property("IceDiscovery\\.Multicast\\.Router", false, null),
         new Property("IceDiscovery\\.Multicast\\.ProxyOptions", false, null),
+        new Property("IceDiscovery\\.Multicast\\.ThreadPool\\.Adaptive", false, null),
+        new Property("IceDiscovery\\.Multicast\\.ThreadPool\\.CallerRuns", false, null),
         new Property("IceDiscovery\\.Multicast\\.ThreadPool\\.Size", false, null),
         new Property("IceDiscovery\\.Multicast\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceDiscovery\\.Multicast\\.ThreadPool\\.SizeWarn", false, null),
@@ -272,6 +290,8 @@ public final class PropertyNames
         new Property("IceDiscovery\\.Reply\\.Router\\.Context\\.[^\\s]+", false, null),
         new Property("IceDiscovery\\.Reply\\.Router", false, null),
         new Property("IceDiscovery\\.Reply\\.ProxyOptions", false, null),
+        new Property("IceDiscovery\\.Reply\\.ThreadPool\\.Adaptive", false, null),
+        new Property("IceDiscovery\\.Reply\\.ThreadPool\\.CallerRuns", false, null),
         new Property("IceDiscovery\\.Reply\\.ThreadPool\\.Size", false, null),
         new Property("IceDiscovery\\.Reply\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceDiscovery\\.Reply\\.ThreadPool\\.SizeWarn", false, null),
@@ -309,6 +329,8 @@ public final class PropertyNames
         new Property("IceDiscovery\\.Locator\\.Router\\.Context\\.[^\\s]+", false, null),
         new Property("IceDiscovery\\.Locator\\.Router", false, null),
         new Property("IceDiscovery\\.Locator\\.ProxyOptions", false, null),
+        new Property("IceDiscovery\\.Locator\\.ThreadPool\\.Adaptive", false, null),
+        new Property("IceDiscovery\\.Locator\\.ThreadPool\\.CallerRuns", false, null),
         new Property("IceDiscovery\\.Locator\\.ThreadPool\\.Size", false, null),
         new Property("IceDiscovery\\.Locator\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceDiscovery\\.Locator\\.ThreadPool\\.SizeWarn", false, null),
@@ -359,6 +381,8 @@ public final class PropertyNames
         new Property("IceGridDiscovery\\.Reply\\.Router\\.Context\\.[^\\s]+", false, null),
         new Property("IceGridDiscovery\\.Reply\\.Router", false, null),
         new Property("IceGridDiscovery\\.Reply\\.ProxyOptions", false, null),
+        new Property("IceGridDiscovery\\.Reply\\.ThreadPool\\.Adaptive", false, null),
+        new Property("IceGridDiscovery\\.Reply\\.ThreadPool\\.CallerRuns", false, null),
         new Property("IceGridDiscovery\\.Reply\\.ThreadPool\\.Size", false, null),
         new Property("IceGridDiscovery\\.Reply\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceGridDiscovery\\.Reply\\.ThreadPool\\.SizeWarn", false, null),
@@ -396,6 +420,8 @@ public final class PropertyNames
         new Property("IceGridDiscovery\\.Locator\\.Router\\.Context\\.[^\\s]+", false, null),
         new Property("IceGridDiscovery\\.Locator\\.Router", false, null),
         new Property("IceGridDiscovery\\.Locator\\.ProxyOptions", false, null),
+        new Property("IceGridDiscovery\\.Locator\\.ThreadPool\\.Adaptive", false, null),
+        new Property("IceGridDiscovery\\.Locator\\.ThreadPool\\.CallerRuns", false, null),
         new Property("IceGridDiscovery\\.Locator\\.ThreadPool\\.Size", false, null),
         new Property("IceGridDiscovery\\.Locator\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceGridDiscovery\\.Locator\\.ThreadPool\\.SizeWarn", false, null),
@@ -434,6 +460,7 @@ public final class PropertyNames
         new Property("IceBox\\.ServiceManager\\.ThreadPool\\.StackSize", true, null),
         new Property("IceBox\\.Trace\\.ServiceObserver", false, null),
         new Property("IceBox\\.UseSharedCommunicator\\.[^\\s]+", false, null),
+        new Property("IceBox\\.UseSharedRuntime", false, null),
         null
     };
 
@@ -494,6 +521,8 @@ public final class PropertyNames
         new Property("IceGridAdmin\\.Discovery\\.Reply\\.Router\\.Context\\.[^\\s]+", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Reply\\.Router", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Reply\\.ProxyOptions", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Reply\\.ThreadPool\\.Adaptive", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Reply\\.ThreadPool\\.CallerRuns", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Reply\\.ThreadPool\\.Size", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Reply\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Reply\\.ThreadPool\\.SizeWarn", false, null),
@@ -538,6 +567,8 @@ public final class PropertyNames
         new Property("IceGrid\\.AdminRouter\\.Router\\.Context\\.[^\\s]+", false, null),
         new Property("IceGrid\\.AdminRouter\\.Router", false, null),
         new Property("IceGrid\\.AdminRouter\\.ProxyOptions", false, null),
+        new Property("IceGrid\\.AdminRouter\\.ThreadPool\\.Adaptive", false, null),
+        new Property("IceGrid\\.AdminRouter\\.ThreadPool\\.CallerRuns", false, null),
         new Property("IceGrid\\.AdminRouter\\.ThreadPool\\.Size", false, null),
         new Property("IceGrid\\.AdminRouter\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceGrid\\.AdminRouter\\.ThreadPool\\.SizeWarn", false, null),
@@ -576,6 +607,8 @@ public final class PropertyNames
         new Property("IceGrid\\.Node\\.Router\\.Context\\.[^\\s]+", false, null),
         new Property("IceGrid\\.Node\\.Router", false, null),
         new Property("IceGrid\\.Node\\.ProxyOptions", false, null),
+        new Property("IceGrid\\.Node\\.ThreadPool\\.Adaptive", false, null),
+        new Property("IceGrid\\.Node\\.ThreadPool\\.CallerRuns", false, null),
         new Property("IceGrid\\.Node\\.ThreadPool\\.Size", false, null),
         new Property("IceGrid\\.Node\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceGrid\\.Node\\.ThreadPool\\.SizeWarn", false, null),
@@ -653,6 +686,8 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.AdminSessionManager\\.Router\\.Context\\.[^\\s]+", false, null),
         new Property("IceGrid\\.Registry\\.AdminSessionManager\\.Router", false, null),
         new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ProxyOptions", false, null),
+        new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ThreadPool\\.Adaptive", false, null),
+        new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ThreadPool\\.CallerRuns", false, null),
         new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ThreadPool\\.Size", false, null),
         new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ThreadPool\\.SizeWarn", false, null),
@@ -700,6 +735,8 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.Client\\.Router\\.Context\\.[^\\s]+", false, null),
         new Property("IceGrid\\.Registry\\.Client\\.Router", false, null),
         new Property("IceGrid\\.Registry\\.Client\\.ProxyOptions", false, null),
+        new Property("IceGrid\\.Registry\\.Client\\.ThreadPool\\.Adaptive", false, null),
+        new Property("IceGrid\\.Registry\\.Client\\.ThreadPool\\.CallerRuns", false, null),
         new Property("IceGrid\\.Registry\\.Client\\.ThreadPool\\.Size", false, null),
         new Property("IceGrid\\.Registry\\.Client\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceGrid\\.Registry\\.Client\\.ThreadPool\\.SizeWarn", false, null),
@@ -739,6 +776,8 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.Discovery\\.Router\\.Context\\.[^\\s]+", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.Router", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.ProxyOptions", false, null),
+        new Property("IceGrid\\.Registry\\.Discovery\\.ThreadPool\\.Adaptive", false, null),
+        new Property("IceGrid\\.Registry\\.Discovery\\.ThreadPool\\.CallerRuns", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.ThreadPool\\.Size", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.ThreadPool\\.SizeWarn", false, null),
@@ -781,6 +820,8 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.Internal\\.Router\\.Context\\.[^\\s]+", false, null),
         new Property("IceGrid\\.Registry\\.Internal\\.Router", false, null),
         new Property("IceGrid\\.Registry\\.Internal\\.ProxyOptions", false, null),
+        new Property("IceGrid\\.Registry\\.Internal\\.ThreadPool\\.Adaptive", false, null),
+        new Property("IceGrid\\.Registry\\.Internal\\.ThreadPool\\.CallerRuns", false, null),
         new Property("IceGrid\\.Registry\\.Internal\\.ThreadPool\\.Size", false, null),
         new Property("IceGrid\\.Registry\\.Internal\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceGrid\\.Registry\\.Internal\\.ThreadPool\\.SizeWarn", false, null),
@@ -804,6 +845,9 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.PermissionsVerifier", false, null),
         new Property("IceGrid\\.Registry\\.ReplicaName", false, null),
         new Property("IceGrid\\.Registry\\.ReplicaSessionTimeout", false, null),
+        new Property("IceGrid\\.Registry\\.RollingUpdate\\.HealthCheck", false, null),
+        new Property("IceGrid\\.Registry\\.RollingUpdate\\.NodeConcurrency", false, null),
+        new Property("IceGrid\\.Registry\\.RollingUpdate\\.ReplicaGroupConcurrency", false, null),
         new Property("IceGrid\\.Registry\\.RequireNodeCertCN", false, null),
         new Property("IceGrid\\.Registry\\.RequireReplicaCertCN", false, null),
         new Property("IceGrid\\.Registry\\.Server\\.ACM\\.Timeout", false, null),
@@ -835,6 +879,8 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.Server\\.Router\\.Context\\.[^\\s]+", false, null),
         new Property("IceGrid\\.Registry\\.Server\\.Router", false, null),
         new Property("IceGrid\\.Registry\\.Server\\.ProxyOptions", false, null),
+        new Property("IceGrid\\.Registry\\.Server\\.ThreadPool\\.Adaptive", false, null),
+        new Property("IceGrid\\.Registry\\.Server\\.ThreadPool\\.CallerRuns", false, null),
         new Property("IceGrid\\.Registry\\.Server\\.ThreadPool\\.Size", false, null),
         new Property("IceGrid\\.Registry\\.Server\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceGrid\\.Registry\\.Server\\.ThreadPool\\.SizeWarn", false, null),
@@ -873,6 +919,8 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.SessionManager\\.Router\\.Context\\.[^\\s]+", false, null),
         new Property("IceGrid\\.Registry\\.SessionManager\\.Router", false, null),
         new Property("IceGrid\\.Registry\\.SessionManager\\.ProxyOptions", false, null),
+        new Property("IceGrid\\.Registry\\.SessionManager\\.ThreadPool\\.Adaptive", false, null),
+        new Property("IceGrid\\.Registry\\.SessionManager\\.ThreadPool\\.CallerRuns", false, null),
         new Property("IceGrid\\.Registry\\.SessionManager\\.ThreadPool\\.Size", false, null),
         new Property("IceGrid\\.Registry\\.SessionManager\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceGrid\\.Registry\\.SessionManager\\.ThreadPool\\.SizeWarn", false, null),
@@ -939,6 +987,8 @@ public final class PropertyNames
         new Property("IcePatch2\\.Router\\.Context\\.[^\\s]+", false, null),
         new Property("IcePatch2\\.Router", false, null),
         new Property("IcePatch2\\.ProxyOptions", false, null),
+        new Property("IcePatch2\\.ThreadPool\\.Adaptive", false, null),
+        new Property("IcePatch2\\.ThreadPool\\.CallerRuns", false, null),
         new Property("IcePatch2\\.ThreadPool\\.Size", false, null),
         new Property("IcePatch2\\.ThreadPool\\.SizeMax", false, null),
         new Property("IcePatch2\\.ThreadPool\\.SizeWarn", false, null),
@@ -1004,6 +1054,7 @@ public final class PropertyNames
         new Property("IceSSL\\.TruststorePassword", false, null),
         new Property("IceSSL\\.TruststoreType", false, null),
         new Property("IceSSL\\.UsePlatformCAs", false, null),
+        new Property("IceSSL\\.VerifyCacheSize", false, null),
         new Property("IceSSL\\.VerifyDepthMax", false, null),
         new Property("IceSSL\\.VerifyPeer", false, null),
         null
@@ -1056,6 +1107,8 @@ public final class PropertyNames
         new Property("Glacier2\\.Client\\.Router\\.Context\\.[^\\s]+", false, null),
         new Property("Glacier2\\.Client\\.Router", false, null),
         new Property("Glacier2\\.Client\\.ProxyOptions", false, null),
+        new Property("Glacier2\\.Client\\.ThreadPool\\.Adaptive", false, null),
+        new Property("Glacier2\\.Client\\.ThreadPool\\.CallerRuns", false, null),
         new Property("Glacier2\\.Client\\.ThreadPool\\.Size", false, null),
         new Property("Glacier2\\.Client\\.ThreadPool\\.SizeMax", false, null),
         new Property("Glacier2\\.Client\\.ThreadPool\\.SizeWarn", false, null),
@@ -1067,10 +1120,22 @@ public final class PropertyNames
         new Property("Glacier2\\.Client\\.AlwaysBatch", false, null),
         new Property("Glacier2\\.Client\\.Buffered", false, null),
         new Property("Glacier2\\.Client\\.ForwardContext", false, null),
+        new Property("Glacier2\\.Client\\.MaxQueued", false, null),
+        new Property("Glacier2\\.Client\\.Password\\.MaxQueued", false, null),
+        new Property("Glacier2\\.Client\\.Password\\.RateLimit", false, null),
+        new Property("Glacier2\\.Client\\.Password\\.RateLimit\\.Burst", false, null),
+        new Property("Glacier2\\.Client\\.Password\\.Weight", false, null),
+        new Property("Glacier2\\.Client\\.RateLimit", false, null),
+        new Property("Glacier2\\.Client\\.RateLimit\\.Burst", false, null),
+        new Property("Glacier2\\.Client\\.SSL\\.MaxQueued", false, null),
+        new Property("Glacier2\\.Client\\.SSL\\.RateLimit", false, null),
+        new Property("Glacier2\\.Client\\.SSL\\.RateLimit\\.Burst", false, null),
+        new Property("Glacier2\\.Client\\.SSL\\.Weight", false, null),
         new Property("Glacier2\\.Client\\.SleepTime", false, null),
         new Property("Glacier2\\.Client\\.Trace\\.Override", false, null),
         new Property("Glacier2\\.Client\\.Trace\\.Reject", false, null),
         new Property("Glacier2\\.Client\\.Trace\\.Request", false, null),
+        new Property("Glacier2\\.Client\\.Weight", false, null),
         new Property("Glacier2\\.CryptPasswords", false, null),
         new Property("Glacier2\\.Filter\\.Address\\.Reject", false, null),
         new Property("Glacier2\\.Filter\\.Address\\.Accept", false, null),
@@ -1131,6 +1196,8 @@ public final class PropertyNames
         new Property("Glacier2\\.Server\\.Router\\.Context\\.[^\\s]+", false, null),
         new Property("Glacier2\\.Server\\.Router", false, null),
         new Property("Glacier2\\.Server\\.ProxyOptions", false, null),
+        new Property("Glacier2\\.Server\\.ThreadPool\\.Adaptive", false, null),
+        new Property("Glacier2\\.Server\\.ThreadPool\\.CallerRuns", false, null),
         new Property("Glacier2\\.Server\\.ThreadPool\\.Size", false, null),
         new Property("Glacier2\\.Server\\.ThreadPool\\.SizeMax", false, null),
         new Property("Glacier2\\.Server\\.ThreadPool\\.SizeWarn", false, null),
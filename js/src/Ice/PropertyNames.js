@@ -6,7 +6,7 @@
 // ICE_LICENSE file included in this distribution.
 //
 // **********************************************************************
-// Generated by makeprops.py from file ../config/PropertyNames.xml, Wed Oct  5 19:04:47 2016
+// Generated by makeprops.py from file ../config/PropertyNames.xml, Sun Oct 18 22:33:13 2026
 
 // IMPORTANT: Do not edit this file -- any edits made here will be lost!
 
@@ -60,6 +60,8 @@ PropertyNames.IceProps =
     new Property("/^Ice\.Admin\.Router\.Context\../", false, null),
     new Property("/^Ice\.Admin\.Router/", false, null),
     new Property("/^Ice\.Admin\.ProxyOptions/", false, null),
+    new Property("/^Ice\.Admin\.ThreadPool\.Adaptive/", false, null),
+    new Property("/^Ice\.Admin\.ThreadPool\.CallerRuns/", false, null),
     new Property("/^Ice\.Admin\.ThreadPool\.Size/", false, null),
     new Property("/^Ice\.Admin\.ThreadPool\.SizeMax/", false, null),
     new Property("/^Ice\.Admin\.ThreadPool\.SizeWarn/", false, null),
@@ -80,8 +82,13 @@ PropertyNames.IceProps =
     new Property("/^Ice\.BatchAutoFlush/", true, null),
     new Property("/^Ice\.BatchAutoFlushSize/", false, null),
     new Property("/^Ice\.ChangeUser/", false, null),
+    new Property("/^Ice\.CircuitBreaker\.Threshold/", false, null),
+    new Property("/^Ice\.CircuitBreaker\.Timeout/", false, null),
     new Property("/^Ice\.ClientAccessPolicyProtocol/", false, null),
+    new Property("/^Ice\.Compression\.Adaptive/", false, null),
+    new Property("/^Ice\.Compression\.Auto/", false, null),
     new Property("/^Ice\.Compression\.Level/", false, null),
+    new Property("/^Ice\.Compression\.MaxRatio/", false, null),
     new Property("/^Ice\.CollectObjects/", false, null),
     new Property("/^Ice\.Config/", false, null),
     new Property("/^Ice\.ConsoleListener/", false, null),
@@ -125,6 +132,8 @@ PropertyNames.IceProps =
     new Property("/^Ice\.InitPlugins/", false, null),
     new Property("/^Ice\.IPv4/", false, null),
     new Property("/^Ice\.IPv6/", false, null),
+    new Property("/^Ice\.LocatorCacheFile/", false, null),
+    new Property("/^Ice\.LocatorRegistrationWindow/", false, null),
     new Property("/^Ice\.LogFile/", false, null),
     new Property("/^Ice\.LogFile\.SizeMax/", false, null),
     new Property("/^Ice\.LogStdErr\.Convert/", false, null),
@@ -144,13 +153,18 @@ PropertyNames.IceProps =
     new Property("/^Ice\.PrintProcessId/", false, null),
     new Property("/^Ice\.PrintStackTraces/", false, null),
     new Property("/^Ice\.ProgramName/", false, null),
+    new Property("/^Ice\.RetryBudget/", false, null),
+    new Property("/^Ice\.RetryBudget\.Reserve/", false, null),
     new Property("/^Ice\.RetryIntervals/", false, null),
+    new Property("/^Ice\.RetryJitter/", false, null),
     new Property("/^Ice\.ServerIdleTime/", false, null),
     new Property("/^Ice\.SOCKSProxyHost/", false, null),
     new Property("/^Ice\.SOCKSProxyPort/", false, null),
     new Property("/^Ice\.StdErr/", false, null),
     new Property("/^Ice\.StdOut/", false, null),
     new Property("/^Ice\.SyslogFacility/", false, null),
+    new Property("/^Ice\.ThreadPool\.Client\.Adaptive/", false, null),
+    new Property("/^Ice\.ThreadPool\.Client\.CallerRuns/", false, null),
     new Property("/^Ice\.ThreadPool\.Client\.Size/", false, null),
     new Property("/^Ice\.ThreadPool\.Client\.SizeMax/", false, null),
     new Property("/^Ice\.ThreadPool\.Client\.SizeWarn/", false, null),
@@ -158,6 +172,8 @@ PropertyNames.IceProps =
     new Property("/^Ice\.ThreadPool\.Client\.Serialize/", false, null),
     new Property("/^Ice\.ThreadPool\.Client\.ThreadIdleTime/", false, null),
     new Property("/^Ice\.ThreadPool\.Client\.ThreadPriority/", false, null),
+    new Property("/^Ice\.ThreadPool\.Server\.Adaptive/", false, null),
+    new Property("/^Ice\.ThreadPool\.Server\.CallerRuns/", false, null),
     new Property("/^Ice\.ThreadPool\.Server\.Size/", false, null),
     new Property("/^Ice\.ThreadPool\.Server\.SizeMax/", false, null),
     new Property("/^Ice\.ThreadPool\.Server\.SizeWarn/", false, null),
@@ -74,13 +74,15 @@ def getDefaultLocatorProperty():
 
    return ' %s%s"' % (property, objrefs)
 
-def startIceGridRegistry(testdir, dynamicRegistration = False):
+def startIceGridRegistry(testdir, dynamicRegistration = False, additionalRegistryOptions = ""):
 
     iceGrid = TestUtil.getIceGridRegistry()
 
     command = ' --nowarn ' + registryOptions
     if dynamicRegistration:
         command += r' --IceGrid.Registry.DynamicRegistration'
+    if additionalRegistryOptions:
+        command += ' ' + additionalRegistryOptions
 
     procs = []
     i = 0
@@ -219,7 +221,7 @@ def killNodeServers():
         iceGridAdmin("server disable " + server, True)
         iceGridAdmin("server signal " + server + " SIGKILL", True)
 
-def iceGridTest(application, additionalOptions = "", applicationOptions = ""):
+def iceGridTest(application, additionalOptions = "", applicationOptions = "", additionalRegistryOptions = ""):
 
     testdir = os.getcwd()
     if not TestUtil.isWin32() and os.getuid() == 0:
@@ -239,7 +241,7 @@ def iceGridTest(application, additionalOptions = "", applicationOptions = ""):
         targets = [client, TestUtil.getIceGridNode(), TestUtil.getIceGridRegistry()]
         TestUtil.setAppVerifierSettings(targets)
 
-    registryProcs = startIceGridRegistry(testdir)
+    registryProcs = startIceGridRegistry(testdir, False, additionalRegistryOptions)
     iceGridNodeProc = startIceGridNode(testdir)
 
     javaHome = os.environ.get("JAVA_HOME", None)